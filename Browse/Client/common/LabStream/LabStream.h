@@ -79,6 +79,12 @@ public:
 		_upStreamOutlet->push_sample(data);
 	}
 
+	// Send event without copying, count of values must match channel count of stream
+	void Send(const Type* pData)
+	{
+		_upStreamOutlet->push_sample(pData);
+	}
+
 private:
 
 	// Private copy / assignment constructors
@@ -45,18 +45,9 @@ function SendAttributeChangesToCEF(attrStr, domObj)
     if(attrCode === undefined)
         return "Invalid attrCode: "+attrCode;
 
-    var encodedData = FetchAndEncodeAttribute(domObj, attrStr);
-    if (encodedData === undefined)
-    {
-        console.log("Error in SendAttributeChangesToCEF: Failed to encode attribute "+attrStr+"!");
-        return "Invalid encoded data: "+encodedData;
-    }
-    
-    var msg = "DOM#upd#"+domObj.getType()+"#"+domObj.getId()+"#"+attrCode+"#"+encodedData+"#";
-
-    ConsolePrint(msg);
-    // console.log("AttrChanges: "+msg);
-    return "Success, sent: "+msg;
+    // Data is fetched and encoded when delta is sent
+    SendDOMDeltaToCEF(DOM_DELTA_UPDATE, domObj, attrStr, attrCode);
+    return "Success, sent update of "+attrStr;
 }
 
 
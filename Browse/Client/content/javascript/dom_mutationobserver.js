@@ -30,6 +30,8 @@ document.onreadystatechange = function()
 	// TODO: First change of OccBitmask isn't recognized by CEF!
 	if(document.readyState === "loading" || document.readyState === "complete")
 	{
+		// Compute all bitmasks in one batched pass
+		UpdateOccBitmasks();
 		window.domNodes.forEach((list) => {
 			// Force send message about attribute changes
 			list.forEach((o) => { SendAttributeChangesToCEF("OccBitmask", o); });
@@ -53,10 +53,13 @@ function DOMNode(node, id, type, cef_hidden=false)
 
     this.cppReady = false; // TODO: Queueing calls, when node isn't ready yet?
 
+    // Let geometry sync check node when its size or visibility changes
+    GeometrySyncObserve(this);
+
     if(!this.cef_hidden)
     {
         // Inform C++ about added DOMNode
-        ConsolePrint("DOM#add#"+type+"#"+id+"#");
+        SendDOMDeltaToCEF(DOM_DELTA_ADD, this);
     }
 }
 DOMNode.prototype.Class = "DOMNode";
@@ -73,10 +76,7 @@ DOMNode.prototype.setCefHidden = function(hidden){
         return;
 
     this.cef_hidden = hidden;
-    if(hidden)
-        ConsolePrint("DOM#rem#"+this.getType()+"#"+this.getId()+"#");
-    else
-        ConsolePrint("DOM#add#"+this.getType()+"#"+this.getId()+"#");
+    SendDOMDeltaToCEF(hidden ? DOM_DELTA_REMOVE : DOM_DELTA_ADD, this);
 }
 DOMNode.prototype.getCefHidden = function(){
     return this.cef_hidden;
@@ -169,92 +169,32 @@ DOMNode.prototype.updateOccBitmask = function(altNode, debug){
             console.log("Used coordinates:", r);
         // rect corners
         var pts = [[r[1],r[0]], [r[3],r[0]], [r[3],r[2]], [r[1],r[2]]]; // Note: Seems infinitely small amount to high
+
+        // Layers which might paint over this node, sorted by z-index. Shared by all nodes of the current frame
+        var occlusion = GetOcclusionLayers();
+        var own_z = occlusion.zIndices.get(this.node) || 0;
         pts.forEach( (pt) => { // pt[0] == x, pt[1] == y
-            // Rect point in currently shown part of website?
-            // if(pt[0] < window.scrollX || pt[0] > window.scrollX + window.innerWidth ||
-                // pt[1] < window.scrollY || pt[1] > window.scrollY + window.innerHeight)
-                    // bm.push(0);
-            // else
-            // NOTE: OccBitmask is updated less frequently than scrolling may happen!
-            if(true)
-            {
-                // Fix for facebook chat being occluded by child divs
-                if(this.node.tagName == "DIV")
-                {
-                    var layers = document.elementsFromPoint(pt[0], pt[1]);
-                    var layer_id = layers.indexOf(this.node); // TODO: Use altNode instead?
-                    
-                    if(debug)
-                    {
-                        console.log("layer_id:",layer_id);
-                        console.log("layers:", layers);
-                        console.log("pt:", pt);
-                    }
-                    if(layer_id === -1)
-                    {
-                        // Not in layers at all. Shouldn't happen!
-                        bm.push(1);
-                        return;
-                    }
-                    // Is in top layer!
-                    else if(layer_id === 0)
-                    {
-                        bm.push(0);
-                        return;
-                    }
-                    else
-                    {
-                        var parent_for_top_layers = true;
-                        for(var i = layer_id - 1; i >= 0 && parent_for_top_layers; i--)
-                        {
-                            try
-                            {
-                                // Surrounded by anonymous lambda function, because otherwise JS interrupts with maximum
-                                // call stack size reached. When redefining "IsAncestor" in console, it works - just like this.
-                                var generations = (() => { IsAncestor(layers[i], this.node) })();
-                            }
-                            catch(e)
-                            {
-                                var generations = 0;
-                                console.log("IsAncestor failed!");
-                            }
-                            
-                            if(debug)
-                            {
-                                console.log(i, generations, layers[i]);
-                            }
-                            if(generations <= 0) 
-                                parent_for_top_layers = false;
-                        }
-                        
-                        bm.push((!parent_for_top_layers & 1));
-                        return;
-                    }
-                }
+            occlusion_points++;
 
-                var topNode = document.elementFromPoint(pt[0], pt[1]);
-                if(debug)
-                {
-                    console.log(this.getType(), this.getId(), ": (", pt[0], ",", pt[1], ") => ", topNode);
-                    console.log(document.elementsFromPoint(pt[0], pt[1]));//.slice(0,3));
-                }
+            // Rect point outside of currently shown part of website
+            if(pt[0] < 0 || pt[1] < 0 || pt[0] > window.innerWidth || pt[1] > window.innerHeight)
+            {
+                bm.push(0);
+                return;
+            }
 
-                if (!topNode)
-                {
-                    bm.push(0);
-                }
-                else if(//this.node.tagName === "A" && 
-                            (topNode.parentElement === this.node || 
-                                // Quick fix for facebook chat, check if this can be generalized in some way
-                                (topNode.parentElement && topNode.parentElement.parentElement === this.node) 
-                            )
-                        )
-                        {
-                            bm.push(0);
-                        }
-                else
-                    bm.push(Number(topNode !== (altNode || this.node)));
+            // Only hit-test if point lies in layer of other subtree, which might be on top of node
+            var covered = false;
+            for(var i = 0, n = occlusion.layers.length; i < n && !covered; i++)
+            {
+                var layer = occlusion.layers[i];
+                if(layer.z < own_z)
+                    break; // remaining layers are below node
+                covered = layer.rects.some((lr) => {
+                    return pt[0] >= lr[1] && pt[0] <= lr[3] && pt[1] >= lr[0] && pt[1] <= lr[2];
+                }) && !layer.node.contains(this.node) && !this.node.contains(layer.node);
             }
+            bm.push(covered ? this.hitTestOcclusion(pt, altNode, debug) : 0);
         });
 
     }
@@ -274,10 +214,88 @@ DOMNode.prototype.updateOccBitmask = function(altNode, debug){
         SendAttributeChangesToCEF("OccBitmask", this);
     }
     // DEBUG
-    else
+    // else
         // console.log(this.getId()+": OccBitmask didn't change ... "+this.bitmask+" === "+bm+" | cppReady? "+this.cppReady);
 
     UpdateBitmaskTimer(t1);
+    return changed;
+}
+
+/**
+ * Determine by hit-test whether point of node is occluded, returns 0 or 1.
+ * Expensive as it might force layout, so only used if a layer covers the point.
+ */
+DOMNode.prototype.hitTestOcclusion = function(pt, altNode, debug){
+    occlusion_hit_tests++;
+
+    // Fix for facebook chat being occluded by child divs
+    if(this.node.tagName == "DIV")
+    {
+        var layers = document.elementsFromPoint(pt[0], pt[1]);
+        var layer_id = layers.indexOf(this.node); // TODO: Use altNode instead?
+        
+        if(debug)
+        {
+            console.log("layer_id:",layer_id);
+            console.log("layers:", layers);
+            console.log("pt:", pt);
+        }
+        if(layer_id === -1)
+        {
+            // Not in layers at all. Shouldn't happen!
+            return 1;
+        }
+        // Is in top layer!
+        else if(layer_id === 0)
+        {
+            return 0;
+        }
+        else
+        {
+            var parent_for_top_layers = true;
+            for(var i = layer_id - 1; i >= 0 && parent_for_top_layers; i--)
+            {
+                try
+                {
+                    // Surrounded by anonymous lambda function, because otherwise JS interrupts with maximum
+                    // call stack size reached. When redefining "IsAncestor" in console, it works - just like this.
+                    var generations = (() => { IsAncestor(layers[i], this.node) })();
+                }
+                catch(e)
+                {
+                    var generations = 0;
+                    console.log("IsAncestor failed!");
+                }
+                
+                if(debug)
+                {
+                    console.log(i, generations, layers[i]);
+                }
+                if(generations <= 0) 
+                    parent_for_top_layers = false;
+            }
+            
+            return (!parent_for_top_layers & 1);
+        }
+    }
+
+    var topNode = document.elementFromPoint(pt[0], pt[1]);
+    if(debug)
+    {
+        console.log(this.getType(), this.getId(), ": (", pt[0], ",", pt[1], ") => ", topNode);
+        console.log(document.elementsFromPoint(pt[0], pt[1]));//.slice(0,3));
+    }
+
+    if (!topNode)
+        return 0;
+    if(//this.node.tagName === "A" && 
+        (topNode.parentElement === this.node || 
+            // Quick fix for facebook chat, check if this can be generalized in some way
+            (topNode.parentElement && topNode.parentElement.parentElement === this.node) 
+        )
+    )
+        return 0;
+    return Number(topNode !== (altNode || this.node));
 }
 
 DOMNode.prototype.getOccBitmask = function(){
@@ -36,10 +36,10 @@ DOMNode.prototype.getAdjustedClientRects = function(altNode){
  * Sets rects to zero, checks if changes happened, and if so, informs CEF.
  */
 DOMNode.prototype.setRectsToZero = function(){
-    var prev_rects = this.rects;
-    this.rects = [[0,0,0,0]]
-    if(!EqualClientRectsData(this.rects, prev_rects))
+    var zero_rects = [[0,0,0,0]];
+    if(!EqualClientRectsData(zero_rects, this.rects))
     {
+        this.rects = zero_rects; // only replaced if changed, geometry sync relies on that
         SendAttributeChangesToCEF("Rects", this);
         return true;
     }
@@ -47,4 +47,151 @@ DOMNode.prototype.setRectsToZero = function(){
 }
 
 
+/**
+ * Occlusion layers: Elements which may paint over content of other subtrees, i.e. fixed elements and elements
+ * forming their own stacking context. Collected in one sweep over the ancestors of all tracked nodes and sorted
+ * by z-index, so occlusion of most points can be decided without a hit-test. Structure is rebuilt when nodes were
+ * added or after a while, rects of layers are refreshed once per animation frame.
+ */
+window.occlusionLayers = undefined;
+var OCCLUSION_LAYERS_MAX_AGE = 1000; // milliseconds
+
+function GetOcclusionLayers()
+{
+    var node_count = 0;
+    window.domNodes.forEach((list) => { node_count += list.length; });
+
+    var occlusion = window.occlusionLayers;
+    var now = performance.now();
+    if(occlusion === undefined || occlusion.nodeCount !== node_count || occlusion.fixedCount !== window.domFixedElements.length
+        || now - occlusion.creationTime > OCCLUSION_LAYERS_MAX_AGE)
+    {
+        occlusion = BuildOcclusionLayers(node_count, now);
+    }
+    else if(!occlusion.rectsValid)
+    {
+        occlusion.layers.forEach((layer) => { UpdateOcclusionLayerRects(layer); });
+        occlusion.rectsValid = true;
+    }
+
+    // Rects of layers are valid until next frame, as scrolling or layout might move them
+    if(!occlusion.invalidationRequested)
+    {
+        occlusion.invalidationRequested = true;
+        window.requestAnimationFrame(() => {
+            occlusion.rectsValid = false;
+            occlusion.invalidationRequested = false;
+        });
+    }
+    return occlusion;
+}
+
+function BuildOcclusionLayers(node_count, now)
+{
+    var occlusion = {
+        layers: [],
+        zIndices: new Map(), // tracked node -> highest z-index of layers containing it
+        nodeCount: node_count,
+        fixedCount: window.domFixedElements.length,
+        creationTime: now,
+        rectsValid: true,
+        invalidationRequested: false
+    };
+    var layer_z = new Map(); // visited element -> z-index if layer, else null
+
+    // Walk up ancestors of tracked nodes, each element is visited once
+    var visit = (node) => {
+        var z = 0;
+        for(var e = node; e && e !== document.documentElement; e = e.parentElement)
+        {
+            var known = layer_z.get(e);
+            if(known === undefined)
+            {
+                known = GetOcclusionLayerZ(e);
+                layer_z.set(e, known);
+                if(known !== null)
+                {
+                    var layer = { node: e, z: known, rects: [] };
+                    UpdateOcclusionLayerRects(layer);
+                    occlusion.layers.push(layer);
+                }
+            }
+            if(known !== null)
+                z = Math.max(z, known);
+        }
+        return z;
+    };
+    window.domNodes.forEach((list) => {
+        list.forEach((o) => { occlusion.zIndices.set(o.node, visit(o.node)); });
+    });
+
+    // Fixed elements are layers, too, even if not yet visited
+    window.domFixedElements.forEach((fixObj) => {
+        if(!layer_z.has(fixObj.node))
+        {
+            var layer = { node: fixObj.node, z: GetOcclusionLayerZ(fixObj.node) || 0, rects: [] };
+            UpdateOcclusionLayerRects(layer);
+            occlusion.layers.push(layer);
+        }
+    });
+
+    // Highest layers first, so testing nodes can stop at layers below themselves
+    occlusion.layers.sort((a, b) => { return b.z - a.z; });
+
+    window.occlusionLayers = occlusion;
+    return occlusion;
+}
+
+// Returns z-index of element if it forms an occlusion layer, else null
+function GetOcclusionLayerZ(element)
+{
+    if(element.nodeType !== 1)
+        return null;
+    var cs = window.getComputedStyle(element, null);
+    var position = cs.getPropertyValue("position");
+    var z = parseInt(cs.getPropertyValue("z-index"));
+    if(isNaN(z))
+        z = 0;
+    if(position === "fixed" || position === "sticky" || position === "absolute")
+        return z;
+    if(position === "relative" && cs.getPropertyValue("z-index") !== "auto")
+        return z;
+    if(cs.getPropertyValue("transform") !== "none")
+        return z;
+    return null;
+}
+
+// Fixed elements provide bounding rects of their subtree, others use own client rect in viewport coordinates
+function UpdateOcclusionLayerRects(layer)
+{
+    var fixObj = GetFixedElementByNode(layer.node);
+    if(fixObj !== undefined && fixObj.rects.length > 0)
+    {
+        layer.rects = fixObj.rects;
+        return;
+    }
+    var r = layer.node.getBoundingClientRect();
+    layer.rects = (r.width > 0 && r.height > 0) ? [[r.top, r.left, r.bottom, r.right]] : [];
+}
+
+/**
+ * Batched occlusion pass: Compute occlusion bitmasks of given DOM nodes (default: all tracked nodes) in one sweep,
+ * sharing the occlusion layers. Changed bitmasks are sent to CEF.
+ */
+function UpdateOccBitmasks(domObjs)
+{
+    var t0 = performance.now();
+    GetOcclusionLayers();
+    UpdateBitmaskTimer(t0);
+
+    var update = (o) => {
+        if(!o.cef_hidden)
+            o.updateOccBitmask(o.imgNode); // use image node of links, like in rect updates
+    };
+    if(domObjs !== undefined)
+        domObjs.forEach(update);
+    else
+        window.domNodes.forEach((list) => { list.forEach(update); });
+}
+
 ConsolePrint("Successfully imported dom_nodes_helpers.js!");
\ No newline at end of file
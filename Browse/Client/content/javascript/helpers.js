@@ -30,6 +30,285 @@ function SendToMsgRouter(msg)
 
 ConsolePrint("Starting to import helpers.js ...");
 
+// Operations of DOM deltas, must match DOMDeltaOperation in DOMDelta.h
+var DOM_DELTA_ADD = 0;
+var DOM_DELTA_REMOVE = 1;
+var DOM_DELTA_UPDATE = 2;
+
+// DOM node changes of current animation frame, sent at once via native function 'SendDOMDeltas'
+window.domDeltaQueue = [];
+window.domDeltaUpdateKeys = new Set(); // pending updates, key is 'type#id#attrCode'
+window.domDeltaFlushRequested = false;
+
+// Delay of timer used instead of animation frames, which are not fired while document is hidden
+var HIDDEN_FRAME_DELAY = 100; // milliseconds
+
+/**
+ * Call function with next animation frame or, if document is hidden (e.g. background tab), after a short delay.
+ */
+function RequestFrameCallback(callback)
+{
+    if(document.hidden)
+        window.setTimeout(callback, HIDDEN_FRAME_DELAY);
+    else
+        window.requestAnimationFrame(callback);
+}
+
+// Animation frame requested before document got hidden would not fire until it is shown again
+document.addEventListener("visibilitychange", () => {
+    if(!document.hidden)
+        return;
+    if(window.domDeltaFlushRequested)
+        FlushDOMDeltas();
+    if(window.geometrySync !== undefined && window.geometrySync.frameRequested)
+        GeometrySyncFrame();
+});
+
+/**
+ * Send change of DOM node to CEF. Batched per animation frame if native function is provided,
+ * otherwise sent directly like DOM#{add | rem | upd}#nodeType#nodeID{#attribute#data}#
+ * Data of updates is fetched when sending, so multiple updates of the same attribute collapse into one.
+ */
+function SendDOMDeltaToCEF(op, domObj, attrStr, attrCode)
+{
+    if(typeof(window.SendDOMDeltas) !== "function")
+    {
+        switch(op)
+        {
+            case DOM_DELTA_ADD: ConsolePrint("DOM#add#"+domObj.getType()+"#"+domObj.getId()+"#"); break;
+            case DOM_DELTA_REMOVE: ConsolePrint("DOM#rem#"+domObj.getType()+"#"+domObj.getId()+"#"); break;
+            case DOM_DELTA_UPDATE: 
+                var encodedData = FetchAndEncodeAttribute(domObj, attrStr);
+                if(encodedData !== undefined)
+                    ConsolePrint("DOM#upd#"+domObj.getType()+"#"+domObj.getId()+"#"+attrCode+"#"+encodedData+"#");
+                break;
+        }
+        return;
+    }
+
+    if(domObj.deltaGeneration === undefined)
+        domObj.deltaGeneration = 0;
+
+    if(op === DOM_DELTA_UPDATE)
+    {
+        var key = domObj.getType()+"#"+domObj.getId()+"#"+domObj.deltaGeneration+"#"+attrCode;
+        if(window.domDeltaUpdateKeys.has(key))
+            return; // already pending, data is fetched when sending
+        window.domDeltaUpdateKeys.add(key);
+    }
+    else if(op === DOM_DELTA_REMOVE)
+    {
+        // Pending updates would be sent before removal, with data fetched after it. Drop them and
+        // start new generation, so updates after a re-add are not collapsed into the dropped ones.
+        var prefix = domObj.getType()+"#"+domObj.getId()+"#"+domObj.deltaGeneration+"#";
+        window.domDeltaQueue = window.domDeltaQueue.filter((d) => !(d.domObj === domObj && d.op === DOM_DELTA_UPDATE));
+        window.domDeltaUpdateKeys.forEach((key) => {
+            if(key.startsWith(prefix))
+                window.domDeltaUpdateKeys.delete(key);
+        });
+        domObj.deltaGeneration++;
+    }
+    window.domDeltaQueue.push({op: op, domObj: domObj, attrStr: attrStr, attrCode: attrCode});
+
+    if(!window.domDeltaFlushRequested)
+    {
+        window.domDeltaFlushRequested = true;
+        RequestFrameCallback(FlushDOMDeltas);
+    }
+}
+
+function FlushDOMDeltas()
+{
+    var queue = window.domDeltaQueue;
+    window.domDeltaQueue = [];
+    window.domDeltaUpdateKeys.clear();
+    window.domDeltaFlushRequested = false;
+
+    // Flat list with five fields per delta, see DOMDelta.h
+    var deltas = [];
+    queue.forEach((d) => {
+        var data = "";
+        if(d.op === DOM_DELTA_UPDATE)
+        {
+            data = FetchAndEncodeAttribute(d.domObj, d.attrStr);
+            if(data === undefined)
+                return;
+        }
+        deltas.push(d.op, d.domObj.getType(), d.domObj.getId(), (d.attrCode === undefined) ? -1 : d.attrCode, ""+data);
+    });
+
+    if(deltas.length > 0)
+        window.SendDOMDeltas(deltas);
+}
+
+/**
+ * Geometry sync: Instead of sweeping every DOM node, only nodes which might have changed their geometry are
+ * marked dirty and checked. Rects and OccBitmask are only sent to CEF if they actually changed.
+ * Dirty are nodes reported by ResizeObserver, nodes entering or leaving the viewport (IntersectionObserver)
+ * and, per scroll epoch, fixed nodes and nodes inside the viewport (their occlusion depends on scrolling).
+ * Dirty nodes are checked once per animation frame (or timer while hidden) until the time budget of the frame is used up.
+ */
+window.geometrySync = {
+    dirty: new Set(),
+    objects: new WeakMap(), // node -> DOMNode object
+    visible: new Set(), // DOMNode objects intersecting the viewport
+    epoch: 0, // incremented with every frame after scroll offset changes reported by CEF
+    scrolled: false, // scroll offset changed since last frame, so fixed and visible nodes are marked dirty there
+    budget: 4, // milliseconds per animation frame, adapted to amount of dirty nodes
+    minBudget: 2,
+    maxBudget: 8,
+    frameRequested: false,
+    checked: 0, // counters since page load
+    sent: 0,
+    verbose: false
+};
+
+if(typeof(ResizeObserver) === "function")
+{
+    window.geometrySync.resizeObserver = new ResizeObserver((entries) => {
+        entries.forEach((entry) => { GeometrySyncMarkNode(entry.target); });
+        GeometrySyncRequestFrame();
+    });
+}
+
+if(typeof(IntersectionObserver) === "function")
+{
+    window.geometrySync.intersectionObserver = new IntersectionObserver((entries) => {
+        entries.forEach((entry) => {
+            var domObj = window.geometrySync.objects.get(entry.target);
+            if(domObj === undefined)
+                return;
+            if(entry.isIntersecting)
+                window.geometrySync.visible.add(domObj);
+            else
+                window.geometrySync.visible.delete(domObj);
+            window.geometrySync.dirty.add(domObj);
+        });
+        GeometrySyncRequestFrame();
+    });
+}
+
+// Called by DOMNode constructor
+function GeometrySyncObserve(domObj)
+{
+    var sync = window.geometrySync;
+    sync.objects.set(domObj.node, domObj);
+    if(sync.resizeObserver !== undefined)
+        sync.resizeObserver.observe(domObj.node);
+    if(sync.intersectionObserver !== undefined)
+        sync.intersectionObserver.observe(domObj.node);
+    else
+        sync.visible.add(domObj); // without observer, treat every node as visible
+}
+
+// Called when DOMNode object is removed
+function GeometrySyncUnobserve(domObj)
+{
+    var sync = window.geometrySync;
+    sync.objects.delete(domObj.node);
+    sync.visible.delete(domObj);
+    sync.dirty.delete(domObj);
+    if(sync.resizeObserver !== undefined)
+        sync.resizeObserver.unobserve(domObj.node);
+    if(sync.intersectionObserver !== undefined)
+        sync.intersectionObserver.unobserve(domObj.node);
+}
+
+function GeometrySyncMarkNode(node)
+{
+    var domObj = window.geometrySync.objects.get(node);
+    if(domObj !== undefined)
+        window.geometrySync.dirty.add(domObj);
+}
+
+function GeometrySyncRequestFrame()
+{
+    var sync = window.geometrySync;
+    if(!sync.frameRequested && (sync.dirty.size > 0 || sync.scrolled))
+    {
+        sync.frameRequested = true;
+        RequestFrameCallback(GeometrySyncFrame);
+    }
+}
+
+function GeometrySyncFrame()
+{
+    var sync = window.geometrySync;
+    sync.frameRequested = false;
+
+    // Start new scroll epoch once per frame, no matter how many scroll offset changes were reported
+    if(sync.scrolled)
+    {
+        sync.scrolled = false;
+        sync.epoch++;
+        sync.visible.forEach((o) => { sync.dirty.add(o); });
+        window.domNodes.forEach((list) => {
+            list.forEach((o) => {
+                if(o.fixObj !== undefined)
+                    sync.dirty.add(o);
+            });
+        });
+    }
+
+    var t_start = performance.now();
+    var checked = 0;
+    var sent = 0;
+    for(var domObj of sync.dirty)
+    {
+        sync.dirty.delete(domObj);
+        if(domObj.cef_hidden)
+            continue;
+
+        // Rects and bitmask are replaced by update functions only if changed
+        var rects = domObj.rects;
+        var bitmask = domObj.bitmask;
+        domObj.updateRects();
+        checked++;
+        if(domObj.rects !== rects || domObj.bitmask !== bitmask)
+            sent++;
+
+        if(performance.now() - t_start >= sync.budget)
+            break;
+    }
+    sync.checked += checked;
+    sync.sent += sent;
+
+    // Adapt budget: spend more time per frame while backlog remains, shrink back when drained
+    if(sync.dirty.size > 0)
+        sync.budget = Math.min(sync.maxBudget, sync.budget * 1.5);
+    else
+        sync.budget = Math.max(sync.minBudget, sync.budget * 0.75);
+
+    if(sync.verbose)
+        console.log("GeometrySync: epoch", sync.epoch, "checked", checked, "sent", sent, "remaining", sync.dirty.size,
+            "| total checked", sync.checked, "sent", sync.sent);
+
+    GeometrySyncRequestFrame();
+}
+
+/**
+ * Triggered by ExecuteJavascript call in Mediator, whenever CEF reports a change of the scroll offset.
+ * Only flags the change, next frame starts new scroll epoch, in which each fixed or visible node is checked once.
+ */
+function CefSyncGeometry(budget)
+{
+    var sync = window.geometrySync;
+    sync.scrolled = true;
+    if(budget !== undefined)
+    {
+        sync.maxBudget = budget;
+        sync.minBudget = Math.min(sync.minBudget, budget);
+        sync.budget = Math.min(sync.budget, budget);
+    }
+    GeometrySyncRequestFrame();
+}
+
+// Returns counters of geometry sync as [checked, sent]
+function GetGeometrySyncCounters()
+{
+    return [window.geometrySync.checked, window.geometrySync.sent];
+}
+
 
 // TODO: Move CEF callable functions to separate js-file
 function CefPoll(num_partitions, update_partition)
@@ -60,7 +339,7 @@ function CefPoll(num_partitions, update_partition)
     // ForEveryChild(document.documentElement, AnalyzeNode);
     
     // Partitions shouldn't matter for an expected small amount of video nodes
-    domVideos.forEach((n) => { SendAttributeChangesToCEF("Rects", n); });
+    domVideos.forEach((n) => { window.geometrySync.dirty.add(n); });
 
     window.domNodes.forEach((list) => {
         if(partitioned)
@@ -73,18 +352,15 @@ function CefPoll(num_partitions, update_partition)
         // If partition_size == 0, because list length is too short, don't partition and update all
         var this_partitioned = (partitioned && partition_size > 0);
 
-        // Force send message about attribute changes
+        // Mark nodes of partition as dirty, geometry sync only sends actual changes
         list.forEach((o, idx) => { 
             if(!this_partitioned || (idx >= first && idx <= last) )
             {
-                if(typeof(o.updateRects()) === "function")
-                    o.updateRects();
-
-                SendAttributeChangesToCEF("OccBitmask", o);
-                SendAttributeChangesToCEF("Rects", o); // For language list on wikipedia.org main page, for example
+                window.geometrySync.dirty.add(o); // For language list on wikipedia.org main page, for example
             } 
         });
     });
+    GeometrySyncRequestFrame();
 
 
     // DISABLED FOR DEBUGGING
@@ -386,6 +662,7 @@ function RemoveDOMObject(type, id)
         // Delete object on C++ side
        SetObjectAvailabilityForCEFto(domObj, false);
        // and on JS side
+       GeometrySyncUnobserve(domObj);
        delete domObj;
     }
 }
@@ -554,6 +831,8 @@ function ComputeBoundingRect(parent, child)
 
 var time_spent_rects_updating = 0.0;
 var time_spent_creating_bitmask = 0.0;
+var occlusion_points = 0; // points tested for occlusion
+var occlusion_hit_tests = 0; // points which needed hit-test via elementFromPoint
 function UpdateRectUpdateTimer(t0)
 {
     time_spent_rects_updating += (performance.now() - t0);
@@ -574,6 +853,8 @@ function PrintPerformanceInformation()
     ConsolePrint('### Bitmask creation: \t'+Math.round(time_spent_creating_bitmask / 1000)+'s / '+
         Math.round(time_spent_creating_bitmask * 1000) / 1000 +'ms -- '+
             100*Math.round(time_spent_creating_bitmask/window.page_load_time_*1000)/1000 +'% of page load time');
+    ConsolePrint('### Occlusion hit-tests: \t'+occlusion_hit_tests+' of '+occlusion_points+' points -- '+
+        ((occlusion_points > 0) ? 100*Math.round(occlusion_hit_tests/occlusion_points*1000)/1000 : 0)+'% of tested points');
 }
 
 function SendFaviconURLtoCEF(url)
@@ -616,10 +897,7 @@ function SetObjectAvailabilityForCEFto(domObj, val)
         console.log("Invalid call of SetObjectAvailabilityForCEFto! Aborting.");
         return;
     }
-    if(val)
-        ConsolePrint("DOM#add#"+domObj.getType()+"#"+domObj.getId()+"#");
-    else
-        ConsolePrint("DOM#rem#"+domObj.getType()+"#"+domObj.getId()+"#");
+    SendDOMDeltaToCEF(val ? DOM_DELTA_ADD : DOM_DELTA_REMOVE, domObj);
 }
 
 function CheckOverflowProperties(node)
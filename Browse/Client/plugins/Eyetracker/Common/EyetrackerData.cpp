@@ -4,13 +4,13 @@
 //============================================================================
 
 #include "EyetrackerData.h"
-#include <mutex>
+#include "plugins/Eyetracker/Common/SampleRing.h"
+#include <atomic>
 
 namespace eyetracker_global
 {
     // Variables
-	auto spSampleDataQueue = SampleQueue(new std::deque<SampleData>);
-	std::mutex mutex;
+	SampleRing<SampleData> sampleRing(EYETRACKER_SAMPLE_BUFFER_CAPACITY);
 	
 	// Wrapper for lab stream output
 	struct LabStreamOutputWrapper
@@ -19,68 +19,70 @@ namespace eyetracker_global
 		LabStreamOutputWrapper(lsl::stream_info streamInfo, bool stream) : output(streamInfo), stream(stream) {}
 		void Continue() { stream = true; }
 		void Pause() { stream = false; }
-		void Update(const std::vector<double>& rData) {
-			if (stream) { output.Send(rData); } // send data if streaming ok
+		void Update(const double* pData) {
+			if (stream) { output.Send(pData); } // send data if streaming ok
 		}
 
 	private:
-		bool stream;
+		std::atomic<bool> stream;
 		LabStreamOutput<double> output;
 	};
-	std::shared_ptr<LabStreamOutputWrapper> spLabStreamOutput = nullptr;
+	std::shared_ptr<LabStreamOutputWrapper> spLabStreamOutput = nullptr; // only accessed via atomic load and store
 
 	void SetupLabStream(lsl::stream_info streamInfo)
 	{
-		mutex.lock(); // lock
-		spLabStreamOutput = 
+		std::atomic_store(&spLabStreamOutput,
 			std::shared_ptr<LabStreamOutputWrapper >(new LabStreamOutputWrapper(
 				streamInfo, // stream info given by eye tracker implementation
-				true)); // start directly with streaming (TODO: right now in EyeInput it is manually paused if during initialization data transfer was paused. Better ask here what is the state in master than relying on EyeInput class)
-		mutex.unlock(); // unlock
+				true))); // start directly with streaming (TODO: right now in EyeInput it is manually paused if during initialization data transfer was paused. Better ask here what is the state in master than relying on EyeInput class)
 	}
 
 	void TerminateLabStream()
 	{
-		mutex.lock(); // lock
-		spLabStreamOutput = nullptr;
-		mutex.unlock(); // unlock
+		std::atomic_store(&spLabStreamOutput, std::shared_ptr<LabStreamOutputWrapper>(nullptr));
 	}
 
 	void ContinueLabStream()
 	{
-		mutex.lock(); // lock
-		if (spLabStreamOutput) { spLabStreamOutput->Continue(); }
-		mutex.unlock(); // unlock
+		auto spOutput = std::atomic_load(&spLabStreamOutput);
+		if (spOutput) { spOutput->Continue(); }
 	}
 
 	void PauseLabStream()
 	{
-		mutex.lock(); // lock
-		if (spLabStreamOutput) { spLabStreamOutput->Pause(); }
-		mutex.unlock(); // unlock
+		auto spOutput = std::atomic_load(&spLabStreamOutput);
+		if (spOutput) { spOutput->Pause(); }
 	}
 
     void PushBackSample(SampleData sample) // called by eye tracker thread
     {
-		mutex.lock(); // lock
-
 		// Send to lab streaming layer
-		if (spLabStreamOutput) { spLabStreamOutput->Update({ sample.x, sample.y }); } // handles pause etc. internally
-
-		// Push sample to queue
-		if (sample.valid) // only push valid samples to the queue
+		auto spOutput = std::atomic_load(&spLabStreamOutput);
+		if (spOutput) // handles pause etc. internally
 		{
-			spSampleDataQueue->push_back(sample); // pushes sample
+			const double data[] = { sample.x, sample.y };
+			spOutput->Update(data);
 		}
 
-		mutex.unlock(); // unlock
+		// Push sample to ring
+		if (sample.valid) // only push valid samples to the ring
+		{
+			sampleRing.Push(sample); // drops sample if main thread does not keep up
+		}
     }
 
-	void FetchSamples(SampleQueue& rspSamples) // called by main thread
+	int FetchSamples(SampleData* pSamples, int maxCount) // called by main thread
     {
-		mutex.lock(); // lock
-		rspSamples = spSampleDataQueue; // move data to output
-		spSampleDataQueue = SampleQueue(new std::deque<SampleData>); // intialize empty queue for new data
-		mutex.unlock(); // unlock
+		return sampleRing.Drain(pSamples, maxCount);
     }
+
+	unsigned int GetDroppedSampleCount()
+	{
+		return sampleRing.GetDroppedCount();
+	}
+
+	void ResetDroppedSampleCount()
+	{
+		sampleRing.ResetDroppedCount();
+	}
 }
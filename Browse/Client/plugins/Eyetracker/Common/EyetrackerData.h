@@ -3,7 +3,8 @@
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
 // Handles data from eye trackers. As fetch is called from main thread and
-// push back from eye trackers, mutex is used for synchronisation.
+// push back from eye trackers, a lock-free single producer / single consumer
+// ring is used for synchronisation.
 
 #ifndef EYETRACKERDATA_H_
 #define EYETRACKERDATA_H_
@@ -19,7 +20,9 @@ namespace eyetracker_global
 	void ContinueLabStream();
 	void PauseLabStream();
 	void PushBackSample(SampleData sample);
-	void FetchSamples(SampleQueue& rupSamples);
+	int FetchSamples(SampleData* pSamples, int maxCount); // returns count of samples written
+	unsigned int GetDroppedSampleCount(); // samples dropped because main thread did not fetch in time
+	void ResetDroppedSampleCount(); // called at connection
 }
 
 #endif EYETRACKERDATA_H_
@@ -0,0 +1,84 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Fixed-capacity, lock-free ring buffer for exactly one producer thread (eye
+// tracker) and one consumer thread (main loop). Storage is allocated once at
+// construction. When full, newest samples are dropped and counted instead of
+// blocking the producer.
+
+#ifndef SAMPLERING_H_
+#define SAMPLERING_H_
+
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+template<typename Type>
+class SampleRing
+{
+public:
+
+	// Constructor, capacity is rounded up to next power of two
+	SampleRing(size_t capacity) : _head(0), _tail(0), _dropped(0)
+	{
+		size_t size = 1;
+		while (size < capacity) { size <<= 1; }
+		_buffer.resize(size);
+		_mask = size - 1;
+	}
+
+	// Push single element. Returns false if ring was full and element has been dropped. Producer only
+	bool Push(const Type& rElement)
+	{
+		const size_t head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) > _mask) // full
+		{
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		_buffer[head & _mask] = rElement;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Move up to maxCount elements in order into provided array. Returns count of elements written. Consumer only
+	int Drain(Type* pTarget, int maxCount)
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		size_t count = _head.load(std::memory_order_acquire) - tail;
+		if (count > (size_t)maxCount) { count = (size_t)maxCount; }
+		for (size_t i = 0; i < count; i++)
+		{
+			pTarget[i] = _buffer[(tail + i) & _mask];
+		}
+		_tail.store(tail + count, std::memory_order_release);
+		return (int)count;
+	}
+
+	// Get count of elements dropped because ring was full
+	unsigned int GetDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+	// Reset count of dropped elements, e.g. at connection of producer
+	void ResetDroppedCount() { _dropped.store(0, std::memory_order_relaxed); }
+
+	// Get capacity
+	size_t GetCapacity() const { return _mask + 1; }
+
+private:
+
+	// Private copy / assignment constructors
+	SampleRing(const SampleRing&) {}
+	SampleRing& operator = (const SampleRing &) { return *this; }
+
+	// Storage
+	std::vector<Type> _buffer;
+	size_t _mask;
+
+	// Indices keep growing and are masked on access. Kept on own cache lines as written by different threads
+	alignas(64) std::atomic<size_t> _head; // written by producer
+	alignas(64) std::atomic<size_t> _tail; // written by consumer
+	alignas(64) std::atomic<unsigned int> _dropped; // written by producer
+};
+
+#endif // SAMPLERING_H_
@@ -31,8 +31,11 @@ extern "C" {
 	// Disconnect eyetracker, returns whether succesfull
 	DLL_API bool Disconnect();
 
-	// Fetches gaze samples and clears buffer
-	DLL_API void FetchSamples(SampleQueue& rspSamples);
+	// Moves up to maxCount buffered gaze samples into provided array, oldest first. Returns count of samples written
+	DLL_API int FetchSamples(SampleData* pSamples, int maxCount);
+
+	// Count of samples dropped since connection, because buffer was full before they were fetched
+	DLL_API unsigned int GetDroppedSampleCount();
 
 	// Perform calibration, returns whether succesfull
 	DLL_API CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspInfo);
@@ -8,7 +8,6 @@
 
 #include <chrono>
 #include <memory>
-#include <deque>
 
 // Coordinate systems for sample data coordinates
 enum class SampleDataCoordinateSystem
@@ -19,8 +18,10 @@ enum class SampleDataCoordinateSystem
 // Struct of sample data
 struct SampleData
 {
-	// Constructor
-	SampleData(double x, double y, SampleDataCoordinateSystem system, std::chrono::milliseconds timestamp, bool valid) : x(x), y(y), timestamp(timestamp), valid(valid)
+	// Constructors
+	SampleData() : x(0), y(0), system(SampleDataCoordinateSystem::SCREEN_PIXELS), timestamp(0), valid(false)
+	{};
+	SampleData(double x, double y, SampleDataCoordinateSystem system, std::chrono::milliseconds timestamp, bool valid) : x(x), y(y), system(system), timestamp(timestamp), valid(valid)
 	{};
 
 	// Fields
@@ -31,7 +32,7 @@ struct SampleData
 	bool valid;
 };
 
-// Typedef for unique pointer of sample queue
-typedef std::shared_ptr<std::deque<SampleData> > SampleQueue;
+// Count of samples buffered between eye tracker thread and main thread. At 1 kHz, this is about four seconds
+static const int EYETRACKER_SAMPLE_BUFFER_CAPACITY = 4096;
 
 #endif EYETRACKERSAMPLE_H_
\ No newline at end of file
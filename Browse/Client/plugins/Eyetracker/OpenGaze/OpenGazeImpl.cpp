@@ -24,6 +24,9 @@ int screenX, screenY, screenWidth, screenHeight = 0;
 
 bool Connect()
 {
+	// Count dropped samples from this connection on
+	eyetracker_global::ResetDroppedSampleCount();
+
 	// Try to connect to the client
 	client.client_connect();
 
@@ -59,7 +62,7 @@ bool Disconnect()
 	return true;
 }
 
-void FetchSamples(SampleQueue& rspSamples)
+int FetchSamples(SampleData* pSamples, int maxCount)
 {
 	// No callback is used by eye tracker, but samples are fetched here
 	float x, y;
@@ -110,7 +113,12 @@ void FetchSamples(SampleQueue& rspSamples)
 	}
 
 	// Finally, fetch collected samples
-	eyetracker_global::FetchSamples(rspSamples);
+	return eyetracker_global::FetchSamples(pSamples, maxCount);
+}
+
+unsigned int GetDroppedSampleCount()
+{
+	return eyetracker_global::GetDroppedSampleCount();
 }
 
 bool Calibrate()
@@ -39,6 +39,9 @@ int __stdcall SampleCallbackFunction(SampleStruct sampleData)
 
 EyetrackerInfo Connect(EyetrackerGeometry geometry)
 {
+	// Count dropped samples from this connection on
+	eyetracker_global::ResetDroppedSampleCount();
+
 	// TODO: use provided geometry similar to myGaze plugin
 
 	// Variables
@@ -125,9 +128,14 @@ bool Disconnect()
 	}
 }
 
-void FetchSamples(SampleQueue& rspSamples)
+int FetchSamples(SampleData* pSamples, int maxCount)
+{
+	return eyetracker_global::FetchSamples(pSamples, maxCount);
+}
+
+unsigned int GetDroppedSampleCount()
 {
-	eyetracker_global::FetchSamples(rspSamples);
+	return eyetracker_global::GetDroppedSampleCount();
 }
 
 CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspInfo)
@@ -145,6 +145,9 @@ bool InitializeGlobalInteractorSnapshot(TX_CONTEXTHANDLE hContext)
 
 EyetrackerInfo Connect(EyetrackerGeometry geometry)
 {
+	// Count dropped samples from this connection on
+	eyetracker_global::ResetDroppedSampleCount();
+
 	EyetrackerInfo info;
 
 	// Check for EyeX engine
@@ -202,9 +205,14 @@ bool Disconnect()
 	return success;
 }
 
-void FetchSamples(SampleQueue& rspSamples)
+int FetchSamples(SampleData* pSamples, int maxCount)
+{
+	return eyetracker_global::FetchSamples(pSamples, maxCount);
+}
+
+unsigned int GetDroppedSampleCount()
 {
-	eyetracker_global::FetchSamples(rspSamples);
+	return eyetracker_global::GetDroppedSampleCount();
 }
 
 CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspInfo)
@@ -40,6 +40,9 @@ int __stdcall SampleCallbackFunction(SampleStruct sampleData)
 
 EyetrackerInfo Connect(EyetrackerGeometry geometry)
 {
+	// Count dropped samples from this connection on
+	eyetracker_global::ResetDroppedSampleCount();
+
 	// Variables
 	EyetrackerInfo info;
 	int ret_connect = 0;
@@ -145,9 +148,14 @@ bool Disconnect()
 	}
 }
 
-void FetchSamples(SampleQueue& rspSamples)
+int FetchSamples(SampleData* pSamples, int maxCount)
+{
+	return eyetracker_global::FetchSamples(pSamples, maxCount);
+}
+
+unsigned int GetDroppedSampleCount()
 {
-	eyetracker_global::FetchSamples(rspSamples);
+	return eyetracker_global::GetDroppedSampleCount();
 }
 
 CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspInfo)
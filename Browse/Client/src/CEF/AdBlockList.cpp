@@ -0,0 +1,150 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "src/CEF/AdBlockList.h"
+#include "src/Utils/Logger.h"
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+// FNV-1a constants
+static const uint64_t HASH_OFFSET_BASIS = 14695981039346656037ull;
+static const uint64_t HASH_PRIME = 1099511628211ull;
+
+AdBlockList::AdBlockList(std::string filepath)
+{
+	std::ifstream file(filepath);
+	if (!file.is_open())
+	{
+		LogError("AdBlockList: Cannot open host list, path: ", filepath);
+		return;
+	}
+
+	// Read line by line
+	std::string line;
+	while (std::getline(file, line))
+	{
+		// Trim whitespace (also handles Windows line endings)
+		const auto first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos) { continue; }
+		const auto last = line.find_last_not_of(" \t\r");
+		line = line.substr(first, last - first + 1);
+
+		// Skip comments
+		if (line[0] == '#') { continue; }
+
+		AddHost(line);
+	}
+
+	LogInfo("AdBlockList: Loaded ", _hosts.size(), " hosts from ", filepath);
+}
+
+bool AdBlockList::Matches(const std::string& rURL) const
+{
+	const char* pBegin = nullptr;
+	const char* pEnd = nullptr;
+	if (!ExtractHost(rURL, pBegin, pEnd)) { return false; }
+
+	// Ignore trailing dot of fully qualified host
+	if (*(pEnd - 1) == '.') { --pEnd; }
+
+	// Walk host from top-level domain to front and check at each label boundary
+	uint64_t hash = HASH_OFFSET_BASIS;
+	for (const char* pCurrent = pEnd; pCurrent != pBegin;)
+	{
+		--pCurrent;
+		hash = ExtendHash(hash, *pCurrent);
+
+		// Suffix starting at current character is a complete label sequence
+		if (pCurrent == pBegin || *(pCurrent - 1) == '.')
+		{
+			const auto range = _index.equal_range(hash);
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				if (Equals(pCurrent, pEnd, _hosts[it->second])) { return true; }
+			}
+		}
+	}
+	return false;
+}
+
+bool AdBlockList::ExtractHost(const std::string& rURL, const char*& rpBegin, const char*& rpEnd)
+{
+	const char* pBegin = rURL.data();
+	const char* pEnd = pBegin + rURL.size();
+
+	// Skip scheme
+	for (const char* pCurrent = pBegin; pCurrent + 2 < pEnd; ++pCurrent)
+	{
+		const char c = *pCurrent;
+		if (c == ':')
+		{
+			if (*(pCurrent + 1) == '/' && *(pCurrent + 2) == '/') { pBegin = pCurrent + 3; }
+			break;
+		}
+		if (c == '/' || c == '?' || c == '#' || c == '.') { break; } // no scheme
+	}
+
+	// Host ends at path, query or fragment
+	const char* pAuthorityEnd = pBegin;
+	while (pAuthorityEnd != pEnd && *pAuthorityEnd != '/' && *pAuthorityEnd != '?' && *pAuthorityEnd != '#') { ++pAuthorityEnd; }
+
+	// Skip user information
+	for (const char* pCurrent = pAuthorityEnd; pCurrent != pBegin;)
+	{
+		--pCurrent;
+		if (*pCurrent == '@') { pBegin = pCurrent + 1; break; }
+	}
+
+	// Cut off port
+	const char* pHostEnd = pBegin;
+	while (pHostEnd != pAuthorityEnd && *pHostEnd != ':') { ++pHostEnd; }
+
+	if (pHostEnd == pBegin) { return false; }
+	rpBegin = pBegin;
+	rpEnd = pHostEnd;
+	return true;
+}
+
+uint64_t AdBlockList::ExtendHash(uint64_t hash, char c)
+{
+	hash ^= (uint64_t)(unsigned char)std::tolower((unsigned char)c);
+	return hash * HASH_PRIME;
+}
+
+bool AdBlockList::Equals(const char* pBegin, const char* pEnd, const std::string& rHost)
+{
+	if ((size_t)(pEnd - pBegin) != rHost.size()) { return false; }
+	for (size_t i = 0; i < rHost.size(); i++)
+	{
+		if (std::tolower((unsigned char)pBegin[i]) != rHost[i]) { return false; }
+	}
+	return true;
+}
+
+void AdBlockList::AddHost(std::string host)
+{
+	// Store lower case, without trailing dot
+	std::transform(host.begin(), host.end(), host.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+	if (!host.empty() && host.back() == '.') { host.pop_back(); }
+	if (host.empty()) { return; }
+
+	// Hash over reversed host, same order as used while matching
+	uint64_t hash = HASH_OFFSET_BASIS;
+	for (auto it = host.rbegin(); it != host.rend(); ++it)
+	{
+		hash = ExtendHash(hash, *it);
+	}
+
+	// Skip duplicates
+	const auto range = _index.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (_hosts[it->second] == host) { return; }
+	}
+
+	_index.emplace(hash, (int)_hosts.size());
+	_hosts.push_back(host);
+}
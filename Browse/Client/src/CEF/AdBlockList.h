@@ -0,0 +1,53 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// List of hosts to block. Hosts are indexed by hashes over their reversed
+// labels, so a URL is checked by walking its host once from the top-level
+// domain to the front and looking up every suffix at a label boundary.
+// Built once at startup and read-only afterwards, thus safe to query from
+// any thread.
+
+#ifndef ADBLOCKLIST_H_
+#define ADBLOCKLIST_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class AdBlockList
+{
+public:
+
+	// Constructor, loads hosts from file. One host per line, lines starting with '#' are ignored
+	AdBlockList(std::string filepath);
+
+	// Check whether host of URL or one of its parent domains is listed. Does not allocate
+	bool Matches(const std::string& rURL) const;
+
+	// Get count of listed hosts
+	int GetHostCount() const { return (int)_hosts.size(); }
+
+private:
+
+	// Extract host out of URL. Returns false if no host found
+	static bool ExtractHost(const std::string& rURL, const char*& rpBegin, const char*& rpEnd);
+
+	// Extends hash of reversed host by one character
+	static uint64_t ExtendHash(uint64_t hash, char c);
+
+	// Compare host suffix to listed host, ignoring case
+	static bool Equals(const char* pBegin, const char* pEnd, const std::string& rHost);
+
+	// Add single host to list
+	void AddHost(std::string host);
+
+	// Listed hosts, lower case
+	std::vector<std::string> _hosts;
+
+	// Hash of reversed host to index in hosts vector
+	std::unordered_multimap<uint64_t, int> _index;
+};
+
+#endif // ADBLOCKLIST_H_
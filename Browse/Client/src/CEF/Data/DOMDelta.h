@@ -0,0 +1,35 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Format of batched DOM node changes. JavaScript collects changes of DOM nodes
+// during an animation frame and hands them to the Render Process at once,
+// which forwards them in a single IPC message to the Main Process. Arguments
+// of the message are a flat list with a fixed count of fields per delta:
+//	operation : int, see DOMDeltaOperation
+//	nodeType : int, like in DOM#{add | rem | upd}#nodeType#...
+//	nodeID : int
+//	attribute : int, see DOMAttribute. Only used by update, otherwise -1
+//	data : string, attribute data encoded like in DOM#upd#... Only used by update, otherwise empty
+
+#ifndef DOMDELTA_H_
+#define DOMDELTA_H_
+
+#include <string>
+
+// Operations of delta, values must match DOM_DELTA_* in dom_attributes.js
+enum DOMDeltaOperation
+{
+	DOM_DELTA_ADD = 0,
+	DOM_DELTA_REMOVE = 1,
+	DOM_DELTA_UPDATE = 2
+};
+
+// Name of IPC message and JavaScript function
+const std::string DOM_DELTA_MESSAGE_NAME = "DOMDeltas";
+const std::string DOM_DELTA_JS_FUNCTION_NAME = "SendDOMDeltas";
+
+// Count of fields per delta
+const int DOM_DELTA_FIELD_COUNT = 5;
+
+#endif // DOMDELTA_H_
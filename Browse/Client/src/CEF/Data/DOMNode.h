@@ -19,6 +19,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include "src/Utils/Logger.h" // DEBUGGING
 
 namespace DOM
@@ -65,17 +66,24 @@ public:
 	virtual int GetId() override { return _id; }
 
 	// Custom final getter
-	std::vector<Rect> GetRects() const { return _rects; }
+	const std::vector<Rect>& GetRects() const { return _rects; }
 	int GetFixedId() const { return _fixedId; }
 	int GetOverflowId() const { return _overflowId; }
 	bool IsFixed() const { return (_fixedId >= 0); }
 	bool IsOccluded() const { return _occluded; }
 
+	// Set callback which is called whenever rects have changed, e.g. by spatial index
+	void SetRectsCallback(std::function<void(const std::vector<Rect>&)> callback) { _rectsCallback = callback; }
+
 private:
 
 	// Setter
 	void SetId(int id) { _id = id; }
-	void SetRects(std::vector<Rect> rects) { _rects = rects; }
+	void SetRects(std::vector<Rect> rects)
+	{
+		_rects = rects;
+		if (_rectsCallback) { _rectsCallback(_rects); }
+	}
 	void SetFixedId(int fixedId) { _fixedId = fixedId; }
 	void SetOverflowId(int overflowId) { _overflowId = overflowId; }
 	void SetOccBitmask(std::vector<bool> bitmask) { 
@@ -96,6 +104,7 @@ private:
 	static const std::vector<DOMAttribute> _description;
 	int _id;
 	std::vector<Rect> _rects = {};
+	std::function<void(const std::vector<Rect>&)> _rectsCallback;
 	int _fixedId = -1;		// first FixedElement's ID, which is hierarchically above this node, if any
 	int _overflowId = -1;	// first DOMOverflowElement's ID, which is hierarchically above this node, if any
 	std::vector<bool> _occBitmask;
@@ -0,0 +1,327 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "DOMNodeIndex.h"
+#include <algorithm>
+
+// Nodes covering more cells are not listed in cells but checked by every query
+static const int MAX_CELLS_PER_NODE = 256;
+
+// Limit of cell coordinates, protects against overflow with degenerated rectangles
+static const float MAX_CELL_COORDINATE = 1000000.f;
+
+DOMNodeIndex::DOMNodeIndex(float cellSize) : _cellSize(cellSize)
+{
+	// Nothing to do
+}
+
+DOMNodeIndex::~DOMNodeIndex()
+{
+	Clear();
+}
+
+void DOMNodeIndex::Insert(std::shared_ptr<DOMNode> spNode)
+{
+	const int id = spNode->GetId();
+	Remove(id);
+
+	// Create entry
+	Entry& rEntry = _nodes[id];
+	rEntry.wpNode = spNode;
+	rEntry.rects = spNode->GetRects();
+	Link(id, rEntry);
+
+	// Follow changes of rectangles
+	spNode->SetRectsCallback([this, id](const std::vector<Rect>& rRects) { this->Update(id, rRects); });
+}
+
+void DOMNodeIndex::Remove(int id)
+{
+	auto it = _nodes.find(id);
+	if (it == _nodes.end()) { return; }
+
+	// Stop following node
+	if (auto spNode = std::const_pointer_cast<DOMNode>(it->second.wpNode.lock()))
+	{
+		spNode->SetRectsCallback(nullptr);
+	}
+
+	Unlink(id, it->second);
+	_nodes.erase(it);
+}
+
+void DOMNodeIndex::Clear()
+{
+	for (auto& rIdEntryPair : _nodes)
+	{
+		if (auto spNode = std::const_pointer_cast<DOMNode>(rIdEntryPair.second.wpNode.lock()))
+		{
+			spNode->SetRectsCallback(nullptr);
+		}
+	}
+	_nodes.clear();
+	_cells.clear();
+	_largeNodes.clear();
+	_minCellX = 0;
+	_minCellY = 0;
+	_maxCellX = -1;
+	_maxCellY = -1;
+}
+
+bool DOMNodeIndex::Nearest(glm::vec2 pagePixelCoordinate, Result& rResult, float maxDistance) const
+{
+	auto results = KNearest(pagePixelCoordinate, 1, maxDistance);
+	if (results.empty()) { return false; }
+	rResult = results.front();
+	return true;
+}
+
+std::vector<DOMNodeIndex::Result> DOMNodeIndex::KNearest(glm::vec2 pagePixelCoordinate, int k, float maxDistance) const
+{
+	std::vector<Candidate> candidates;
+	if (_nodes.empty() || k <= 0) { return ToResults(candidates, k); }
+	const unsigned int visit = ++_visit;
+
+	// Large nodes are always candidates
+	for (int id : _largeNodes)
+	{
+		VisitNode(pagePixelCoordinate, id, maxDistance, visit, candidates);
+	}
+
+	// Visit rings of cells around cell of coordinate until no closer node can follow
+	if (_maxCellX >= _minCellX)
+	{
+		const int centerX = CellCoordinate(pagePixelCoordinate.x);
+		const int centerY = CellCoordinate(pagePixelCoordinate.y);
+		for (int ring = 0; ; ring++)
+		{
+			VisitRing(pagePixelCoordinate, centerX, centerY, ring, maxDistance, visit, candidates);
+
+			// All occupied cells visited
+			if (centerX - ring <= _minCellX && centerX + ring >= _maxCellX
+				&& centerY - ring <= _minCellY && centerY + ring >= _maxCellY)
+			{
+				break;
+			}
+
+			// Nodes not yet visited are at least that far away
+			const float bound = (float)ring * _cellSize;
+			if (bound > maxDistance) { break; }
+			if ((int)candidates.size() >= k)
+			{
+				std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(),
+					[](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+				if (candidates[k - 1].distance <= bound) { break; }
+			}
+		}
+	}
+
+	return ToResults(candidates, k);
+}
+
+std::vector<DOMNodeIndex::Result> DOMNodeIndex::Within(glm::vec2 pagePixelCoordinate, float radius) const
+{
+	std::vector<Candidate> candidates;
+	if (_nodes.empty() || radius < 0) { return ToResults(candidates, 0); }
+	const unsigned int visit = ++_visit;
+
+	// Large nodes
+	for (int id : _largeNodes)
+	{
+		VisitNode(pagePixelCoordinate, id, radius, visit, candidates);
+	}
+
+	// Cells overlapping square around coordinate
+	const int minX = std::max(CellCoordinate(pagePixelCoordinate.x - radius), _minCellX);
+	const int maxX = std::min(CellCoordinate(pagePixelCoordinate.x + radius), _maxCellX);
+	const int minY = std::max(CellCoordinate(pagePixelCoordinate.y - radius), _minCellY);
+	const int maxY = std::min(CellCoordinate(pagePixelCoordinate.y + radius), _maxCellY);
+	for (int y = minY; y <= maxY; y++)
+	{
+		for (int x = minX; x <= maxX; x++)
+		{
+			const auto it = _cells.find(CellKey(x, y));
+			if (it == _cells.end()) { continue; }
+			for (int id : it->second)
+			{
+				VisitNode(pagePixelCoordinate, id, radius, visit, candidates);
+			}
+		}
+	}
+
+	return ToResults(candidates, (int)candidates.size());
+}
+
+void DOMNodeIndex::Update(int id, const std::vector<Rect>& rRects)
+{
+	auto it = _nodes.find(id);
+	if (it == _nodes.end()) { return; }
+	Unlink(id, it->second);
+	it->second.rects = rRects;
+	Link(id, it->second);
+}
+
+void DOMNodeIndex::Link(int id, Entry& rEntry)
+{
+	// Collect cells covered by rectangles
+	rEntry.cells.clear();
+	rEntry.large = false;
+	for (const auto& rRect : rEntry.rects)
+	{
+		const int minX = CellCoordinate(std::min(rRect.left, rRect.right));
+		const int maxX = CellCoordinate(std::max(rRect.left, rRect.right));
+		const int minY = CellCoordinate(std::min(rRect.top, rRect.bottom));
+		const int maxY = CellCoordinate(std::max(rRect.top, rRect.bottom));
+		if ((long long)(maxX - minX + 1) * (long long)(maxY - minY + 1) + (long long)rEntry.cells.size() > MAX_CELLS_PER_NODE)
+		{
+			rEntry.large = true;
+			break;
+		}
+		for (int y = minY; y <= maxY; y++)
+		{
+			for (int x = minX; x <= maxX; x++)
+			{
+				rEntry.cells.push_back(CellKey(x, y));
+			}
+		}
+
+		// Grow bounds of occupied cells
+		if (_maxCellX < _minCellX)
+		{
+			_minCellX = minX; _maxCellX = maxX;
+			_minCellY = minY; _maxCellY = maxY;
+		}
+		else
+		{
+			_minCellX = std::min(_minCellX, minX); _maxCellX = std::max(_maxCellX, maxX);
+			_minCellY = std::min(_minCellY, minY); _maxCellY = std::max(_maxCellY, maxY);
+		}
+	}
+
+	// Large nodes are checked by every query
+	if (rEntry.large)
+	{
+		rEntry.cells.clear();
+		_largeNodes.push_back(id);
+		return;
+	}
+
+	// Multiple rectangles of one node may share cells
+	std::sort(rEntry.cells.begin(), rEntry.cells.end());
+	rEntry.cells.erase(std::unique(rEntry.cells.begin(), rEntry.cells.end()), rEntry.cells.end());
+	for (long long key : rEntry.cells)
+	{
+		_cells[key].push_back(id);
+	}
+}
+
+void DOMNodeIndex::Unlink(int id, Entry& rEntry)
+{
+	if (rEntry.large)
+	{
+		_largeNodes.erase(std::find(_largeNodes.begin(), _largeNodes.end(), id));
+		rEntry.large = false;
+		return;
+	}
+
+	for (long long key : rEntry.cells)
+	{
+		auto it = _cells.find(key);
+		if (it == _cells.end()) { continue; }
+		auto& rIds = it->second;
+		auto idIt = std::find(rIds.begin(), rIds.end(), id);
+		if (idIt != rIds.end())
+		{
+			*idIt = rIds.back();
+			rIds.pop_back();
+		}
+		if (rIds.empty()) { _cells.erase(it); }
+	}
+	rEntry.cells.clear();
+}
+
+void DOMNodeIndex::VisitRing(glm::vec2 pagePixelCoordinate, int centerX, int centerY, int ring, float maxDistance, unsigned int visit, std::vector<Candidate>& rCandidates) const
+{
+	auto visitCell = [&](int x, int y)
+	{
+		const auto it = _cells.find(CellKey(x, y));
+		if (it == _cells.end()) { return; }
+		for (int id : it->second)
+		{
+			VisitNode(pagePixelCoordinate, id, maxDistance, visit, rCandidates);
+		}
+	};
+
+	// Center cell
+	if (ring == 0)
+	{
+		visitCell(centerX, centerY);
+		return;
+	}
+
+	// Top and bottom row, clamped to occupied cells
+	const int minX = std::max(centerX - ring, _minCellX);
+	const int maxX = std::min(centerX + ring, _maxCellX);
+	for (int y : { centerY - ring, centerY + ring })
+	{
+		if (y < _minCellY || y > _maxCellY) { continue; }
+		for (int x = minX; x <= maxX; x++) { visitCell(x, y); }
+	}
+
+	// Left and right column without corners, clamped to occupied cells
+	const int minY = std::max(centerY - ring + 1, _minCellY);
+	const int maxY = std::min(centerY + ring - 1, _maxCellY);
+	for (int x : { centerX - ring, centerX + ring })
+	{
+		if (x < _minCellX || x > _maxCellX) { continue; }
+		for (int y = minY; y <= maxY; y++) { visitCell(x, y); }
+	}
+}
+
+void DOMNodeIndex::VisitNode(glm::vec2 pagePixelCoordinate, int id, float maxDistance, unsigned int visit, std::vector<Candidate>& rCandidates) const
+{
+	const Entry& rEntry = _nodes.at(id);
+	if (rEntry.visit == visit) { return; }
+	rEntry.visit = visit;
+
+	// Distance to nearest rectangle of node
+	float distance = std::numeric_limits<float>::max();
+	for (const auto& rRect : rEntry.rects)
+	{
+		distance = std::min(distance, Distance(pagePixelCoordinate, rRect));
+	}
+	if (!rEntry.rects.empty() && distance <= maxDistance)
+	{
+		rCandidates.push_back({ id, distance });
+	}
+}
+
+std::vector<DOMNodeIndex::Result> DOMNodeIndex::ToResults(std::vector<Candidate>& rCandidates, int maxCount) const
+{
+	// Ties are resolved by id, like iterating over ordered map of nodes
+	std::sort(rCandidates.begin(), rCandidates.end(),
+		[](const Candidate& a, const Candidate& b) { return a.distance < b.distance || (a.distance == b.distance && a.id < b.id); });
+
+	std::vector<Result> results;
+	const int count = std::min(maxCount, (int)rCandidates.size());
+	results.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		results.push_back({ _nodes.at(rCandidates[i].id).wpNode, rCandidates[i].distance });
+	}
+	return results;
+}
+
+int DOMNodeIndex::CellCoordinate(float pagePixel) const
+{
+	return (int)glm::floor(glm::clamp(pagePixel / _cellSize, -MAX_CELL_COORDINATE, MAX_CELL_COORDINATE));
+}
+
+float DOMNodeIndex::Distance(glm::vec2 pagePixelCoordinate, const Rect& rRect)
+{
+	const float dx = glm::max(glm::abs(pagePixelCoordinate.x - rRect.Center().x) - (rRect.Width() / 2.f), 0.f);
+	const float dy = glm::max(glm::abs(pagePixelCoordinate.y - rRect.Center().y) - (rRect.Height() / 2.f), 0.f);
+	return glm::sqrt((dx * dx) + (dy * dy));
+}
@@ -0,0 +1,118 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Spatial index over the rectangles of DOM nodes in page pixel space. Uniform
+// grid of square cells, each cell lists the nodes with a rectangle touching it.
+// Nodes notify the index when their rectangles change, so the index is updated
+// incrementally per node instead of being rebuilt. Rectangles which would
+// cover too many cells are kept in a separate list and checked by every query.
+
+#ifndef DOMNODEINDEX_H_
+#define DOMNODEINDEX_H_
+
+#include "src/CEF/Data/DOMNode.h"
+#include <unordered_map>
+#include <vector>
+#include <memory>
+#include <limits>
+
+class DOMNodeIndex
+{
+public:
+
+	// Query result
+	struct Result
+	{
+		std::weak_ptr<const DOMNode> wpNode;
+		float distance; // distance from query coordinate to nearest rectangle of node in page pixels, zero if inside
+	};
+
+	// Constructor, cell size in page pixels
+	DOMNodeIndex(float cellSize);
+
+	// Destructor, unregisters from nodes
+	~DOMNodeIndex();
+
+	// Nodes refer to index, so it must not be copied
+	DOMNodeIndex(const DOMNodeIndex&) = delete;
+	DOMNodeIndex& operator=(const DOMNodeIndex&) = delete;
+
+	// Add node to index. Index follows changes of its rectangles until removed
+	void Insert(std::shared_ptr<DOMNode> spNode);
+
+	// Remove node from index
+	void Remove(int id);
+
+	// Remove all nodes from index
+	void Clear();
+
+	// Nearest node to coordinate. Returns false if there is no node within max distance
+	bool Nearest(glm::vec2 pagePixelCoordinate, Result& rResult, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	// Up to k nearest nodes to coordinate within max distance, sorted by distance
+	std::vector<Result> KNearest(glm::vec2 pagePixelCoordinate, int k, float maxDistance = std::numeric_limits<float>::max()) const;
+
+	// All nodes within radius around coordinate, sorted by distance
+	std::vector<Result> Within(glm::vec2 pagePixelCoordinate, float radius) const;
+
+	// Count of nodes in index
+	int GetSize() const { return (int)_nodes.size(); }
+
+private:
+
+	// Entry per node
+	struct Entry
+	{
+		std::weak_ptr<const DOMNode> wpNode;
+		std::vector<Rect> rects;
+		std::vector<long long> cells; // keys of cells listing this node
+		bool large = false; // listed in large nodes instead of cells
+		mutable unsigned int visit = 0; // stamp of last query which visited this node
+	};
+
+	// Candidate during query
+	struct Candidate
+	{
+		int id;
+		float distance;
+	};
+
+	// Called by node when its rectangles have changed
+	void Update(int id, const std::vector<Rect>& rRects);
+
+	// Add or remove entry from cells
+	void Link(int id, Entry& rEntry);
+	void Unlink(int id, Entry& rEntry);
+
+	// Collect candidates not further away than max distance from cells in ring around center cell
+	void VisitRing(glm::vec2 pagePixelCoordinate, int centerX, int centerY, int ring, float maxDistance, unsigned int visit, std::vector<Candidate>& rCandidates) const;
+
+	// Collect candidate if not yet visited in this query and not further away than max distance
+	void VisitNode(glm::vec2 pagePixelCoordinate, int id, float maxDistance, unsigned int visit, std::vector<Candidate>& rCandidates) const;
+
+	// Convert candidates to results, sorted by distance and id
+	std::vector<Result> ToResults(std::vector<Candidate>& rCandidates, int maxCount) const;
+
+	// Cell coordinate of page pixel coordinate
+	int CellCoordinate(float pagePixel) const;
+
+	// Key of cell
+	static long long CellKey(int x, int y) { return ((long long)x << 32) ^ (long long)(unsigned int)y; }
+
+	// Distance of coordinate to rectangle, zero if inside
+	static float Distance(glm::vec2 pagePixelCoordinate, const Rect& rRect);
+
+	// Members
+	float _cellSize;
+	std::unordered_map<int, Entry> _nodes;
+	std::unordered_map<long long, std::vector<int> > _cells;
+	std::vector<int> _largeNodes;
+	int _minCellX = 0; // bounds of cells ever occupied, only grow until index is cleared
+	int _minCellY = 0;
+	int _maxCellX = -1;
+	int _maxCellY = -1;
+	mutable unsigned int _visit = 0;
+};
+
+#endif // DOMNODEINDEX_H_
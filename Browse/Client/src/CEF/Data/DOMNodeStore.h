@@ -0,0 +1,207 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Store of DOM nodes of one type. Nodes are kept in a dense array, so that
+// iteration only touches living nodes, and are found by their id through a
+// hash index of slots. Removal moves the last node into the freed slot, so
+// order of iteration is not the order of insertion. Nodes and their reference
+// counts are allocated together in chunks of a pool, which are reused after
+// removal instead of being returned to the heap. Not threadsafe.
+
+#ifndef DOMNODESTORE_H_
+#define DOMNODESTORE_H_
+
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstddef>
+
+// Pool of equally sized chunks. Size of chunk is set by first allocation,
+// allocations of other sizes are passed to the heap
+class DOMNodePool
+{
+public:
+
+	// Constructor
+	DOMNodePool() {}
+
+	// Pool is referred by allocators, so it must not be copied
+	DOMNodePool(const DOMNodePool&) = delete;
+	DOMNodePool& operator=(const DOMNodePool&) = delete;
+
+	// Allocate memory
+	void* Allocate(std::size_t size)
+	{
+		const std::size_t chunkSize = RoundUp(size);
+		if (_chunkSize == 0) { _chunkSize = chunkSize; }
+		if (chunkSize != _chunkSize) { return ::operator new(size); }
+
+		// Reuse freed chunk
+		if (_pFree != nullptr)
+		{
+			FreeChunk* pChunk = _pFree;
+			_pFree = pChunk->pNext;
+			return pChunk;
+		}
+
+		// Take chunk from current block or start new block
+		if (_blocks.empty() || _blockUsage == CHUNKS_PER_BLOCK)
+		{
+			_blocks.push_back(std::unique_ptr<unsigned char[]>(new unsigned char[_chunkSize * CHUNKS_PER_BLOCK]));
+			_blockUsage = 0;
+		}
+		return _blocks.back().get() + (_chunkSize * _blockUsage++);
+	}
+
+	// Deallocate memory, size must be the same as at allocation
+	void Deallocate(void* pMemory, std::size_t size)
+	{
+		if (RoundUp(size) != _chunkSize) { ::operator delete(pMemory); return; }
+		FreeChunk* pChunk = static_cast<FreeChunk*>(pMemory);
+		pChunk->pNext = _pFree;
+		_pFree = pChunk;
+	}
+
+private:
+
+	// Freed chunk, keeps list of freed chunks inside of them
+	struct FreeChunk
+	{
+		FreeChunk* pNext;
+	};
+
+	// Round size up to alignment of any type
+	static std::size_t RoundUp(std::size_t size)
+	{
+		const std::size_t alignment = alignof(std::max_align_t);
+		if (size < sizeof(FreeChunk)) { size = sizeof(FreeChunk); }
+		return ((size + alignment - 1) / alignment) * alignment;
+	}
+
+	// Count of chunks allocated at once
+	static const std::size_t CHUNKS_PER_BLOCK = 64;
+
+	// Members
+	std::size_t _chunkSize = 0;
+	std::vector<std::unique_ptr<unsigned char[]> > _blocks;
+	std::size_t _blockUsage = 0; // used chunks in last block
+	FreeChunk* _pFree = nullptr;
+};
+
+// Allocator for shared pointers using pool. Keeps pool alive as long as
+// memory of any node is allocated, e.g. while weak pointers to it exist
+template<typename T>
+class DOMNodePoolAllocator
+{
+public:
+
+	typedef T value_type;
+
+	// Constructor
+	DOMNodePoolAllocator(std::shared_ptr<DOMNodePool> spPool) : _spPool(spPool) {}
+
+	// Conversion between types, as required by shared pointers
+	template<typename U>
+	DOMNodePoolAllocator(const DOMNodePoolAllocator<U>& rOther) : _spPool(rOther._spPool) {}
+
+	// Allocation
+	T* allocate(std::size_t count) { return static_cast<T*>(_spPool->Allocate(count * sizeof(T))); }
+	void deallocate(T* pMemory, std::size_t count) { _spPool->Deallocate(pMemory, count * sizeof(T)); }
+
+	// Comparison
+	template<typename U>
+	bool operator==(const DOMNodePoolAllocator<U>& rOther) const { return _spPool == rOther._spPool; }
+	template<typename U>
+	bool operator!=(const DOMNodePoolAllocator<U>& rOther) const { return _spPool != rOther._spPool; }
+
+private:
+
+	template<typename U> friend class DOMNodePoolAllocator;
+
+	// Members
+	std::shared_ptr<DOMNodePool> _spPool;
+};
+
+template<typename T>
+class DOMNodeStore
+{
+public:
+
+	typedef typename std::vector<std::shared_ptr<T> >::const_iterator const_iterator;
+
+	// Constructor
+	DOMNodeStore() : _spPool(std::make_shared<DOMNodePool>()) {}
+
+	// Create node with id in pool and add it. Returns existing node if id is already taken
+	template<typename... Args>
+	std::shared_ptr<T> Emplace(int id, Args&&... args)
+	{
+		auto iter = _slots.find(id);
+		if (iter != _slots.end()) { return _nodes[iter->second]; }
+		_slots.emplace(id, (unsigned int)_nodes.size());
+		_ids.push_back(id);
+		_nodes.push_back(std::allocate_shared<T>(DOMNodePoolAllocator<T>(_spPool), id, std::forward<Args>(args)...));
+		return _nodes.back();
+	}
+
+	// Remove node. Returns whether node was found
+	bool Remove(int id)
+	{
+		auto iter = _slots.find(id);
+		if (iter == _slots.end()) { return false; }
+
+		// Move last node into slot of removed one
+		const unsigned int slot = iter->second;
+		_slots.erase(iter);
+		if (slot + 1 < _nodes.size())
+		{
+			_nodes[slot] = std::move(_nodes.back());
+			_ids[slot] = _ids.back();
+			_slots[_ids[slot]] = slot;
+		}
+		_nodes.pop_back();
+		_ids.pop_back();
+		return true;
+	}
+
+	// Remove all nodes
+	void Clear()
+	{
+		_nodes.clear();
+		_ids.clear();
+		_slots.clear();
+	}
+
+	// Get node by id. Returns nullptr if not found
+	T* Get(int id) const
+	{
+		auto iter = _slots.find(id);
+		return (iter != _slots.end()) ? _nodes[iter->second].get() : nullptr;
+	}
+
+	// Get weak pointer to node by id. Returns empty pointer if not found
+	std::weak_ptr<T> GetWeak(int id) const
+	{
+		auto iter = _slots.find(id);
+		return (iter != _slots.end()) ? std::weak_ptr<T>(_nodes[iter->second]) : std::weak_ptr<T>();
+	}
+
+	// Iteration over shared pointers of nodes
+	const_iterator begin() const { return _nodes.begin(); }
+	const_iterator end() const { return _nodes.end(); }
+
+	// Count of nodes
+	std::size_t size() const { return _nodes.size(); }
+	bool empty() const { return _nodes.empty(); }
+
+private:
+
+	// Members
+	std::vector<std::shared_ptr<T> > _nodes; // dense array of nodes
+	std::vector<int> _ids; // ids of nodes, parallel to nodes
+	std::unordered_map<int, unsigned int> _slots; // id to slot in dense arrays
+	std::shared_ptr<DOMNodePool> _spPool;
+};
+
+#endif // DOMNODESTORE_H_
@@ -16,6 +16,7 @@
 #include <string>
 #include <cmath>
 #include "src/CEF/Data/DOMNode.h"
+#include "src/CEF/Data/DOMDelta.h"
 // For keyboard emulation
 #include "submodules/glfw/include/GLFW/glfw3.h"
 #include "submodules/eyeGUI/include/eyeGUI.h"
@@ -218,6 +219,9 @@ void Handler::CloseBrowser(CefRefPtr<CefBrowser> browser)
 
     browser->GetHost()->CloseBrowser(false);
 
+    // Paints of closed browser are not shown anymore
+    _renderer->DiscardDeferredPaint(browser);
+
     LogDebug("Handler: Browser successfully closed (id = ", browserID, ").");
 }
 
@@ -279,6 +283,12 @@ bool Handler::OnProcessMessageReceived(CefRefPtr<CefBrowser> browser,
 		return true;
     }
 
+	if (msgName == DOM_DELTA_MESSAGE_NAME)
+	{
+		_msgRouter->ReceiveDOMDeltas(browser, msg);
+		return true;
+	}
+
 	if (msgName == "OnContextCreated")
 	{
 		_pMediator->ClearDOMNodes(browser);
@@ -494,6 +504,12 @@ void Handler::ResetMainFramesScrolling(CefRefPtr<CefBrowser> browser)
     browser->GetMainFrame()->ExecuteJavaScript(resetScrolling, browser->GetMainFrame()->GetURL(), 0);
 }
 
+void Handler::ScrollMainFrame(CefRefPtr<CefBrowser> browser, double x, double y)
+{
+    const std::string scrolling = "window.scrollTo(" + std::to_string(x) + ", " + std::to_string(y) + ");";
+    browser->GetMainFrame()->ExecuteJavaScript(scrolling, browser->GetMainFrame()->GetURL(), 0);
+}
+
 void Handler::SetZoomLevel(CefRefPtr<CefBrowser> browser, bool definitelyChanged)
 {
 
@@ -125,6 +125,12 @@ public:
     // Called by CefMediator, when window resize happens
     void ResizeBrowsers();
 
+    // Deferred paints of browsers in background, see Renderer
+    void FlushDeferredPaint(CefRefPtr<CefBrowser> browser) { _renderer->FlushDeferredPaint(browser); }
+    void DiscardDeferredPaint(CefRefPtr<CefBrowser> browser) { _renderer->DiscardDeferredPaint(browser); }
+    unsigned int GetSkippedUploadCount(CefRefPtr<CefBrowser> browser) const { return _renderer->GetSkippedUploadCount(browser); }
+    size_t GetDeferredPaintBytes(CefRefPtr<CefBrowser> browser) const { return _renderer->GetDeferredPaintBytes(browser); }
+
     // Emulation of mouse buttons in specific browser
     void EmulateMouseCursor(CefRefPtr<CefBrowser> browser, double x, double y, bool leftButtonPressed);
     void EmulateLeftMouseButtonClick(CefRefPtr<CefBrowser> browser, double x, double y);
@@ -135,6 +141,7 @@ public:
 	void EmulateSelectAll(CefRefPtr<CefBrowser> browser);
     
     void ResetMainFramesScrolling(CefRefPtr<CefBrowser> browser);
+    void ScrollMainFrame(CefRefPtr<CefBrowser> browser, double x, double y);
 
     // Bool value indicates need to reload DOM node data, true when called from outside of Tab due to changes
     void SetZoomLevel(CefRefPtr<CefBrowser> browser, bool definitelyChanged = true);
@@ -39,9 +39,8 @@ void Mediator::RegisterTab(TabCEFInterface* pTab, std::string URL, CefRefPtr<Cef
     if(setup::ENABLE_WEBGL)
     {
         browser_settings.webgl = STATE_ENABLED;
-        browser_settings.windowless_frame_rate = 60;
-	
     }
+    browser_settings.windowless_frame_rate = setup::WEB_VIEW_FRAME_RATE;
 
 	browser_settings.application_cache = STATE_ENABLED; // Goal: Accepting & saving cookies enabled
 
@@ -307,17 +306,62 @@ void Mediator::SetActiveTab(TabCEFInterface * pTab)
 		CefRefPtr<CefBrowser> browser = key.second;
 		if (key.first == pTab)
 		{
-			// Activate the given Tab's rendering
+			// Activate the given Tab's rendering and show its latest paint from background
 			browser->GetHost()->WasHidden(false);
+			browser->GetHost()->SetWindowlessFrameRate(setup::WEB_VIEW_FRAME_RATE);
+			_handler->FlushDeferredPaint(browser);
 		}
 		else
 		{
 			// Deactivate rendering of all other Tabs
 			browser->GetHost()->WasHidden(true);
+			browser->GetHost()->SetWindowlessFrameRate(setup::WEB_VIEW_BACKGROUND_FRAME_RATE);
 		}
 	}
 }
 
+bool Mediator::IsShown(CefRefPtr<CefBrowser> browser) const
+{
+	// Tab in registration is shown, as it is not yet known whether it becomes active
+	auto iter = _tabs.find(browser->GetIdentifier());
+	return iter == _tabs.end() || iter->second == _activeTab;
+}
+
+void Mediator::DiscardDeferredPaint(TabCEFInterface* pTab)
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		_handler->DiscardDeferredPaint(browser);
+	}
+}
+
+unsigned int Mediator::GetSkippedUploadCount(TabCEFInterface* pTab) const
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		return _handler->GetSkippedUploadCount(browser);
+	}
+	return 0;
+}
+
+size_t Mediator::GetDeferredPaintBytes(TabCEFInterface* pTab) const
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		return _handler->GetDeferredPaintBytes(browser);
+	}
+	return 0;
+}
+
+int Mediator::GetBrowserId(TabCEFInterface* pTab) const
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		return browser->GetIdentifier();
+	}
+	return -1;
+}
+
 
 
 bool Mediator::SetLoadingStatus(CefRefPtr<CefBrowser> browser, bool isLoading, bool isMainFrame)
@@ -420,6 +464,14 @@ void Mediator::ResetScrolling(TabCEFInterface * pTab)
     }
 }
 
+void Mediator::SetScrolling(TabCEFInterface * pTab, double x, double y)
+{
+    if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+    {
+        _handler->ScrollMainFrame(browser, x, y);
+    }
+}
+
 void Mediator::SetURL(CefRefPtr<CefBrowser> browser)
 {
     if (TabCEFInterface* pTab = GetTab(browser))
@@ -774,6 +826,10 @@ void Mediator::OnScrollOffsetChanged(CefRefPtr<CefBrowser> browser, double x, do
     {
         // Set scrolling offset of correlating Tab
         pTab->SetScrollingOffset(x, y);
+
+        // Start new scroll epoch in geometry sync, which checks fixed and visible DOM nodes for changes
+        browser->GetMainFrame()->ExecuteJavaScript(
+            "CefSyncGeometry(" + std::to_string(setup::DOM_GEOMETRY_SYNC_BUDGET) + ");", "CefSyncGeometry", 0);
     }
 }
 
@@ -89,6 +89,7 @@ public:
 	bool EmulateSelectAll(TabCEFInterface* pTab);
 
     void ResetScrolling(TabCEFInterface* pTab);
+    void SetScrolling(TabCEFInterface* pTab, double x, double y);
 
     // Sets Tab's URL attribute, called by Handler when main frame starts loading a page
     void SetURL(CefRefPtr<CefBrowser> browser);
@@ -175,6 +176,21 @@ public:
 
 	// Activate rendering in given Tab and deactivate it for all other Tabs
 	void SetActiveTab(TabCEFInterface* pTab);	// TODO Raphael: Call this method when Tab is changed via GUI
+
+	// Whether paints of browser are shown right away. Paints of other browsers are deferred by Renderer
+	bool IsShown(CefRefPtr<CefBrowser> browser) const;
+
+	// Forget deferred paint of Tab, e.g. when it hibernates
+	void DiscardDeferredPaint(TabCEFInterface* pTab);
+
+	// Count of paints of Tab which were never uploaded, because later paint replaced them
+	unsigned int GetSkippedUploadCount(TabCEFInterface* pTab) const;
+
+	// Bytes held by deferred paint of Tab, which is a complete copy of its latest paint in background
+	size_t GetDeferredPaintBytes(TabCEFInterface* pTab) const;
+
+	// Identifier of browser of Tab, e.g. to match frames of frame tap. Negative if Tab has no browser
+	int GetBrowserId(TabCEFInterface* pTab) const;
 	
 	// Master calls this method upon GLFW keyboard input in order to open new window with DevTools (for active Tab)
 	void ShowDevTools();
@@ -8,9 +8,117 @@
 #include "src/Utils/Logger.h"
 #include "src/CEF/Data/DOMNode.h"
 #include "src/CEF/Data/DOMExtraction.h"
+#include "src/CEF/Data/DOMDelta.h"
 #include <cstdlib>
 #include <algorithm>
 
+// Create blank node object in corresponding Tab object and request its data from Renderer Process
+static void AddDOMNode(Mediator* pMediator, CefRefPtr<CefBrowser> browser, int type, int id)
+{
+	switch (type)
+	{
+		case(0): {pMediator->AddDOMTextInput(browser, id); break; }
+		case(1): {pMediator->AddDOMLink(browser, id); break; }
+		case(2): {pMediator->AddDOMSelectField(browser, id); break; }
+		case(3): {pMediator->AddDOMOverflowElement(browser, id); break; }
+		case(4): {pMediator->AddDOMVideo(browser, id); break; }
+		case(5): {pMediator->AddDOMCheckbox(browser, id); break; }
+		default: {
+			LogError("MsgRouter: Adding DOMNode - Unknown type of DOMNode! type=", type);
+		}
+	}
+
+	// TODO: This could be done in DOMExtraction
+	const std::vector<std::string> names = { "TextInput", "Link", "SelectField", "OverflowElement", "Video", "Checkbox" };
+	if (type >= (int)names.size() || type < 0)
+	{
+		LogError("MsgRouter: - ERROR: Unknown numeric DOM node type value: ", type);
+		return;
+	}
+	const std::string& ipcName = names[type];
+
+	// Instruct Renderer Process to initialize empty DOM Nodes with data
+	// TODO: Move this to DOM node constructor?
+	CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("LoadDOM" + ipcName + "Data");
+	msg->GetArgumentList()->SetInt(0, type);
+	msg->GetArgumentList()->SetInt(1, id);
+	browser->SendProcessMessage(PID_RENDERER, msg);
+}
+
+// Remove node object from corresponding Tab object
+static void RemoveDOMNode(Mediator* pMediator, CefRefPtr<CefBrowser> browser, int type, int id)
+{
+	switch (type)
+	{
+		case(0): {pMediator->RemoveDOMTextInput(browser, id); break; }
+		case(1): {pMediator->RemoveDOMLink(browser, id); break; }
+		case(2): {pMediator->RemoveDOMSelectField(browser, id); break; }
+		case(3): {pMediator->RemoveDOMOverflowElement(browser, id); break; }
+		case(4): {pMediator->RemoveDOMVideo(browser, id); break; }
+		case(5): {pMediator->RemoveDOMCheckbox(browser, id); break; }
+		default: {
+			LogError("MsgRouter: Removing DOMNode - Unknown type of DOMNode! type=", type);
+		}
+	}
+}
+
+// Update attribute of node object in corresponding Tab object with data encoded as string
+static void UpdateDOMNode(Mediator* pMediator, CefRefPtr<CefBrowser> browser, int type, int id, DOMAttribute attr, const std::string& rAttrData)
+{
+	std::weak_ptr<DOMNode> target;
+	switch (type)
+	{
+		case(0): {target = pMediator->GetDOMTextInput(browser, id); break; }
+		case(1): {target = pMediator->GetDOMLink(browser, id); break; }
+		case(2): {target = pMediator->GetDOMSelectField(browser, id); break; }
+		case(3): {target = pMediator->GetDOMOverflowElement(browser, id); break; }
+		case(4): {target = pMediator->GetDOMVideo(browser, id); break; }
+		case(5): {target = pMediator->GetDOMCheckbox(browser, id); break; }
+		default: {
+			LogError("MsgRouter: Updating DOMNode - Unknown type of DOMNode! type=", type);
+		}
+	}
+
+	// Perform node update
+	bool success = false;
+	if (auto node = target.lock())
+	{
+		success = node->Update(
+			attr,
+			StringToCefListValue::ExtractAttributeData(attr, rAttrData)
+		);
+	}
+	else
+	{
+		LogError("MsgRouter: Failed to update node with type: ", type, " and id: ", id, " stored in"\
+			" Tab with id: ", browser->GetIdentifier(), ")");
+		return;
+	}
+
+	if (!success)
+	{
+		LogError("MsgRouter: Update failed! Node type: ", type, ", node id: ", id,
+			", DOMAttribute: ", DOMAttrToString(attr));
+	}
+}
+
+void DOMMessageStatistics::Count(int deltaCount)
+{
+	_messageCount++;
+	_deltaCount += deltaCount;
+
+	// Log rates once per second
+	const auto now = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(now - _begin).count();
+	if (seconds >= 1.0)
+	{
+		LogDebug("MsgRouter: DOM node messages per second: ", _messageCount / seconds, ", deltas per second: ", _deltaCount / seconds);
+		_messageCount = 0;
+		_deltaCount = 0;
+		_begin = now;
+	}
+}
+
 MessageRouter::MessageRouter(Mediator* pMediator)
 {
 	// Store pointer to mediator
@@ -22,11 +130,50 @@ MessageRouter::MessageRouter(Mediator* pMediator)
 	config.js_cancel_function = "cefQueryCancel";
 	_router = CefMessageRouterBrowserSide::Create(config);
 
+	// Statistics about DOM node messages, shared with default handler
+	_spDOMStatistics = std::make_shared<DOMMessageStatistics>();
+
 	// Add the default handler for messages to the delegated router
-	CefMessageRouterBrowserSide::Handler* defaultHandler = new DefaultMsgHandler(_pMediator);
+	CefMessageRouterBrowserSide::Handler* defaultHandler = new DefaultMsgHandler(_pMediator, _spDOMStatistics);
 	_router->AddHandler(defaultHandler, true);
 }
 
+void MessageRouter::ReceiveDOMDeltas(CefRefPtr<CefBrowser> browser, CefRefPtr<CefProcessMessage> msg)
+{
+	const auto args = msg->GetArgumentList();
+	const int deltaCount = (int)args->GetSize() / DOM_DELTA_FIELD_COUNT;
+	_spDOMStatistics->Count(deltaCount);
+
+	// Apply deltas in order of their creation
+	for (int i = 0; i < deltaCount; i++)
+	{
+		const int offset = i * DOM_DELTA_FIELD_COUNT;
+		const int type = args->GetInt(offset + 1);
+		const int id = args->GetInt(offset + 2);
+		switch (args->GetInt(offset))
+		{
+		case DOM_DELTA_ADD:
+			AddDOMNode(_pMediator, browser, type, id);
+			break;
+		case DOM_DELTA_REMOVE:
+			RemoveDOMNode(_pMediator, browser, type, id);
+			break;
+		case DOM_DELTA_UPDATE:
+			try
+			{
+				UpdateDOMNode(_pMediator, browser, type, id, (DOMAttribute)args->GetInt(offset + 3), args->GetString(offset + 4).ToString());
+			}
+			catch (const std::exception& e)
+			{
+				LogError("MsgRouter: Failed to decode data of DOM node update, type: ", type, ", id: ", id, ", exception: ", e.what());
+			}
+			break;
+		default:
+			LogError("MsgRouter: Unknown DOM delta operation: ", args->GetInt(offset));
+		}
+	}
+}
+
 bool DefaultMsgHandler::OnQuery(CefRefPtr<CefBrowser> browser,
 	CefRefPtr<CefFrame> frame,
 	int64 query_id,
@@ -251,101 +398,29 @@ bool DefaultMsgHandler::OnQuery(CefRefPtr<CefBrowser> browser,
 			// ADDING DOMNODE
 			if (op.compare("add") == 0) // adding of DOM node
 			{
-				// Create blank node object in corresponding Tab object
-				switch (type)
-				{
-					case(0): {_pMediator->AddDOMTextInput(browser, id); break; }
-					case(1): {_pMediator->AddDOMLink(browser, id); break; }
-					case(2): {_pMediator->AddDOMSelectField(browser, id); break; }
-					case(3): {_pMediator->AddDOMOverflowElement(browser, id); break; }
-					case(4): {_pMediator->AddDOMVideo(browser, id); break; }
-					case(5): {_pMediator->AddDOMCheckbox(browser, id); break; }
-					default: {
-						LogError("MsgRouter: Adding DOMNode - Unknown type of DOMNode! type=", type);
-					}
-				}
-
-				// TODO: This could be done in DOMExtraction
-				const std::vector<std::string> names = { "TextInput", "Link", "SelectField", "OverflowElement", "Video", "Checkbox" };
-				if (type >= names.size() || type < 0)
-				{
-					LogError("MsgRouter: - ERROR: Unknown numeric DOM node type value: ", type);
-					return true;
-				}
-				const std::string& ipcName = names[type];
-
-				// Instruct Renderer Process to initialize empty DOM Nodes with data
-				// TODO: Move this to DOM node constructor?
-				CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("LoadDOM" + ipcName + "Data");
-				msg->GetArgumentList()->SetInt(0, type);
-				msg->GetArgumentList()->SetInt(1, id);
-				browser->SendProcessMessage(PID_RENDERER, msg);
+				_spStatistics->Count(1);
+				AddDOMNode(_pMediator, browser, type, id);
 			}
 
 			// REMOVE DOMNODE
 			if (op.compare("rem") == 0)
 			{
-
-				switch (type)
-				{
-					case(0): {_pMediator->RemoveDOMTextInput(browser, id); break; }
-					case(1): {_pMediator->RemoveDOMLink(browser, id); break; }
-					case(2): {_pMediator->RemoveDOMSelectField(browser, id); break; }
-					case(3) : {_pMediator->RemoveDOMOverflowElement(browser, id); break; }
-					case(4): {_pMediator->RemoveDOMVideo(browser, id); break; }
-					case(5): {_pMediator->RemoveDOMCheckbox(browser, id); break; }
-					default: {
-						LogError("MsgRouter: Removing DOMNode - Unknown type of DOMNode! type=", type);
-					}
-				}
+				_spStatistics->Count(1);
+				RemoveDOMNode(_pMediator, browser, type, id);
 			}
 
 			// UPDATE DOMNODE
 			if (op.compare("upd") == 0)
 			{
-				std::weak_ptr<DOMNode> target;
-				switch (type)
-				{
-					case(0): {target = _pMediator->GetDOMTextInput(browser, id); break; }
-					case(1): {target = _pMediator->GetDOMLink(browser, id); break; }
-					case(2): {target = _pMediator->GetDOMSelectField(browser, id); break; }
-					case(3): {target = _pMediator->GetDOMOverflowElement(browser, id); break; }
-					case(4): {target = _pMediator->GetDOMVideo(browser, id); break; }
-					case(5): {target = _pMediator->GetDOMCheckbox(browser, id); break; }
-					default: {
-						LogError("MsgRouter: Updating DOMNode - Unknown type of DOMNode! type=", type);
-					}
-				}
-
+				_spStatistics->Count(1);
 				if (data.size() > 5)
 				{
 					// See DOMAttribute.h enum DOMAttribute for numeric interpretation
 					const DOMAttribute& attr = (DOMAttribute) std::stoi(data[4]);
 					const std::string& attrData = data[5];
 
-
 					// Perform node update
-					bool success = false;
-					if (auto node = target.lock())
-					{
-						success = node->Update(
-							(DOMAttribute) attr,
-							StringToCefListValue::ExtractAttributeData((DOMAttribute) attr, attrData)
-						);
-					}
-					else
-					{
-						LogError("MsgRouter: Failed to update node with type: ", type, " and id: ", id, " stored in"\
-							" Tab with id: ", browser->GetIdentifier(), ")");
-						return true;
-					}
-					
-					if (!success)
-					{
-						LogError("MsgRouter: Update failed! Node type: ", type, ", node id: ", id, 
-							", DOMAttribute: ", DOMAttrToString(attr));
-					}
-
+					UpdateDOMNode(_pMediator, browser, type, id, attr, attrData);
 				}
 				else
 				{
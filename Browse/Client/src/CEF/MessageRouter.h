@@ -13,16 +13,38 @@
 #include "include/wrapper/cef_message_router.h"
 #include "include/cef_base.h"
 #include <functional>
+#include <memory>
+#include <chrono>
 
 class Mediator; // Forward declaration
 
+// Counts messages with DOM node changes received from Render Process and logs their rates
+class DOMMessageStatistics
+{
+public:
+
+	// Count one received message, carrying given count of deltas
+	void Count(int deltaCount);
+
+private:
+
+	// Members
+	int _messageCount = 0;
+	int _deltaCount = 0;
+	std::chrono::steady_clock::time_point _begin = std::chrono::steady_clock::now();
+};
+
 // Default handler for messages
 class DefaultMsgHandler : public CefMessageRouterBrowserSide::Handler
 {
 public:
 
 	// Constructor
-	DefaultMsgHandler(Mediator* pMediator) { _pMediator = pMediator; }
+	DefaultMsgHandler(Mediator* pMediator, std::shared_ptr<DOMMessageStatistics> spStatistics)
+	{
+		_pMediator = pMediator;
+		_spStatistics = spStatistics;
+	}
 
 	// Called when |cefQuery| was called in JavaScript
 	virtual bool OnQuery(CefRefPtr<CefBrowser> browser,
@@ -36,6 +58,9 @@ private:
 
 	// Pointer to mediator (TODO: some extra interface?)
 	Mediator* _pMediator;
+
+	// Statistics about DOM node messages
+	std::shared_ptr<DOMMessageStatistics> _spStatistics;
 };
 
 // Callback handler
@@ -100,6 +125,9 @@ public:
 	{
 		return _router->OnProcessMessageReceived(browser, source_process, message);
 	}
+	// Apply batch of DOM node changes sent by Render Process in a single message
+	void ReceiveDOMDeltas(CefRefPtr<CefBrowser> browser, CefRefPtr<CefProcessMessage> msg);
+
 	// Redirect OnRenderProcessTerminated
 	void OnRenderProcessTerminated(CefRefPtr<CefBrowser> browser) const
 	{
@@ -114,6 +142,9 @@ private:
 	// Pointer to mediator. TODO: replace with some interface with less power and more control?
 	Mediator* _pMediator;
 
+	// Statistics about DOM node messages
+	std::shared_ptr<DOMMessageStatistics> _spDOMStatistics;
+
 	IMPLEMENT_REFCOUNTING(MessageRouter);
 };
 
@@ -0,0 +1,52 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "DOMDeltaV8Handler.h"
+#include "src/CEF/Data/DOMDelta.h"
+
+bool DOMDeltaV8Handler::Execute(
+	const CefString& name,
+	CefRefPtr<CefV8Value> object,
+	const CefV8ValueList& arguments,
+	CefRefPtr<CefV8Value>& retval,
+	CefString& exception)
+{
+	if (name != DOM_DELTA_JS_FUNCTION_NAME)
+	{
+		return false;
+	}
+
+	// Expect flat array of deltas
+	if (arguments.size() < 1 || !arguments[0]->IsArray())
+	{
+		exception = "Expected array of DOM deltas";
+		return true;
+	}
+	CefRefPtr<CefV8Value> deltas = arguments[0];
+	const int length = deltas->GetArrayLength() - (deltas->GetArrayLength() % DOM_DELTA_FIELD_COUNT);
+
+	// Copy deltas into arguments of message
+	CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create(DOM_DELTA_MESSAGE_NAME);
+	CefRefPtr<CefListValue> args = msg->GetArgumentList();
+	args->SetSize(length);
+	for (int i = 0; i < length; i += DOM_DELTA_FIELD_COUNT)
+	{
+		args->SetInt(i, deltas->GetValue(i)->GetIntValue()); // operation
+		args->SetInt(i + 1, deltas->GetValue(i + 1)->GetIntValue()); // node type
+		args->SetInt(i + 2, deltas->GetValue(i + 2)->GetIntValue()); // node id
+		args->SetInt(i + 3, deltas->GetValue(i + 3)->GetIntValue()); // attribute
+		CefRefPtr<CefV8Value> data = deltas->GetValue(i + 4);
+		args->SetString(i + 4, data->IsString() ? data->GetStringValue() : CefString()); // attribute data
+	}
+
+	// Send one message for all deltas
+	if (length > 0)
+	{
+		CefV8Context::GetCurrentContext()->GetBrowser()->SendProcessMessage(PID_BROWSER, msg);
+	}
+
+	retval = CefV8Value::CreateInt(length / DOM_DELTA_FIELD_COUNT);
+	return true;
+}
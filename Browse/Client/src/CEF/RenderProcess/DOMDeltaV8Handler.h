@@ -0,0 +1,32 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Native JavaScript function which receives batched DOM node changes of one
+// animation frame and forwards them in a single IPC message to the Main
+// Process. See DOMDelta.h for the format.
+
+#ifndef CEF_DOMDELTAV8HANDLER_H_
+#define CEF_DOMDELTAV8HANDLER_H_
+
+#include "include/cef_v8.h"
+
+class DOMDeltaV8Handler : public CefV8Handler
+{
+public:
+
+	// Called when function is executed in JavaScript
+	virtual bool Execute(
+		const CefString& name,
+		CefRefPtr<CefV8Value> object,
+		const CefV8ValueList& arguments,
+		CefRefPtr<CefV8Value>& retval,
+		CefString& exception) OVERRIDE;
+
+private:
+
+	// Include CEF'S default reference counting implementation
+	IMPLEMENT_REFCOUNTING(DOMDeltaV8Handler);
+};
+
+#endif // CEF_DOMDELTAV8HANDLER_H_
@@ -11,6 +11,9 @@
 
 #include "src/CEF/Data/DOMExtraction.h"
 #include "src/CEF/Data/DOMNode.h"		// TODO: Move descriptions to DOMExtraction to not need to include this header?
+#include "src/CEF/Data/DOMDelta.h"
+#include "src/CEF/RenderProcess/DOMDeltaV8Handler.h"
+#include "src/Setup.h"
 
 RenderProcessHandler::RenderProcessHandler()
 {
@@ -384,6 +387,15 @@ void RenderProcessHandler::OnContextCreated(
             globalObj->SetValue("favIconHeight", CefV8Value::CreateInt(-1), V8_PROPERTY_ATTRIBUTE_NONE);
             globalObj->SetValue("favIconWidth", CefV8Value::CreateInt(-1), V8_PROPERTY_ATTRIBUTE_NONE);
 
+			// Native function to send DOM node changes batched per animation frame. Without it, JavaScript sends each change on its own
+			if (setup::DOM_DELTA_BATCHING)
+			{
+				globalObj->SetValue(
+					DOM_DELTA_JS_FUNCTION_NAME,
+					CefV8Value::CreateFunction(DOM_DELTA_JS_FUNCTION_NAME, new DOMDeltaV8Handler()),
+					V8_PROPERTY_ATTRIBUTE_READONLY);
+			}
+
 			// Inject Javascript code which extends the current page's context by our methods
 			// and automatically creates a MutationObserver instance
 			for (const auto& dom_code : _js_dom_code)
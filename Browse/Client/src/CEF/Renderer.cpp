@@ -8,6 +8,8 @@
 #include "src/CEF/Mediator.h"
 #include "src/Utils/Texture.h"
 #include "src/Utils/Logger.h"
+#include "src/Singletons/FrameTap.h"
+#include "src/Setup.h"
 #include "include/wrapper/cef_helpers.h"
 
 Renderer::Renderer(Mediator* pMediator)
@@ -35,28 +37,66 @@ void Renderer::OnPaint(
     int width,
     int height)
 {
-    // Look up corresponding texture
-    if (auto spTexture = _mediator->GetTexture(browser).lock())
+    // Collect dirty regions and their area
+    std::vector<glm::ivec4> regions;
+    regions.reserve(dirtyRects.size());
+    long long dirtyArea = 0;
+    for (const auto& rRect : dirtyRects)
     {
-        // Fill texture with rendered website
-        spTexture->Fill(width, height, GL_BGRA, (const unsigned char*) buffer);
-
-
-		// TESTING
-		//if (dirtyRects.size() > 0)
-		//	LogDebug("*** Dirty rects: ***");
-
-		//for (const auto& rect : dirtyRects)
-		//{
-		//	LogDebug(rect.width, " x ", rect.height, " - ", rect.x, ", ", rect.y);
-
-		//	spTexture->drawRectangle(rect.width, rect.height, rect.x, rect.y);
-		//}
+        regions.push_back(glm::ivec4(rRect.x, rRect.y, rRect.width, rRect.height));
+        dirtyArea += (long long)rRect.width * (long long)rRect.height;
+    }
 
+    // Tabs in background only keep latest paint, which is uploaded when they are shown
+    if (setup::WEB_VIEW_DEFER_BACKGROUND_PAINTS && type == PET_VIEW && !_mediator->IsShown(browser))
+    {
+        DeferredPaint& rPaint = _deferredPaints[browser->GetIdentifier()];
+        if (rPaint.pending)
+        {
+            rPaint.skippedUploads++;
+        }
+        const unsigned char* pBuffer = (const unsigned char*) buffer;
+        rPaint.pixels.assign(pBuffer, pBuffer + ((size_t)width * (size_t)height * 4));
+        rPaint.width = width;
+        rPaint.height = height;
+        rPaint.pending = true;
     }
     else
     {
-        LogDebug("Renderer: OnPaint couldn't fill texture...");
+        // Deferred paint is outdated, but texture misses its content outside of dirty regions
+        bool completeUpload = false;
+        auto iter = _deferredPaints.find(browser->GetIdentifier());
+        if (iter != _deferredPaints.end() && iter->second.pending)
+        {
+            iter->second.skippedUploads++;
+            iter->second.pending = false;
+            std::vector<unsigned char>().swap(iter->second.pixels);
+            completeUpload = true;
+        }
+
+        // Look up corresponding texture
+        if (auto spTexture = _mediator->GetTexture(browser).lock())
+        {
+            // Fill texture with rendered website, only dirty regions if they do not cover most of it
+            if (completeUpload || regions.empty() || (double)dirtyArea > setup::DIRTY_RECTS_MAX_AREA_RATIO * (double)width * (double)height)
+            {
+                spTexture->Fill(width, height, GL_BGRA, (const unsigned char*) buffer);
+            }
+            else
+            {
+                spTexture->FillRegions(width, height, GL_BGRA, (const unsigned char*) buffer, regions);
+            }
+        }
+        else
+        {
+            LogDebug("Renderer: OnPaint couldn't fill texture...");
+        }
+    }
+
+    // Share pixels with consumers on the CPU, as buffer is only valid during this call
+    if (type == PET_VIEW)
+    {
+        FrameTap::instance().Publish(browser->GetIdentifier(), width, height, (const unsigned char*) buffer, regions, _mediator->IsShown(browser));
     }
 }
 
@@ -65,3 +105,46 @@ void Renderer::OnScrollOffsetChanged(CefRefPtr<CefBrowser> browser, double x, do
     // Call Mediator to set offset in corresponding Tab
     _mediator->OnScrollOffsetChanged(browser, x, y);
 }
+
+void Renderer::FlushDeferredPaint(CefRefPtr<CefBrowser> browser)
+{
+    auto iter = _deferredPaints.find(browser->GetIdentifier());
+    if (iter == _deferredPaints.end() || !iter->second.pending)
+    {
+        return;
+    }
+
+    // Upload latest paint completely, memory is released as tab is shown now
+    DeferredPaint& rPaint = iter->second;
+    if (auto spTexture = _mediator->GetTexture(browser).lock())
+    {
+        spTexture->Fill(rPaint.width, rPaint.height, GL_BGRA, rPaint.pixels.data());
+    }
+    rPaint.pending = false;
+    std::vector<unsigned char>().swap(rPaint.pixels);
+}
+
+void Renderer::DiscardDeferredPaint(CefRefPtr<CefBrowser> browser)
+{
+    _deferredPaints.erase(browser->GetIdentifier());
+}
+
+unsigned int Renderer::GetSkippedUploadCount(CefRefPtr<CefBrowser> browser) const
+{
+    auto iter = _deferredPaints.find(browser->GetIdentifier());
+    if (iter != _deferredPaints.end())
+    {
+        return iter->second.skippedUploads;
+    }
+    return 0;
+}
+
+size_t Renderer::GetDeferredPaintBytes(CefRefPtr<CefBrowser> browser) const
+{
+    auto iter = _deferredPaints.find(browser->GetIdentifier());
+    if (iter != _deferredPaints.end())
+    {
+        return iter->second.pixels.capacity();
+    }
+    return 0;
+}
@@ -11,6 +11,8 @@
 
 #include "include/cef_client.h"
 #include "include/cef_render_handler.h"
+#include <map>
+#include <vector>
 
 // Forward declaration
 class Texture;
@@ -39,10 +41,33 @@ public:
     // Called when scrolling offset changes
     void OnScrollOffsetChanged(CefRefPtr<CefBrowser> browser, double x, double y) OVERRIDE;
 
+    // Upload deferred paint of browser into its texture, called when tab is shown
+    void FlushDeferredPaint(CefRefPtr<CefBrowser> browser);
+
+    // Forget deferred paint of browser, called when browser is closed or its tab hibernates
+    void DiscardDeferredPaint(CefRefPtr<CefBrowser> browser);
+
+    // Count of paints of browser which were replaced by later ones before being uploaded
+    unsigned int GetSkippedUploadCount(CefRefPtr<CefBrowser> browser) const;
+
+    // Bytes held by deferred paint of browser
+    size_t GetDeferredPaintBytes(CefRefPtr<CefBrowser> browser) const;
+
 private:
 
+    // Latest paint of browser in background, kept until its tab is shown
+    struct DeferredPaint
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels; // BGRA
+        bool pending = false;
+        unsigned int skippedUploads = 0;
+    };
+
     // Members
     Mediator* _mediator;
+    std::map<int, DeferredPaint> _deferredPaints; // by browser id
 
     // Include CEF'S default reference counting implementation
     IMPLEMENT_REFCOUNTING(Renderer);
@@ -6,2379 +6,12 @@
 
 #include "src/CEF/RequestHandler.h"
 #include "src/Utils/Logger.h"
-#include <regex>
+#include "src/ContentPath.h"
 
-// TODO: load directly from internet or at least from file
-// Taken from https://pgl.yoyo.org/as/
-const std::vector<std::string> adURLs =
+RequestHandler::RequestHandler() : _adBlockList(RUNTIME_CONTENT_PATH + "/adblocking/hosts.txt")
 {
-	"101com.com",
-	"101order.com",
-	"123found.com",
-	"180hits.de",
-	"180searchassistant.com",
-	"1x1rank.com",
-	"207.net",
-	"247media.com",
-	"24log.com",
-	"24log.de",
-	"24pm-affiliation.com",
-	"2mdn.net",
-	"2o7.net",
-	"360yield.com",
-	"4affiliate.net",
-	"4d5.net",
-	"50websads.com",
-	"518ad.com",
-	"51yes.com",
-	"600z.com",
-	"777partner.com",
-	"77tracking.com",
-	"7bpeople.com",
-	"7search.com",
-	"99count.com",
-	"a-ads.com",
-	"a-counter.kiev.ua",
-	"a.0day.kiev.ua",
-	"a.aproductmsg.com",
-	"a.collective-media.net",
-	"a.consumer.net",
-	"a.mktw.net",
-	"a.sakh.com",
-	"a.ucoz.net",
-	"a.ucoz.ru",
-	"a.xanga.com",
-	"a32.g.a.yimg.com",
-	"aaddzz.com",
-	"abacho.net",
-	"abc-ads.com",
-	"absoluteclickscom.com",
-	"abz.com",
-	"ac.rnm.ca",
-	"accounts.pkr.com.invalid",
-	"acsseo.com",
-	"actionsplash.com",
-	"actualdeals.com",
-	"acuityads.com",
-	"ad-balancer.at",
-	"ad-balancer.net",
-	"ad-center.com",
-	"ad-images.suntimes.com",
-	"ad-pay.de",
-	"ad-rotator.com",
-	"ad-server.gulasidorna.se",
-	"ad-serverparc.nl",
-	"ad-souk.com",
-	"ad-space.net",
-	"ad-tech.com",
-	"ad-up.com",
-	"ad.100.tbn.ru",
-	"ad.71i.de",
-	"ad.980x.com",
-	"ad.a8.net",
-	"ad.abcnews.com",
-	"ad.abctv.com",
-	"ad.about.com",
-	"ad.aboutwebservices.com",
-	"ad.abum.com",
-	"ad.afy11.net",
-	"ad.allstar.cz",
-	"ad.altervista.org",
-	"ad.amgdgt.com",
-	"ad.anuntis.com",
-	"ad.auditude.com",
-	"ad.bizo.com",
-	"ad.bnmla.com",
-	"ad.bondage.com",
-	"ad.caradisiac.com",
-	"ad.centrum.cz",
-	"ad.cgi.cz",
-	"ad.choiceradio.com",
-	"ad.clix.pt",
-	"ad.cooks.com",
-	"ad.crwdcntrl.net",
-	"ad.digitallook.com",
-	"ad.directrev.com",
-	"ad.doctissimo.fr",
-	"ad.domainfactory.de",
-	"ad.e-kolay.net",
-	"ad.eurosport.com",
-	"ad.f1cd.ru",
-	"ad.flurry.com",
-	"ad.foxnetworks.com",
-	"ad.freecity.de",
-	"ad.gate24.ch",
-	"ad.globe7.com",
-	"ad.grafika.cz",
-	"ad.hbv.de",
-	"ad.hodomobile.com",
-	"ad.httpool.com",
-	"ad.hyena.cz",
-	"ad.iinfo.cz",
-	"ad.ilove.ch",
-	"ad.infoseek.com",
-	"ad.jamba.net",
-	"ad.jamster.co.uk",
-	"ad.jetsoftware.com",
-	"ad.keenspace.com",
-	"ad.leadbolt.net",
-	"ad.liveinternet.ru",
-	"ad.lupa.cz",
-	"ad.m5prod.net",
-	"ad.media-servers.net",
-	"ad.mediastorm.hu",
-	"ad.mgd.de",
-	"ad.musicmatch.com",
-	"ad.nachtagenten.de",
-	"ad.nozonedata.com",
-	"ad.nttnavi.co.jp",
-	"ad.nwt.cz",
-	"ad.onad.eu",
-	"ad.pandora.tv",
-	"ad.preferances.com",
-	"ad.profiwin.de",
-	"ad.prv.pl",
-	"ad.rambler.ru",
-	"ad.reunion.com",
-	"ad.scanmedios.com",
-	"ad.sensismediasmart.com.au",
-	"ad.seznam.cz",
-	"ad.simgames.net",
-	"ad.slutload.com",
-	"ad.smartclip.net",
-	"ad.tbn.ru",
-	"ad.technoratimedia.com",
-	"ad.thewheelof.com",
-	"ad.turn.com",
-	"ad.tv2.no",
-	"ad.twitchguru.com",
-	"ad.usatoday.com",
-	"ad.virtual-nights.com",
-	"ad.watch.impress.co.jp",
-	"ad.wavu.hu",
-	"ad.way.cz",
-	"ad.weatherbug.com",
-	"ad.wsod.com",
-	"ad.wz.cz",
-	"ad.yadro.ru",
-	"ad.yourmedia.com",
-	"ad.zanox.com",
-	"ad0.bigmir.net",
-	"ad01.mediacorpsingapore.com",
-	"ad1.emediate.dk",
-	"ad1.emule-project.org",
-	"ad1.kde.cz",
-	"ad1.pamedia.com.au",
-	"ad2.iinfo.cz",
-	"ad2.ip.ro",
-	"ad2.linxcz.cz",
-	"ad2.lupa.cz",
-	"ad2flash.com",
-	"ad2games.com",
-	"ad3.iinfo.cz",
-	"ad3.pamedia.com.au",
-	"ad4game.com",
-	"adaction.de",
-	"adadvisor.net",
-	"adap.tv",
-	"adapt.tv",
-	"adbanner.ro",
-	"adbard.net",
-	"adbers.com",
-	"adblade.com",
-	"adblockanalytics.com",
-	"adboost.de.vu",
-	"adboost.net",
-	"adbooth.net",
-	"adbot.com",
-	"adbrite.com",
-	"adbroker.de",
-	"adbunker.com",
-	"adbutler.com",
-	"adbutler.de",
-	"adbuyer.com",
-	"adbuyer3.lycos.com",
-	"adcash.com",
-	"adcast.deviantart.com",
-	"adcell.de",
-	"adcenter.mdf.se",
-	"adcenter.net",
-	"adcentriconline.com",
-	"adcept.net",
-	"adclick.com",
-	"adclient.uimserv.net",
-	"adclient1.tucows.com",
-	"adcomplete.com",
-	"adconion.com",
-	"adcontent.gamespy.com",
-	"adcycle.com",
-	"add.newmedia.cz",
-	"addealing.com",
-	"addesktop.com",
-	"addfreestats.com",
-	"addme.com",
-	"adecn.com",
-	"ademails.com",
-	"adengage.com",
-	"adexpose.com",
-	"adext.inkclub.com",
-	"adf.ly",
-	"adfactor.nl",
-	"adfarm.mediaplex.com",
-	"adflight.com",
-	"adforce.com",
-	"adform.com",
-	"adgardener.com",
-	"adgoto.com",
-	"adgridwork.com",
-	"adhese.be",
-	"adhese.com",
-	"adimage.asiaone.com.sg",
-	"adimage.guardian.co.uk",
-	"adimages.been.com",
-	"adimages.carsoup.com",
-	"adimages.go.com",
-	"adimages.homestore.com",
-	"adimages.omroepzeeland.nl",
-	"adimages.sanomawsoy.fi",
-	"adimg.cnet.com",
-	"adimg.com.com",
-	"adimg.uimserv.net",
-	"adimg1.chosun.com",
-	"adimgs.sapo.pt",
-	"adimpact.com",
-	"adinjector.net",
-	"adinterax.com",
-	"adisfy.com",
-	"adition.com",
-	"adition.de",
-	"adition.net",
-	"adizio.com",
-	"adjix.com",
-	"adjug.com",
-	"adjuggler.com",
-	"adjuggler.yourdictionary.com",
-	"adjustnetwork.com",
-	"adk2.com",
-	"adk2ads.tictacti.com",
-	"adland.ru",
-	"adlantic.nl",
-	"adledge.com",
-	"adlegend.com",
-	"adlog.com.com",
-	"adloox.com",
-	"adlooxtracking.com",
-	"adlure.net",
-	"admagnet.net",
-	"admailtiser.com",
-	"adman.gr",
-	"adman.in.gr",
-	"adman.otenet.gr",
-	"admanagement.ch",
-	"admanager.btopenworld.com",
-	"admanager.carsoup.com",
-	"admarketplace.net",
-	"admarvel.com",
-	"admax.nexage.com",
-	"admedia.com",
-	"admedia.ro",
-	"admeld.com",
-	"admerize.be",
-	"admeta.com",
-	"admex.com",
-	"adminder.com",
-	"adminshop.com",
-	"admized.com",
-	"admob.com",
-	"admonitor.com",
-	"admotion.com.ar",
-	"adnet-media.net",
-	"adnet.asahi.com",
-	"adnet.biz",
-	"adnet.de",
-	"adnet.ru",
-	"adnet.worldreviewer.com",
-	"adnetinteractive.com",
-	"adnetwork.net",
-	"adnetworkperformance.com",
-	"adnews.maddog2000.de",
-	"adnotch.com",
-	"adnxs.com",
-	"adocean.pl",
-	"adonspot.com",
-	"adoperator.com",
-	"adorigin.com",
-	"adpepper.dk",
-	"adpepper.nl",
-	"adperium.com",
-	"adpia.vn",
-	"adplus.co.id",
-	"adplxmd.com",
-	"adprofile.net",
-	"adprojekt.pl",
-	"adq.nextag.com",
-	"adrazzi.com",
-	"adreactor.com",
-	"adrecreate.com",
-	"adremedy.com",
-	"adreporting.com",
-	"adres.internet.com",
-	"adrevolver.com",
-	"adriver.ru",
-	"adrolays.de",
-	"adrotate.de",
-	"adrotator.se",
-	"adrta.com",
-	"ads-click.com",
-	"ads.4tube.com",
-	"ads.5ci.lt",
-	"ads.abovetopsecret.com",
-	"ads.aceweb.net",
-	"ads.activestate.com",
-	"ads.adfox.ru",
-	"ads.administrator.de",
-	"ads.adshareware.net",
-	"ads.adultfriendfinder.com",
-	"ads.adultswim.com",
-	"ads.advance.net",
-	"ads.adverline.com",
-	"ads.affiliates.match.com",
-	"ads.ak.facebook.com.edgesuite.net",
-	"ads.allvatar.com",
-	"ads.alt.com",
-	"ads.amdmb.com",
-	"ads.amigos.com",
-	"ads.aol.co.uk",
-	"ads.aol.com",
-	"ads.apn.co.nz",
-	"ads.appsgeyser.com",
-	"ads.as4x.tmcs.net",
-	"ads.as4x.tmcs.ticketmaster.com",
-	"ads.asia1.com.sg",
-	"ads.asiafriendfinder.com",
-	"ads.ask.com",
-	"ads.aspalliance.com",
-	"ads.avazu.net",
-	"ads.batpmturner.com",
-	"ads.beenetworks.net",
-	"ads.belointeractive.com",
-	"ads.berlinonline.de",
-	"ads.betanews.com",
-	"ads.betfair.com",
-	"ads.betfair.com.au",
-	"ads.bigchurch.com",
-	"ads.bigfoot.com",
-	"ads.bing.com",
-	"ads.bittorrent.com",
-	"ads.blog.com",
-	"ads.bloomberg.com",
-	"ads.bluelithium.com",
-	"ads.bluemountain.com",
-	"ads.bluesq.com",
-	"ads.bonniercorp.com",
-	"ads.boylesports.com",
-	"ads.brabys.com",
-	"ads.brazzers.com",
-	"ads.bumq.com",
-	"ads.businessweek.com",
-	"ads.canalblog.com",
-	"ads.canoe.ca",
-	"ads.casinocity.com",
-	"ads.cbc.ca",
-	"ads.cc",
-	"ads.cc-dt.com",
-	"ads.centraliprom.com",
-	"ads.cgnetworks.com",
-	"ads.channel4.com",
-	"ads.cimedia.com",
-	"ads.clearchannel.com",
-	"ads.co.com",
-	"ads.com.com",
-	"ads.contactmusic.com",
-	"ads.contentabc.com",
-	"ads.contextweb.com",
-	"ads.crakmedia.com",
-	"ads.creative-serving.com",
-	"ads.creativematch.com",
-	"ads.cricbuzz.com",
-	"ads.cybersales.cz",
-	"ads.dada.it",
-	"ads.datinggold.com",
-	"ads.datingyes.com",
-	"ads.dazoot.ro",
-	"ads.deltha.hu",
-	"ads.dennisnet.co.uk",
-	"ads.desmoinesregister.com",
-	"ads.detelefoongids.nl",
-	"ads.deviantart.com",
-	"ads.digital-digest.com",
-	"ads.digitalmedianet.com",
-	"ads.digitalpoint.com",
-	"ads.directionsmag.com",
-	"ads.domeus.com",
-	"ads.eagletribune.com",
-	"ads.easy-forex.com",
-	"ads.eatinparis.com",
-	"ads.economist.com",
-	"ads.edbindex.dk",
-	"ads.egrana.com.br",
-	"ads.einmedia.com",
-	"ads.electrocelt.com",
-	"ads.elitetrader.com",
-	"ads.emirates.net.ae",
-	"ads.epltalk.com",
-	"ads.eu.msn.com",
-	"ads.exactdrive.com",
-	"ads.expat-blog.biz",
-	"ads.expedia.com",
-	"ads.ezboard.com",
-	"ads.factorymedia.com",
-	"ads.fairfax.com.au",
-	"ads.faxo.com",
-	"ads.ferianc.com",
-	"ads.filmup.com",
-	"ads.financialcontent.com",
-	"ads.flooble.com",
-	"ads.fool.com",
-	"ads.footymad.net",
-	"ads.forbes.com",
-	"ads.forbes.net",
-	"ads.forium.de",
-	"ads.fortunecity.com",
-	"ads.fotosidan.se",
-	"ads.foxkidseurope.net",
-	"ads.foxnetworks.com",
-	"ads.foxnews.com",
-	"ads.freecity.de",
-	"ads.friendfinder.com",
-	"ads.ft.com",
-	"ads.futurenet.com",
-	"ads.gamecity.net",
-	"ads.gamershell.com",
-	"ads.gamespyid.com",
-	"ads.gamigo.de",
-	"ads.gaming-universe.de",
-	"ads.gawker.com",
-	"ads.geekswithblogs.net",
-	"ads.glispa.com",
-	"ads.globeandmail.com",
-	"ads.gmodules.com",
-	"ads.godlikeproductions.com",
-	"ads.goyk.com",
-	"ads.gplusmedia.com",
-	"ads.gradfinder.com",
-	"ads.grindinggears.com",
-	"ads.groundspeak.com",
-	"ads.gsm-exchange.com",
-	"ads.gsmexchange.com",
-	"ads.guardian.co.uk",
-	"ads.guardianunlimited.co.uk",
-	"ads.guru3d.com",
-	"ads.hardwaresecrets.com",
-	"ads.harpers.org",
-	"ads.hbv.de",
-	"ads.hearstmags.com",
-	"ads.heartlight.org",
-	"ads.heias.com",
-	"ads.hideyourarms.com",
-	"ads.hollywood.com",
-	"ads.horsehero.com",
-	"ads.horyzon-media.com",
-	"ads.iafrica.com",
-	"ads.ibest.com.br",
-	"ads.ibryte.com",
-	"ads.icq.com",
-	"ads.ign.com",
-	"ads.img.co.za",
-	"ads.imgur.com",
-	"ads.indiatimes.com",
-	"ads.infi.net",
-	"ads.internic.co.il",
-	"ads.ipowerweb.com",
-	"ads.isoftmarketing.com",
-	"ads.itv.com",
-	"ads.iwon.com",
-	"ads.jewishfriendfinder.com",
-	"ads.jiwire.com",
-	"ads.jobsite.co.uk",
-	"ads.jpost.com",
-	"ads.jubii.dk",
-	"ads.justhungry.com",
-	"ads.kaktuz.net",
-	"ads.kelbymediagroup.com",
-	"ads.kinobox.cz",
-	"ads.kinxxx.com",
-	"ads.kompass.com",
-	"ads.krawall.de",
-	"ads.lesbianpersonals.com",
-	"ads.linuxfoundation.org",
-	"ads.linuxjournal.com",
-	"ads.linuxsecurity.com",
-	"ads.livenation.com",
-	"ads.mariuana.it",
-	"ads.massinfra.nl",
-	"ads.mcafee.com",
-	"ads.mediaodyssey.com",
-	"ads.mediaturf.net",
-	"ads.medienhaus.de",
-	"ads.mgnetwork.com",
-	"ads.mmania.com",
-	"ads.moceanads.com",
-	"ads.motor-forum.nl",
-	"ads.motormedia.nl",
-	"ads.msn.com",
-	"ads.multimania.lycos.fr",
-	"ads.nationalgeographic.com",
-	"ads.ncm.com",
-	"ads.netclusive.de",
-	"ads.netmechanic.com",
-	"ads.networksolutions.com",
-	"ads.newdream.net",
-	"ads.newgrounds.com",
-	"ads.newmedia.cz",
-	"ads.newsint.co.uk",
-	"ads.newsquest.co.uk",
-	"ads.ninemsn.com.au",
-	"ads.nj.com",
-	"ads.nola.com",
-	"ads.nordichardware.com",
-	"ads.nordichardware.se",
-	"ads.nwsource.com",
-	"ads.nyi.net",
-	"ads.nytimes.com",
-	"ads.nyx.cz",
-	"ads.nzcity.co.nz",
-	"ads.o2.pl",
-	"ads.oddschecker.com",
-	"ads.okcimg.com",
-	"ads.ole.com",
-	"ads.olivebrandresponse.com",
-	"ads.oneplace.com",
-	"ads.ookla.com",
-	"ads.optusnet.com.au",
-	"ads.outpersonals.com",
-	"ads.passion.com",
-	"ads.pennet.com",
-	"ads.penny-arcade.com",
-	"ads.pheedo.com",
-	"ads.phpclasses.org",
-	"ads.pickmeup-ltd.com",
-	"ads.pkr.com",
-	"ads.planet.nl",
-	"ads.pni.com",
-	"ads.pof.com",
-	"ads.powweb.com",
-	"ads.primissima.it",
-	"ads.printscr.com",
-	"ads.prisacom.com",
-	"ads.program3.com",
-	"ads.psd2html.com",
-	"ads.pushplay.com",
-	"ads.quoka.de",
-	"ads.rcs.it",
-	"ads.recoletos.es",
-	"ads.rediff.com",
-	"ads.redlightcenter.com",
-	"ads.redtube.com",
-	"ads.resoom.de",
-	"ads.returnpath.net",
-	"ads.rpgdot.com",
-	"ads.s3.sitepoint.com",
-	"ads.satyamonline.com",
-	"ads.savannahnow.com",
-	"ads.saymedia.com",
-	"ads.scifi.com",
-	"ads.seniorfriendfinder.com",
-	"ads.servebom.com",
-	"ads.sexinyourcity.com",
-	"ads.shizmoo.com",
-	"ads.shopstyle.com",
-	"ads.sift.co.uk",
-	"ads.silverdisc.co.uk",
-	"ads.slim.com",
-	"ads.smartclick.com",
-	"ads.soft32.com",
-	"ads.space.com",
-	"ads.sptimes.com",
-	"ads.stackoverflow.com",
-	"ads.stationplay.com",
-	"ads.sun.com",
-	"ads.supplyframe.com",
-	"ads.t-online.de",
-	"ads.tahono.com",
-	"ads.techtv.com",
-	"ads.techweb.com",
-	"ads.telegraph.co.uk",
-	"ads.theglobeandmail.com",
-	"ads.themovienation.com",
-	"ads.thestar.com",
-	"ads.timeout.com",
-	"ads.tmcs.net",
-	"ads.totallyfreestuff.com",
-	"ads.townhall.com",
-	"ads.trinitymirror.co.uk",
-	"ads.tripod.com",
-	"ads.tripod.lycos.co.uk",
-	"ads.tripod.lycos.de",
-	"ads.tripod.lycos.es",
-	"ads.tripod.lycos.it",
-	"ads.tripod.lycos.nl",
-	"ads.tripod.spray.se",
-	"ads.tso.dennisnet.co.uk",
-	"ads.uknetguide.co.uk",
-	"ads.ultimate-guitar.com",
-	"ads.uncrate.com",
-	"ads.undertone.com",
-	"ads.usatoday.com",
-	"ads.v3.com",
-	"ads.verticalresponse.com",
-	"ads.vgchartz.com",
-	"ads.videosz.com",
-	"ads.virtual-nights.com",
-	"ads.virtualcountries.com",
-	"ads.vnumedia.com",
-	"ads.waps.cn",
-	"ads.wapx.cn",
-	"ads.weather.ca",
-	"ads.web.aol.com",
-	"ads.web.cs.com",
-	"ads.web.de",
-	"ads.webmasterpoint.org",
-	"ads.websiteservices.com",
-	"ads.whi.co.nz",
-	"ads.whoishostingthis.com",
-	"ads.wiezoekje.nl",
-	"ads.wikia.nocookie.net",
-	"ads.wineenthusiast.com",
-	"ads.wunderground.com",
-	"ads.wwe.biz",
-	"ads.xhamster.com",
-	"ads.xtra.co.nz",
-	"ads.y-0.net",
-	"ads.yimg.com",
-	"ads.yldmgrimg.net",
-	"ads.yourfreedvds.com",
-	"ads.youtube.com",
-	"ads.zdnet.com",
-	"ads.ztod.com",
-	"ads03.redtube.com",
-	"ads1.canoe.ca",
-	"ads1.mediacapital.pt",
-	"ads1.msn.com",
-	"ads1.rne.com",
-	"ads1.theglobeandmail.com",
-	"ads1.virtual-nights.com",
-	"ads10.speedbit.com",
-	"ads180.com",
-	"ads2.brazzers.com",
-	"ads2.clearchannel.com",
-	"ads2.contentabc.com",
-	"ads2.gamecity.net",
-	"ads2.jubii.dk",
-	"ads2.net-communities.co.uk",
-	"ads2.oneplace.com",
-	"ads2.rne.com",
-	"ads2.virtual-nights.com",
-	"ads2.xnet.cz",
-	"ads2004.treiberupdate.de",
-	"ads3.contentabc.com",
-	"ads3.gamecity.net",
-	"ads3.virtual-nights.com",
-	"ads4.clearchannel.com",
-	"ads4.gamecity.net",
-	"ads4.virtual-nights.com",
-	"ads4homes.com",
-	"ads5.canoe.ca",
-	"ads5.virtual-nights.com",
-	"ads6.gamecity.net",
-	"ads7.gamecity.net",
-	"ads8.com",
-	"adsatt.abc.starwave.com",
-	"Adsatt.ABCNews.starwave.com",
-	"adsatt.espn.go.com",
-	"adsatt.espn.starwave.com",
-	"Adsatt.go.starwave.com",
-	"adsby.bidtheatre.com",
-	"adscale.de",
-	"adscience.nl",
-	"adscpm.com",
-	"adsdaq.com",
-	"adsdk.com",
-	"adsend.de",
-	"adserv.evo-x.de",
-	"adserv.gamezone.de",
-	"adserv.iafrica.com",
-	"adserv.qconline.com",
-	"adserve.ams.rhythmxchange.com",
-	"adserver-live.yoc.mobi",
-	"adserver.43plc.com",
-	"adserver.71i.de",
-	"adserver.adultfriendfinder.com",
-	"adserver.aidameter.com",
-	"adserver.aol.fr",
-	"adserver.beggarspromo.com",
-	"adserver.betandwin.de",
-	"adserver.bing.com",
-	"adserver.bizhat.com",
-	"adserver.break-even.it",
-	"adserver.cams.com",
-	"adserver.com",
-	"adserver.digitoday.com",
-	"adserver.dotcommedia.de",
-	"adserver.finditquick.com",
-	"adserver.flossiemediagroup.com",
-	"adserver.freecity.de",
-	"adserver.freenet.de",
-	"adserver.friendfinder.com",
-	"adserver.hardsextube.com",
-	"adserver.hardwareanalysis.com",
-	"adserver.html.it",
-	"adserver.irishwebmasterforum.com",
-	"adserver.janes.com",
-	"adserver.libero.it",
-	"adserver.news.com.au",
-	"adserver.ngz-network.de",
-	"adserver.nydailynews.com",
-	"adserver.o2.pl",
-	"adserver.oddschecker.com",
-	"adserver.omroepzeeland.nl",
-	"adserver.pl",
-	"adserver.portalofevil.com",
-	"adserver.portugalmail.net",
-	"adserver.portugalmail.pt",
-	"adserver.realhomesex.net",
-	"adserver.sanomawsoy.fi",
-	"adserver.sciflicks.com",
-	"adserver.sharewareonline.com",
-	"adserver.spankaway.com",
-	"adserver.startnow.com",
-	"adserver.theonering.net",
-	"adserver.twitpic.com",
-	"adserver.viagogo.com",
-	"adserver.virginmedia.com",
-	"adserver.yahoo.com",
-	"adserver01.de",
-	"adserver1-images.backbeatmedia.com",
-	"adserver1.backbeatmedia.com",
-	"adserver1.mindshare.de",
-	"adserver1.ogilvy-interactive.de",
-	"adserver2.mindshare.de",
-	"adserverplus.com",
-	"adserversolutions.com",
-	"adservinginternational.com",
-	"adsfac.eu",
-	"adsfac.net",
-	"adsfac.us",
-	"adshost1.com",
-	"adside.com",
-	"adsk2.co",
-	"adskape.ru",
-	"adsklick.de",
-	"adsmarket.com",
-	"adsmart.co.uk",
-	"adsmart.com",
-	"adsmart.net",
-	"adsmogo.com",
-	"adsnative.com",
-	"adsoftware.com",
-	"adsoldier.com",
-	"adsonar.com",
-	"adspace.ro",
-	"adspeed.net",
-	"adspirit.de",
-	"adsponse.de",
-	"adsremote.scrippsnetworks.com",
-	"adsrevenue.net",
-	"adsrv.deviantart.com",
-	"adsrv.eacdn.com",
-	"adsrv.iol.co.za",
-	"adsrvr.org",
-	"adsstat.com",
-	"adstat.4u.pl",
-	"adstest.weather.com",
-	"adsupply.com",
-	"adswitcher.com",
-	"adsymptotic.com",
-	"adsynergy.com",
-	"adsys.townnews.com",
-	"adsystem.simplemachines.org",
-	"adtech.de",
-	"adtechus.com",
-	"adtegrity.net",
-	"adthis.com",
-	"adtiger.de",
-	"adtoll.com",
-	"adtology.com",
-	"adtoma.com",
-	"adtrace.org",
-	"adtrade.net",
-	"adtrading.de",
-	"adtrak.net",
-	"adtriplex.com",
-	"adultadvertising.com",
-	"adv-adserver.com",
-	"adv-banner.libero.it",
-	"adv.cooperhosting.net",
-	"adv.freeonline.it",
-	"adv.hwupgrade.it",
-	"adv.livedoor.com",
-	"adv.webmd.com",
-	"adv.wp.pl",
-	"adv.yo.cz",
-	"advariant.com",
-	"adventory.com",
-	"advert.bayarea.com",
-	"advert.dyna.ultraweb.hu",
-	"adverticum.com",
-	"adverticum.net",
-	"adverticus.de",
-	"advertise.com",
-	"advertiseireland.com",
-	"advertisespace.com",
-	"advertising.com",
-	"advertising.guildlaunch.net",
-	"advertisingbanners.com",
-	"advertisingbox.com",
-	"advertmarket.com",
-	"advertmedia.de",
-	"advertpro.sitepoint.com",
-	"advertpro.ya.com",
-	"adverts.carltononline.com",
-	"advertserve.com",
-	"advertstream.com",
-	"advertwizard.com",
-	"advideo.uimserv.net",
-	"adview.ppro.de",
-	"advisormedia.cz",
-	"adviva.com",
-	"adviva.net",
-	"advnt.com",
-	"adwareremovergold.com",
-	"adwhirl.com",
-	"adwitserver.com",
-	"adworldnetwork.com",
-	"adworx.at",
-	"adworx.be",
-	"adworx.nl",
-	"adx.allstar.cz",
-	"adx.atnext.com",
-	"adxpansion.com",
-	"adxpose.com",
-	"adxvalue.com",
-	"adyea.com",
-	"adzerk.net",
-	"adzerk.s3.amazonaws.com",
-	"adzones.com",
-	"af-ad.co.uk",
-	"affbuzzads.com",
-	"affili.net",
-	"affiliate.1800flowers.com",
-	"affiliate.7host.com",
-	"affiliate.doubleyourdating.com",
-	"affiliate.dtiserv.com",
-	"affiliate.gamestop.com",
-	"affiliate.mercola.com",
-	"affiliate.mogs.com",
-	"affiliate.offgamers.com",
-	"affiliate.travelnow.com",
-	"affiliate.viator.com",
-	"affiliatefuel.com",
-	"affiliatefuture.com",
-	"affiliates.allposters.com",
-	"affiliates.babylon.com",
-	"affiliates.digitalriver.com",
-	"affiliates.globat.com",
-	"affiliates.internationaljock.com",
-	"affiliates.streamray.com",
-	"affiliates.thinkhost.net",
-	"affiliates.thrixxx.com",
-	"affiliates.ultrahosting.com",
-	"affiliatetracking.com",
-	"affiliatetracking.net",
-	"affiliatewindow.com",
-	"affiliation-france.com",
-	"afftracking.justanswer.com",
-	"ah-ha.com",
-	"ahalogy.com",
-	"aidu-ads.de",
-	"aim4media.com",
-	"aistat.net",
-	"aktrack.pubmatic.com",
-	"alclick.com",
-	"alenty.com",
-	"alexa-sitestats.s3.amazonaws.com",
-	"all4spy.com",
-	"alladvantage.com",
-	"allosponsor.com",
-	"amazingcounters.com",
-	"amazon-adsystem.com",
-	"americash.com",
-	"amung.us",
-	"an.tacoda.net",
-	"anahtars.com",
-	"analytics.adpost.org",
-	"analytics.google.com",
-	"analytics.live.com",
-	"analytics.yahoo.com",
-	"anm.intelli-direct.com",
-	"annonser.dagbladet.no",
-	"apex-ad.com",
-	"api.intensifier.de",
-	"apture.com",
-	"arc1.msn.com",
-	"arcadebanners.com",
-	"ard.xxxblackbook.com",
-	"are-ter.com",
-	"as.webmd.com",
-	"as1.advfn.com",
-	"as2.advfn.com",
-	"assets1.exgfnetwork.com",
-	"assoc-amazon.com",
-	"at-adserver.alltop.com",
-	"atdmt.com",
-	"athena-ads.wikia.com",
-	"atwola.com",
-	"auctionads.com",
-	"auctionads.net",
-	"audience2media.com",
-	"audit.median.hu",
-	"audit.webinform.hu",
-	"auto-bannertausch.de",
-	"autohits.dk",
-	"avenuea.com",
-	"avpa.javalobby.org",
-	"avres.net",
-	"avsads.com",
-	"awempire.com",
-	"awin1.com",
-	"azfront.com",
-	"b-1st.com",
-	"b.aol.com",
-	"b.engadget.com",
-	"ba.afl.rakuten.co.jp",
-	"babs.tv2.dk",
-	"backbeatmedia.com",
-	"banik.redigy.cz",
-	"banner-exchange-24.de",
-	"banner.ad.nu",
-	"banner.ambercoastcasino.com",
-	"banner.blogranking.net",
-	"banner.buempliz-online.ch",
-	"banner.casino.net",
-	"banner.casinodelrio.com",
-	"banner.cotedazurpalace.com",
-	"banner.coza.com",
-	"banner.cz",
-	"banner.easyspace.com",
-	"banner.elisa.net",
-	"banner.eurogrand.com",
-	"banner.featuredusers.com",
-	"banner.getgo.de",
-	"banner.goldenpalace.com",
-	"banner.img.co.za",
-	"banner.inyourpocket.com",
-	"banner.joylandcasino.com",
-	"banner.kiev.ua",
-	"banner.linux.se",
-	"banner.media-system.de",
-	"banner.mindshare.de",
-	"banner.nixnet.cz",
-	"banner.noblepoker.com",
-	"banner.northsky.com",
-	"banner.orb.net",
-	"banner.penguin.cz",
-	"banner.prestigecasino.com",
-	"banner.rbc.ru",
-	"banner.relcom.ru",
-	"banner.tanto.de",
-	"banner.titan-dsl.de",
-	"banner.vadian.net",
-	"banner.webmersion.com",
-	"banner.wirenode.com",
-	"bannerads.de",
-	"bannerboxes.com",
-	"bannercommunity.de",
-	"bannerconnect.com",
-	"bannerconnect.net",
-	"bannerexchange.cjb.net",
-	"bannerflow.com",
-	"bannergrabber.internet.gr",
-	"bannerhost.com",
-	"bannerimage.com",
-	"bannerlandia.com.ar",
-	"bannermall.com",
-	"bannermarkt.nl",
-	"bannerpower.com",
-	"banners.adultfriendfinder.com",
-	"banners.amigos.com",
-	"banners.apnuk.com",
-	"banners.asiafriendfinder.com",
-	"banners.audioholics.com",
-	"banners.babylon-x.com",
-	"banners.bol.com.br",
-	"banners.cams.com",
-	"banners.clubseventeen.com",
-	"banners.czi.cz",
-	"banners.dine.com",
-	"banners.direction-x.com",
-	"banners.directnic.com",
-	"banners.easydns.com",
-	"banners.ebay.com",
-	"banners.freett.com",
-	"banners.friendfinder.com",
-	"banners.getiton.com",
-	"banners.iq.pl",
-	"banners.isoftmarketing.com",
-	"banners.lifeserv.com",
-	"banners.linkbuddies.com",
-	"banners.passion.com",
-	"banners.resultonline.com",
-	"banners.sexsearch.com",
-	"banners.sys-con.com",
-	"banners.thomsonlocal.com",
-	"banners.videosz.com",
-	"banners.virtuagirlhd.com",
-	"banners.wunderground.com",
-	"bannerserver.com",
-	"bannersgomlm.com",
-	"bannershotlink.perfectgonzo.com",
-	"bannersng.yell.com",
-	"bannerspace.com",
-	"bannerswap.com",
-	"bannery.cz",
-	"bannieres.acces-contenu.com",
-	"bans.adserver.co.il",
-	"bans.bride.ru",
-	"barnesandnoble.bfast.com",
-	"basebanner.com",
-	"baypops.com",
-	"bbelements.com",
-	"bbn.img.com.ua",
-	"begun.ru",
-	"belstat.com",
-	"belstat.nl",
-	"berp.com",
-	"best-pr.info",
-	"best-top.ro",
-	"bestsearch.net",
-	"bhclicks.com",
-	"bidclix.com",
-	"bidclix.net",
-	"bidswitch.net",
-	"bidtrk.com",
-	"bidvertiser.com",
-	"bigbangmedia.com",
-	"bigclicks.com",
-	"billboard.cz",
-	"bitads.net",
-	"bitmedianetwork.com",
-	"bizad.nikkeibp.co.jp",
-	"bizrate.com",
-	"blast4traffic.com",
-	"blingbucks.com",
-	"blogads.com",
-	"blogcounter.de",
-	"blogherads.com",
-	"blogrush.com",
-	"blogtoplist.se",
-	"blogtopsites.com",
-	"blueadvertise.com",
-	"bluekai.com",
-	"bluelithium.com",
-	"bluewhaleweb.com",
-	"bm.annonce.cz",
-	"bn.bfast.com",
-	"boersego-ads.de",
-	"boldchat.com",
-	"boom.ro",
-	"boomads.com",
-	"boost-my-pr.de",
-	"box.anchorfree.net",
-	"bpath.com",
-	"braincash.com",
-	"brandreachsys.com",
-	"bravenet.com.invalid",
-	"bridgetrack.com",
-	"brightinfo.com",
-	"british-banners.com",
-	"bs.yandex.ru",
-	"bttrack.com",
-	"budsinc.com",
-	"bullseye.backbeatmedia.com",
-	"buyhitscheap.com",
-	"buysellads.com",
-	"buzzonclick.com",
-	"bvalphaserver.com",
-	"bwp.download.com",
-	"c.bigmir.net",
-	"c.compete.com",
-	"c1.nowlinux.com",
-	"c1exchange.com",
-	"campaign.bharatmatrimony.com",
-	"caniamedia.com",
-	"carbonads.com",
-	"carbonads.net",
-	"casalemedia.com",
-	"casalmedia.com",
-	"cash4members.com",
-	"cash4popup.de",
-	"cashcrate.com",
-	"cashengines.com",
-	"cashfiesta.com",
-	"cashlayer.com",
-	"cashpartner.com",
-	"casinogames.com",
-	"casinopays.com",
-	"casinorewards.com",
-	"casinotraffic.com",
-	"casinotreasure.com",
-	"cbanners.virtuagirlhd.com",
-	"cbmall.com",
-	"cdn.freefacti.com",
-	"cdn.freefarcy.com",
-	"cecash.com",
-	"centerpointmedia.com",
-	"ceskydomov.alias.ngs.modry.cz",
-	"cetrk.com",
-	"cgicounter.puretec.de",
-	"ch.questionmarket.com",
-	"chameleon.ad",
-	"channelintelligence.com",
-	"chart.dk",
-	"chartbeat.com",
-	"chartbeat.net",
-	"checkm8.com",
-	"checkstat.nl",
-	"chestionar.ro",
-	"chitika.net",
-	"cibleclick.com",
-	"cityads.telus.net",
-	"cj.com",
-	"cjbmanagement.com",
-	"cjlog.com",
-	"claria.com",
-	"class-act-clicks.com",
-	"click.absoluteagency.com",
-	"click.fool.com",
-	"click.kmindex.ru",
-	"click2freemoney.com",
-	"click2paid.com",
-	"clickability.com",
-	"clickadz.com",
-	"clickagents.com",
-	"clickbank.com",
-	"clickbank.net",
-	"clickbooth.com",
-	"clickboothlnk.com",
-	"clickbrokers.com",
-	"clickcompare.co.uk",
-	"clickdensity.com",
-	"clickedyclick.com",
-	"clickhereforcellphones.com",
-	"clickhouse.com",
-	"clickhype.com",
-	"clicklink.jp",
-	"clickmedia.ro",
-	"clickonometrics.pl",
-	"clicks.equantum.com",
-	"clicks.mods.de",
-	"clickserve.cc-dt.com",
-	"clicksor.com",
-	"clicktag.de",
-	"clickthrucash.com",
-	"clickthruserver.com",
-	"clickthrutraffic.com",
-	"clicktrace.info",
-	"clicktrack.ziyu.net",
-	"clicktracks.com",
-	"clicktrade.com",
-	"clickxchange.com",
-	"clickz.com",
-	"clickzxc.com",
-	"clicmanager.fr",
-	"clients.tbo.com",
-	"clixgalore.com",
-	"clk.konflab.com",
-	"clkads.com",
-	"clkrev.com",
-	"cluster.adultworld.com",
-	"clustrmaps.com",
-	"cmpstar.com",
-	"cnomy.com",
-	"cnt.spbland.ru",
-	"cnt1.pocitadlo.cz",
-	"code-server.biz",
-	"colonize.com",
-	"comclick.com",
-	"commindo-media-ressourcen.de",
-	"commissionmonster.com",
-	"compactbanner.com",
-	"comprabanner.it",
-	"confirmed-profits.com",
-	"connextra.com",
-	"contaxe.de",
-	"content.acc-hd.de",
-	"content.ad",
-	"contextweb.com",
-	"conversantmedia.com",
-	"conversionruler.com",
-	"cookies.cmpnet.com",
-	"coremetrics.com",
-	"count.rbc.ru",
-	"count.rin.ru",
-	"count.west263.com",
-	"counted.com",
-	"counter.bloke.com",
-	"counter.cnw.cz",
-	"counter.cz",
-	"counter.dreamhost.com",
-	"counter.fateback.com",
-	"counter.mirohost.net",
-	"counter.mojgorod.ru",
-	"counter.nowlinux.com",
-	"counter.rambler.ru",
-	"counter.search.bg",
-	"counter.sparklit.com",
-	"counter.yadro.ru",
-	"counters.honesty.com",
-	"counting.kmindex.ru",
-	"counts.tucows.com",
-	"coupling-media.de",
-	"cpalead.com",
-	"cpays.com",
-	"cpmaffiliation.com",
-	"cpmstar.com",
-	"cpxadroit.com",
-	"cpxinteractive.com",
-	"cqcounter.com",
-	"crakmedia.com",
-	"craktraffic.com",
-	"crawlability.com",
-	"crazypopups.com",
-	"creafi-online-media.com",
-	"creative.whi.co.nz",
-	"creatives.as4x.tmcs.net",
-	"creatives.livejasmin.com",
-	"crispads.com",
-	"criteo.com",
-	"crowdgravity.com",
-	"crtv.mate1.com",
-	"crwdcntrl.net",
-	"ctnetwork.hu",
-	"cubics.com",
-	"customad.cnn.com",
-	"cyberbounty.com",
-	"cybermonitor.com",
-	"d.adroll.com",
-	"dakic-ia-300.com",
-	"danban.com",
-	"dapper.net",
-	"datashreddergold.com",
-	"dbbsrv.com",
-	"dc-storm.com",
-	"de17a.com",
-	"dealdotcom.com",
-	"debtbusterloans.com",
-	"decknetwork.net",
-	"deloo.de",
-	"demandbase.com",
-	"demdex.net",
-	"di1.shopping.com",
-	"dialerporn.com",
-	"didtheyreadit.com",
-	"direct-xxx-access.com",
-	"directaclick.com",
-	"directivepub.com",
-	"directleads.com",
-	"directorym.com",
-	"directtrack.com",
-	"discountclick.com",
-	"displayadsmedia.com",
-	"dist.belnk.com",
-	"dmtracker.com",
-	"dmtracking.alibaba.com",
-	"dmtracking2.alibaba.com",
-	"dnads.directnic.com",
-	"domaining.in",
-	"domainsponsor.com",
-	"domainsteam.de",
-	"domdex.com",
-	"doubleclick.com",
-	"doubleclick.de",
-	"doubleclick.net",
-	"doublepimp.com",
-	"drumcash.com",
-	"dynamic.fmpub.net",
-	"e-adimages.scrippsnetworks.com",
-	"e-bannerx.com",
-	"e-debtconsolidation.com",
-	"e-m.fr",
-	"e-n-t-e-r-n-e-x.com",
-	"e-planning.net",
-	"e.kde.cz",
-	"eadexchange.com",
-	"eas.almamedia.fi",
-	"easyhits4u.com",
-	"ebayadvertising.com",
-	"ebocornac.com",
-	"ebuzzing.com",
-	"ecircle-ag.com",
-	"eclick.vn",
-	"ecoupons.com",
-	"edgeio.com",
-	"effectivemeasure.com",
-	"effectivemeasure.net",
-	"eiv.baidu.com",
-	"elitedollars.com",
-	"elitetoplist.com",
-	"emarketer.com",
-	"emediate.dk",
-	"emediate.eu",
-	"engine.espace.netavenir.com",
-	"enginenetwork.com",
-	"enoratraffic.com",
-	"enquisite.com",
-	"entercasino.com",
-	"entrecard.s3.amazonaws.com",
-	"eqads.com",
-	"ero-advertising.com",
-	"esellerate.net",
-	"estat.com",
-	"etahub.com",
-	"etargetnet.com",
-	"etracker.de",
-	"eu-adcenter.net",
-	"eu1.madsone.com",
-	"eur.a1.yimg.com",
-	"eurekster.com",
-	"euro-linkindex.de",
-	"euroclick.com",
-	"euros4click.de",
-	"eusta.de",
-	"evergage.com",
-	"evidencecleanergold.com",
-	"ewebcounter.com",
-	"exchange-it.com",
-	"exchange.bg",
-	"exchangead.com",
-	"exchangeclicksonline.com",
-	"exelator.com",
-	"exit76.com",
-	"exitexchange.com",
-	"exitfuel.com",
-	"exoclick.com",
-	"exogripper.com",
-	"experteerads.com",
-	"exponential.com",
-	"express-submit.de",
-	"extractorandburner.com",
-	"extreme-dm.com",
-	"extremetracking.com",
-	"eyeblaster.com",
-	"eyereturn.com",
-	"eyeviewads.com",
-	"eyewonder.com",
-	"ezula.com",
-	"f5biz.com",
-	"fast-adv.it",
-	"fastclick.com",
-	"fastclick.com.edgesuite.net",
-	"fastclick.net",
-	"fb-promotions.com",
-	"fc.webmasterpro.de",
-	"feedbackresearch.com",
-	"feedjit.com",
-	"ffxcam.fairfax.com.au",
-	"fimc.net",
-	"fimserve.com",
-	"findcommerce.com",
-	"findyourcasino.com",
-	"fineclicks.com",
-	"first.nova.cz",
-	"firstlightera.com",
-	"flashtalking.com",
-	"fleshlightcash.com",
-	"flexbanner.com",
-	"flowgo.com",
-	"flurry.com",
-	"fonecta.leiki.com",
-	"foo.cosmocode.de",
-	"forex-affiliate.net",
-	"fpctraffic.com",
-	"fpctraffic2.com",
-	"fragmentserv.iac-online.de",
-	"free-banners.com",
-	"freebanner.com",
-	"freelogs.com",
-	"freeonlineusers.com",
-	"freepay.com",
-	"freestats.com",
-	"freestats.tv",
-	"freewebcounter.com",
-	"funklicks.com",
-	"funpageexchange.com",
-	"fusionads.net",
-	"fusionquest.com",
-	"fxclix.com",
-	"fxstyle.net",
-	"galaxien.com",
-	"game-advertising-online.com",
-	"gamehouse.com",
-	"gamesites100.net",
-	"gamesites200.com",
-	"gamesitestop100.com",
-	"gator.com",
-	"gbanners.hornymatches.com",
-	"gemius.pl",
-	"geo.digitalpoint.com",
-	"geobanner.adultfriendfinder.com",
-	"geovisite.com",
-	"getclicky.com",
-	"globalismedia.com",
-	"globaltakeoff.net",
-	"globaltrack.com.invalid",
-	"globe7.com",
-	"globus-inter.com",
-	"gmads.net",
-	"go-clicks.de",
-	"go-rank.de",
-	"goingplatinum.com",
-	"gold.weborama.fr",
-	"goldstats.com",
-	"google-analytics.com",
-	"googleadservices.com",
-	"googlesyndication.com",
-	"gostats.com",
-	"gp.dejanews.com",
-	"gpr.hu",
-	"grafstat.ro",
-	"grapeshot.co.uk",
-	"greystripe.com",
-	"gtop.ro",
-	"gtop100.com",
-	"gunggo.com",
-	"harrenmedia.com",
-	"harrenmedianetwork.com",
-	"havamedia.net",
-	"heias.com",
-	"hentaicounter.com",
-	"herbalaffiliateprogram.com",
-	"hexusads.fluent.ltd.uk",
-	"heyos.com",
-	"hgads.com",
-	"hidden.gogoceleb.com",
-	"hightrafficads.com",
-	"histats.com",
-	"hit-parade.com",
-	"hit.bg",
-	"hit.ua",
-	"hit.webcentre.lycos.co.uk",
-	"hitbox.com",
-	"hitcents.com",
-	"hitexchange.net",
-	"hitfarm.com",
-	"hitiz.com",
-	"hitlist.ru",
-	"hitlounge.com",
-	"hitometer.com",
-	"hits.europuls.eu",
-	"hits.informer.com",
-	"hits.puls.lv",
-	"hits.theguardian.com",
-	"hits4me.com",
-	"hits4pay.com",
-	"hitslink.com",
-	"hittail.com",
-	"hollandbusinessadvertising.nl",
-	"homepageking.de",
-	"hostedads.realitykings.com",
-	"hotjar.com",
-	"hotkeys.com",
-	"hotlog.ru",
-	"hotrank.com.tw",
-	"htmlhubing.xyz",
-	"httpool.com",
-	"hurricanedigitalmedia.com",
-	"hydramedia.com",
-	"hyperbanner.net",
-	"hypertracker.com",
-	"i-clicks.net",
-	"i.xx.openx.com",
-	"i1img.com",
-	"i1media.no",
-	"ia.iinfo.cz",
-	"iad.anm.co.uk",
-	"iadnet.com",
-	"iasds01.com",
-	"iconadserver.com",
-	"icptrack.com",
-	"idcounter.com",
-	"identads.com",
-	"idot.cz",
-	"idregie.com",
-	"idtargeting.com",
-	"ientrymail.com",
-	"iesnare.com",
-	"ifa.tube8live.com",
-	"ilbanner.com",
-	"ilead.itrack.it",
-	"ilovecheating.com",
-	"imageads.canoe.ca",
-	"imagecash.net",
-	"images-pw.secureserver.net",
-	"images.v3.com",
-	"imarketservices.com",
-	"img.prohardver.hu",
-	"imgpromo.easyrencontre.com",
-	"imonitor.nethost.cz",
-	"imprese.cz",
-	"impressionmedia.cz",
-	"impressionz.co.uk",
-	"imrworldwide.com",
-	"inboxdollars.com",
-	"incentaclick.com",
-	"indexstats.com",
-	"indieclick.com",
-	"industrybrains.com",
-	"inetlog.ru",
-	"infinite-ads.com",
-	"infinityads.com",
-	"infolinks.com",
-	"information.com",
-	"inringtone.com",
-	"insightexpress.com",
-	"insightexpressai.com",
-	"inspectorclick.com",
-	"instantmadness.com",
-	"intelliads.com",
-	"intellitxt.com",
-	"interactive.forthnet.gr",
-	"intergi.com",
-	"internetfuel.com",
-	"interreklame.de",
-	"interstat.hu",
-	"ip.ro",
-	"ip193.cn",
-	"iperceptions.com",
-	"ipro.com",
-	"ireklama.cz",
-	"itfarm.com",
-	"itop.cz",
-	"its-that-easy.com",
-	"itsptp.com",
-	"jcount.com",
-	"jinkads.de",
-	"joetec.net",
-	"js.users.51.la",
-	"juicyads.com",
-	"jumptap.com",
-	"justrelevant.com",
-	"justwebads.com",
-	"k.iinfo.cz",
-	"kanoodle.com",
-	"keymedia.hu",
-	"kindads.com",
-	"kissmetrics.com",
-	"kliks.nl",
-	"komoona.com",
-	"kompasads.com",
-	"kontera.com",
-	"kt-g.de",
-	"ktu.sv2.biz",
-	"lakequincy.com",
-	"layer-ad.de",
-	"layer-ads.de",
-	"lbn.ru",
-	"lct.salesforce.com",
-	"lead-analytics.nl",
-	"leadboltads.net",
-	"leadclick.com",
-	"leadingedgecash.com",
-	"leadzupc.com",
-	"levelrate.de",
-	"lfstmedia.com",
-	"liftdna.com",
-	"ligatus.com",
-	"ligatus.de",
-	"lightningcast.net",
-	"lightspeedcash.com",
-	"link-booster.de",
-	"link4ads.com",
-	"linkadd.de",
-	"linkbuddies.com",
-	"linkexchange.com",
-	"linkprice.com",
-	"linkrain.com",
-	"linkreferral.com",
-	"links-ranking.de",
-	"linkshighway.com",
-	"linkstorms.com",
-	"linkswaper.com",
-	"linktarget.com",
-	"liquidad.narrowcastmedia.com",
-	"liveintent.com",
-	"liverail.com",
-	"loading321.com",
-	"log.btopenworld.com",
-	"logua.com",
-	"lop.com",
-	"lucidmedia.com",
-	"lzjl.com",
-	"m.webtrends.com",
-	"m1.webstats4u.com",
-	"m4n.nl",
-	"mackeeperapp.mackeeper.com",
-	"madclient.uimserv.net",
-	"madisonavenue.com",
-	"mads.cnet.com",
-	"madvertise.de",
-	"marchex.com",
-	"market-buster.com",
-	"marketing.888.com",
-	"marketing.hearstmagazines.nl",
-	"marketing.nyi.net",
-	"marketing.osijek031.com",
-	"marketingsolutions.yahoo.com",
-	"maroonspider.com",
-	"mas.sector.sk",
-	"mastermind.com",
-	"matchcraft.com",
-	"mathtag.com",
-	"max.i12.de",
-	"maximumcash.com",
-	"mbn.com.ua",
-	"mbs.megaroticlive.com",
-	"mbuyu.nl",
-	"mdotm.com",
-	"measuremap.com",
-	"media-adrunner.mycomputer.com",
-	"media-servers.net",
-	"media.ftv-publicite.fr",
-	"media.funpic.de",
-	"media6degrees.com",
-	"mediaarea.eu",
-	"mediacharger.com",
-	"mediadvertising.ro",
-	"mediageneral.com",
-	"mediamath.com",
-	"mediamgr.ugo.com",
-	"mediaplazza.com",
-	"mediaplex.com",
-	"mediascale.de",
-	"mediatext.com",
-	"mediax.angloinfo.com",
-	"mediaz.angloinfo.com",
-	"medleyads.com",
-	"medyanetads.com",
-	"megacash.de",
-	"megago.com",
-	"megastats.com",
-	"megawerbung.de",
-	"metaffiliation.com",
-	"metanetwork.com",
-	"methodcash.com",
-	"metrics.windowsitpro.com",
-	"mgid.com",
-	"miarroba.com",
-	"microstatic.pl",
-	"microticker.com",
-	"midnightclicking.com",
-	"misstrends.com",
-	"mixpanel.com",
-	"mixtraffic.com",
-	"mjxads.internet.com",
-	"mlm.de",
-	"mmismm.com",
-	"mmtro.com",
-	"moatads.com",
-	"mobclix.com",
-	"mocean.mobi",
-	"moneyexpert.com",
-	"monsterpops.com",
-	"mopub.com",
-	"mouseflow.com",
-	"mpstat.us",
-	"mr-rank.de",
-	"mrskincash.com",
-	"mtree.com",
-	"musiccounter.ru",
-	"muwmedia.com",
-	"myaffiliateprogram.com",
-	"mybloglog.com",
-	"mycounter.ua",
-	"mymoneymakingapp.com",
-	"mypagerank.net",
-	"mypagerank.ru",
-	"mypowermall.com",
-	"mystat-in.net",
-	"mystat.pl",
-	"mytop-in.net",
-	"n69.com",
-	"naiadsystems.com.invalid",
-	"naj.sk",
-	"namimedia.com",
-	"nastydollars.com",
-	"navigator.io",
-	"navrcholu.cz",
-	"nbjmp.com",
-	"ndparking.com",
-	"nedstat.com",
-	"nedstat.nl",
-	"nedstatbasic.net",
-	"nedstatpro.net",
-	"nend.net",
-	"neocounter.neoworx-blog-tools.net",
-	"neoffic.com",
-	"net-filter.com",
-	"netaffiliation.com",
-	"netagent.cz",
-	"netclickstats.com",
-	"netcommunities.com",
-	"netdirect.nl",
-	"netincap.com",
-	"netpool.netbookia.net",
-	"netshelter.net",
-	"network.business.com",
-	"neudesicmediagroup.com",
-	"newads.bangbros.com",
-	"newbie.com",
-	"newnet.qsrch.com",
-	"newnudecash.com",
-	"newopenx.detik.com",
-	"newt1.adultadworld.com",
-	"newt1.adultworld.com",
-	"newtopsites.com",
-	"ng3.ads.warnerbros.com",
-	"ngs.impress.co.jp",
-	"nitroclicks.com",
-	"novem.pl",
-	"nuggad.net",
-	"numax.nu-1.com",
-	"nuseek.com",
-	"oas.benchmark.fr",
-	"oas.foxnews.com",
-	"oas.repubblica.it",
-	"oas.roanoke.com",
-	"oas.salon.com",
-	"oas.toronto.com",
-	"oas.uniontrib.com",
-	"oas.villagevoice.com",
-	"oascentral.businessweek.com",
-	"oascentral.chicagobusiness.com",
-	"oascentral.fortunecity.com",
-	"oascentral.register.com",
-	"oewa.at",
-	"oewabox.at",
-	"offerforge.com",
-	"offermatica.com",
-	"olivebrandresponse.com",
-	"omniture.com",
-	"onclasrv.com",
-	"onclickads.net",
-	"oneandonlynetwork.com",
-	"onenetworkdirect.com",
-	"onestat.com",
-	"onestatfree.com",
-	"onewaylinkexchange.net",
-	"online-metrix.net",
-	"onlinecash.com",
-	"onlinecashmethod.com",
-	"onlinerewardcenter.com",
-	"openad.tf1.fr",
-	"openad.travelnow.com",
-	"openads.friendfinder.com",
-	"openads.org",
-	"openx.angelsgroup.org.uk",
-	"openx.blindferret.com",
-	"opienetwork.com",
-	"optimost.com",
-	"optmd.com",
-	"ordingly.com",
-	"ota.cartrawler.com",
-	"otto-images.developershed.com",
-	"outbrain.com",
-	"overture.com",
-	"owebmoney.ru",
-	"oxado.com",
-	"oxcash.com",
-	"oxen.hillcountrytexas.com",
-	"p.adpdx.com",
-	"pagead.l.google.com",
-	"pagefair.com",
-	"pagerank-ranking.de",
-	"pagerank-submitter.de",
-	"pagerank-suchmaschine.de",
-	"pagerank-united.de",
-	"pagerank4you.com",
-	"pageranktop.com",
-	"parse.ly",
-	"parsely.com",
-	"partage-facile.com",
-	"partner-ads.com",
-	"partner.pelikan.cz",
-	"partner.topcities.com",
-	"partnerad.l.google.com",
-	"partnercash.de",
-	"partners.priceline.com",
-	"passion-4.net",
-	"pay-ads.com",
-	"paycounter.com",
-	"paypopup.com",
-	"payserve.com",
-	"pbnet.ru",
-	"pcash.imlive.com",
-	"peep-auktion.de",
-	"peer39.com",
-	"pennyweb.com",
-	"pepperjamnetwork.com",
-	"percentmobile.com",
-	"perf.weborama.fr",
-	"perfectaudience.com",
-	"perfiliate.com",
-	"performancerevenue.com",
-	"performancerevenues.com",
-	"performancing.com",
-	"pgmediaserve.com",
-	"pgpartner.com",
-	"pheedo.com",
-	"phoenix-adrunner.mycomputer.com",
-	"phpadsnew.new.natuurpark.nl",
-	"phpmyvisites.net",
-	"picadmedia.com",
-	"pillscash.com",
-	"pimproll.com",
-	"pixel.adsafeprotected.com",
-	"pixel.jumptap.com",
-	"pixel.redditmedia.com",
-	"play4traffic.com",
-	"playhaven.com",
-	"plista.com",
-	"plugrush.com",
-	"pointroll.com",
-	"pop-under.ru",
-	"popads.net",
-	"popub.com",
-	"popunder.ru",
-	"popup.msn.com",
-	"popupmoney.com",
-	"popupnation.com",
-	"popups.infostart.com",
-	"popuptraffic.com",
-	"porngraph.com",
-	"porntrack.com",
-	"postrelease.com",
-	"potenza.cz",
-	"pr-star.de",
-	"pr-ten.de",
-	"praddpro.de",
-	"prchecker.info",
-	"precisioncounter.com",
-	"predictad.com",
-	"premium-offers.com",
-	"primaryads.com",
-	"primetime.net",
-	"privatecash.com",
-	"pro-advertising.com",
-	"pro.i-doctor.co.kr",
-	"proext.com",
-	"profero.com",
-	"projectwonderful.com",
-	"promo.badoink.com",
-	"promo.ulust.com",
-	"promo1.webcams.nl",
-	"promobenef.com",
-	"promos.fling.com",
-	"promote.pair.com",
-	"promotion-campaigns.com",
-	"pronetadvertising.com",
-	"propellerads.com",
-	"proranktracker.com",
-	"proton-tm.com",
-	"protraffic.com",
-	"provexia.com",
-	"prsitecheck.com",
-	"psstt.com",
-	"pub.chez.com",
-	"pub.club-internet.fr",
-	"pub.hardware.fr",
-	"pub.realmedia.fr",
-	"pubdirecte.com",
-	"publicidad.elmundo.es",
-	"pubmatic.com",
-	"pubs.lemonde.fr",
-	"pulse360.com",
-	"q.azcentral.com",
-	"qctop.com",
-	"qnsr.com",
-	"quantcast.com",
-	"quantserve.com",
-	"quarterserver.de",
-	"questaffiliates.net",
-	"quigo.com",
-	"quinst.com",
-	"quisma.com",
-	"rad.msn.com",
-	"radar.cedexis.com",
-	"radarurl.com",
-	"radiate.com",
-	"rampidads.com",
-	"rank-master.com",
-	"rank-master.de",
-	"rankchamp.de",
-	"ranking-charts.de",
-	"ranking-hits.de",
-	"ranking-id.de",
-	"ranking-links.de",
-	"ranking-liste.de",
-	"ranking-street.de",
-	"rankingchart.de",
-	"rankingscout.com",
-	"rankyou.com",
-	"rapidcounter.com",
-	"rate.ru",
-	"ratings.lycos.com",
-	"rb1.design.ru",
-	"re-directme.com",
-	"reachjunction.com",
-	"reactx.com",
-	"readserver.net",
-	"realcastmedia.com",
-	"realclix.com",
-	"realmedia-a800.d4p.net",
-	"realtechnetwork.com",
-	"realtracker.com",
-	"reduxmedia.com",
-	"reduxmediagroup.com",
-	"reedbusiness.com.invalid",
-	"referralware.com",
-	"regnow.com",
-	"reinvigorate.net",
-	"reklam.rfsl.se",
-	"reklama.mironet.cz",
-	"reklama.reflektor.cz",
-	"reklamcsere.hu",
-	"reklame.unwired-i.net",
-	"reklamer.com.ua",
-	"relevanz10.de",
-	"relmaxtop.com",
-	"remotead.cnet.com",
-	"republika.onet.pl",
-	"retargeter.com",
-	"revenue.net",
-	"revenuedirect.com",
-	"revsci.net",
-	"revstats.com",
-	"richmails.com",
-	"richmedia.yimg.com",
-	"richwebmaster.com",
-	"rightstats.com",
-	"rlcdn.com",
-	"rle.ru",
-	"rmads.msn.com",
-	"rmedia.boston.com",
-	"roar.com",
-	"robotreplay.com",
-	"roia.biz",
-	"rok.com.com",
-	"rose.ixbt.com",
-	"rotabanner.com",
-	"roxr.net",
-	"rtbpop.com",
-	"rtbpopd.com",
-	"ru-traffic.com",
-	"ru4.com",
-	"rubiconproject.com",
-	"s.adroll.com",
-	"s2d6.com",
-	"sageanalyst.net",
-	"samsungacr.com",
-	"samsungads.com",
-	"sbx.pagesjaunes.fr",
-	"scambiobanner.aruba.it",
-	"scanscout.com",
-	"scopelight.com",
-	"scorecardresearch.com",
-	"scratch2cash.com",
-	"scripte-monster.de",
-	"searchfeast.com",
-	"searchmarketing.com",
-	"searchramp.com",
-	"secure.webconnect.net",
-	"sedoparking.com",
-	"sedotracker.com",
-	"seeq.com.invalid",
-	"sensismediasmart.com.au",
-	"seo4india.com",
-	"serv0.com",
-	"servedbyadbutler.com",
-	"servedbyopenx.com",
-	"servethis.com",
-	"services.hearstmags.com",
-	"serving-sys.com",
-	"sexaddpro.de",
-	"sexadvertentiesite.nl",
-	"sexcounter.com",
-	"sexinyourcity.com",
-	"sexlist.com",
-	"sextracker.com",
-	"sexystat.com",
-	"shareadspace.com",
-	"shareasale.com",
-	"sharepointads.com",
-	"sher.index.hu",
-	"shinystat.com",
-	"shinystat.it",
-	"shoppingads.com",
-	"siccash.com",
-	"sidebar.angelfire.com",
-	"sinoa.com",
-	"sitemeter.com",
-	"sitestat.com",
-	"sixsigmatraffic.com",
-	"skimresources.com",
-	"skylink.vn",
-	"slickaffiliate.com",
-	"slopeaota.com",
-	"smart4ads.com",
-	"smartadserver.com",
-	"smowtion.com",
-	"snapads.com",
-	"snoobi.com",
-	"socialspark.com",
-	"softclick.com.br",
-	"spacash.com",
-	"sparkstudios.com",
-	"specificmedia.co.uk",
-	"specificpop.com",
-	"spezialreporte.de",
-	"spinbox.techtracker.com",
-	"spinbox.versiontracker.com",
-	"sponsorads.de",
-	"sponsorpro.de",
-	"sponsors.thoughtsmedia.com",
-	"spot.fitness.com",
-	"spotxchange.com",
-	"sprinks-clicks.about.com",
-	"spylog.com",
-	"spywarelabs.com",
-	"spywarenuker.com",
-	"spywords.com",
-	"srwww1.com",
-	"starffa.com",
-	"start.freeze.com",
-	"stat.cliche.se",
-	"stat.dealtime.com",
-	"stat.dyna.ultraweb.hu",
-	"stat.pl",
-	"stat.su",
-	"stat.tudou.com",
-	"stat.webmedia.pl",
-	"stat.zenon.net",
-	"stat24.com",
-	"stat24.meta.ua",
-	"statcounter.com",
-	"static.fmpub.net",
-	"static.itrack.it",
-	"staticads.btopenworld.com",
-	"statistik-gallup.net",
-	"statm.the-adult-company.com",
-	"stats.blogger.com",
-	"stats.cts-bv.nl",
-	"stats.directnic.com",
-	"stats.hyperinzerce.cz",
-	"stats.mirrorfootball.co.uk",
-	"stats.multiup.org",
-	"stats.olark.com",
-	"stats.suite101.com",
-	"stats.surfaid.ihost.com",
-	"stats.townnews.com",
-	"stats.unwired-i.net",
-	"stats.wordpress.com",
-	"stats.x14.eu",
-	"stats4all.com",
-	"statsie.com",
-	"statxpress.com",
-	"steelhouse.com",
-	"steelhousemedia.com",
-	"stickyadstv.com",
-	"suavalds.com",
-	"subscribe.hearstmags.com",
-	"sugoicounter.com",
-	"superclix.de",
-	"superstats.com",
-	"supertop.ru",
-	"supertop100.com",
-	"suptullog.com",
-	"surfmusik-adserver.de",
-	"swan-swan-goose.com",
-	"swissadsolutions.com",
-	"swordfishdc.com",
-	"sx.trhnt.com",
-	"t.insigit.com",
-	"t.pusk.ru",
-	"taboola.com",
-	"tacoda.net",
-	"tagular.com",
-	"tailsweep.co.uk",
-	"tailsweep.com",
-	"tailsweep.se",
-	"takru.com",
-	"tangerinenet.biz",
-	"tapad.com",
-	"targad.de",
-	"targetingnow.com",
-	"targetnet.com",
-	"targetpoint.com",
-	"tatsumi-sys.jp",
-	"tcads.net",
-	"teads.tv",
-	"techclicks.net",
-	"teenrevenue.com",
-	"teliad.de",
-	"text-link-ads.com",
-	"textad.sexsearch.com",
-	"textads.biz",
-	"textads.opera.com",
-	"textlinks.com",
-	"tfag.de",
-	"theadhost.com",
-	"theads.me",
-	"thebugs.ws",
-	"thecounter.com",
-	"therapistla.com",
-	"therichkids.com",
-	"thrnt.com",
-	"thruport.com",
-	"tinybar.com",
-	"tizers.net",
-	"tlvmedia.com",
-	"tntclix.co.uk",
-	"top-casting-termine.de",
-	"top-site-list.com",
-	"top.list.ru",
-	"top.mail.ru",
-	"top.proext.com",
-	"top100-images.rambler.ru",
-	"top100.mafia.ru",
-	"top123.ro",
-	"top20.com.invalid",
-	"top20free.com",
-	"top90.ro",
-	"topbarh.box.sk",
-	"topblogarea.se",
-	"topbucks.com",
-	"topforall.com",
-	"toplist.cz",
-	"toplist.pornhost.com",
-	"toplista.mw.hu",
-	"toplistcity.com",
-	"topmmorpgsites.com.invalid",
-	"topping.com.ua",
-	"toprebates.com",
-	"topsafelist.net",
-	"topsearcher.com",
-	"topsir.com",
-	"topsite.lv",
-	"topsites.com.br",
-	"topstats.com",
-	"totemcash.com",
-	"touchclarity.com",
-	"touchclarity.natwest.com",
-	"tour.brazzers.com",
-	"tpnads.com",
-	"track.adform.net",
-	"track.anchorfree.com",
-	"track.gawker.com",
-	"track.happysitewriter.com",
-	"trackalyzer.com",
-	"tracker.icerocket.com",
-	"tracker.marinsm.com",
-	"tracking.crunchiemedia.com",
-	"tracking.gajmp.com",
-	"tracking.internetstores.de",
-	"tracking.yourfilehost.com",
-	"tracking101.com",
-	"trackingsoft.com",
-	"trackmysales.com",
-	"tradeadexchange.com",
-	"tradedoubler.com",
-	"traffic-exchange.com",
-	"traffic.liveuniversenetwork.com",
-	"trafficadept.com",
-	"trafficcdn.liveuniversenetwork.com",
-	"trafficfactory.biz",
-	"trafficholder.com",
-	"traffichunt.com",
-	"trafficjunky.net",
-	"trafficleader.com",
-	"trafficsecrets.com",
-	"trafficspaces.net",
-	"trafficstrategies.com",
-	"trafficswarm.com",
-	"traffictrader.net",
-	"trafficz.com",
-	"trafficz.net",
-	"traffiq.com",
-	"trafic.ro",
-	"travis.bosscasinos.com",
-	"trekblue.com",
-	"trekdata.com",
-	"trendcounter.com",
-	"trhunt.com",
-	"tribalfusion.com",
-	"trix.net",
-	"truehits.net",
-	"truehits1.gits.net.th",
-	"truehits2.gits.net.th",
-	"tsms-ad.tsms.com",
-	"tubemogul.com",
-	"turn.com",
-	"tvmtracker.com",
-	"twittad.com",
-	"tyroo.com",
-	"uarating.com",
-	"ukbanners.com",
-	"ultramercial.com",
-	"unanimis.co.uk",
-	"untd.com",
-	"updated.com",
-	"urlcash.net",
-	"us.a1.yimg.com",
-	"usapromotravel.com",
-	"usmsad.tom.com",
-	"utarget.co.uk",
-	"utils.mediageneral.net",
-	"v1.cnzz.com",
-	"validclick.com",
-	"valuead.com",
-	"valueclick.com",
-	"valueclickmedia.com",
-	"valuecommerce.com",
-	"valuesponsor.com",
-	"veille-referencement.com",
-	"ventivmedia.com",
-	"vericlick.com",
-	"vertadnet.com",
-	"veruta.com",
-	"vervewireless.com",
-	"vibrantmedia.com",
-	"video-stats.video.google.com",
-	"videoegg.com",
-	"view4cash.de",
-	"viewpoint.com",
-	"visistat.com",
-	"visit.webhosting.yahoo.com",
-	"visitbox.de",
-	"visual-pagerank.fr",
-	"visualrevenue.com",
-	"voicefive.com",
-	"vpon.com",
-	"vrs.cz",
-	"vs.tucows.com",
-	"vungle.com",
-	"warlog.ru",
-	"wdads.sx.atl.publicus.com",
-	"web-stat.com",
-	"web.informer.com",
-	"web2.deja.com",
-	"webads.co.nz",
-	"webads.nl",
-	"webangel.ru",
-	"webcash.nl",
-	"webcounter.cz",
-	"webcounter.goweb.de",
-	"webgains.com",
-	"webmaster-partnerprogramme24.de",
-	"webmasterplan.com",
-	"webmasterplan.de",
-	"weborama.fr",
-	"webpower.com",
-	"webreseau.com",
-	"webseoanalytics.com",
-	"websponsors.com",
-	"webstat.channel4.com",
-	"webstat.com",
-	"webstat.net",
-	"webstats4u.com",
-	"webtrackerplus.com",
-	"webtraffic.se",
-	"webtraxx.de",
-	"webtrendslive.com",
-	"wegcash.com",
-	"werbung.meteoxpress.com",
-	"wetrack.it",
-	"whaleads.com",
-	"whenu.com",
-	"whispa.com",
-	"whoisonline.net",
-	"wholesaletraffic.info",
-	"widespace.com",
-	"widgetbucks.com",
-	"wikia-ads.wikia.com",
-	"window.nixnet.cz",
-	"wintricksbanner.googlepages.com",
-	"witch-counter.de",
-	"wlmarketing.com",
-	"wmirk.ru",
-	"wonderlandads.com",
-	"wondoads.de",
-	"woopra.com",
-	"worldwide-cash.net",
-	"wtlive.com",
-	"www-banner.chat.ru",
-	"www-google-analytics.l.google.com",
-	"www.banner-link.com.br",
-	"www.dnps.com",
-	"www.kaplanindex.com",
-	"www.money4exit.de",
-	"www.photo-ads.co.uk",
-	"www1.gto-media.com",
-	"www8.glam.com",
-	"wwwpromoter.com",
-	"x-traceur.com",
-	"x6.yakiuchi.com",
-	"xchange.ro",
-	"xclicks.net",
-	"xertive.com",
-	"xg4ken.com",
-	"xiti.com",
-	"xplusone.com",
-	"xponsor.com",
-	"xq1.net",
-	"xrea.com",
-	"xtendmedia.com",
-	"xtremetop100.com",
-	"xxxcounter.com",
-	"xxxmyself.com",
-	"y.ibsys.com",
-	"yab-adimages.s3.amazonaws.com",
-	"yabuka.com",
-	"yadro.ru",
-	"yesads.com",
-	"yesadvertising.com",
-	"yieldads.com",
-	"yieldlab.net",
-	"yieldmanager.com",
-	"yieldmanager.net",
-	"yieldmo.com",
-	"yieldtraffic.com",
-	"yoc.mobi",
-	"yoggrt.com",
-	"z5x.net",
-	"zangocash.com",
-	"zanox-affiliate.de",
-	"zanox.com",
-	"zantracker.com",
-	"zedo.com",
-	"zencudo.co.uk",
-	"zenkreka.com",
-	"zenzuu.com",
-	"zeus.developershed.com",
-	"zeusclicks.com",
-	"zintext.com",
-	"zmedia.com",
-	"zv1.november-lax.com"
-};
+	// Nothing to do
+}
 
 CefRequestHandler::ReturnValue RequestHandler::OnBeforeResourceLoad(
 	CefRefPtr<CefBrowser> browser,
@@ -2388,20 +21,10 @@ CefRequestHandler::ReturnValue RequestHandler::OnBeforeResourceLoad(
 {
 	if (_blockAds)
 	{
-		// Fetch URL
-		std::string URL = request->GetURL().ToString();
-
-		// Remove unnessary parts from front of URL
-		URL = std::regex_replace(URL, std::regex("(https?://)?"), "");
-		URL = std::regex_replace(URL, std::regex("(www\\.)?"), "");
-
-		// Check for all ad URLs
-		for (const auto& rAdURL : adURLs)
+		// Check host of URL against ad block list
+		if (_adBlockList.Matches(request->GetURL().ToString()))
 		{
-			if (URL.find(rAdURL) != std::string::npos) // does URL contain ad URL?
-			{
-				return RV_CANCEL;
-			}
+			return RV_CANCEL;
 		}
 	}
 
@@ -8,6 +8,7 @@
 #ifndef REQUESTHANDLER_H_
 #define REQUESTHANDLER_H_
 
+#include "src/CEF/AdBlockList.h"
 #include "include/cef_request_handler.h"
 
 
@@ -15,6 +16,9 @@ class RequestHandler : public CefRequestHandler
 {
 public:
 
+	// Constructor, loads ad block list from content folder
+	RequestHandler();
+
 	// Set status
 	void BlockAds(bool value) { _blockAds = value; }
 
@@ -31,6 +35,9 @@ private:
     IMPLEMENT_REFCOUNTING(RequestHandler);
 
 	bool _blockAds = true;
+
+	// List of hosts to block, built once at construction
+	const AdBlockList _adBlockList;
 };
 
 #endif  // REQUESTHANDLER_H_
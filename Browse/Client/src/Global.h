@@ -20,7 +20,7 @@ static const int EYEGUI_SETTINGS_LAYER = -2;
 static const std::string BLANK_PAGE_URL = "about:blank";
 static const int SLOTS_PER_TAB_OVERVIEW_PAGE = 5;
 static const int WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL = 3;
-static const int WEB_TAB_OVERVIEW_PREVIEW_MIP_MAP_LEVEL = 0;
+static const int WEB_TAB_OVERVIEW_PREVIEW_MIP_MAP_LEVEL = 1;
 static const glm::vec4 TAB_DEFAULT_COLOR_ACCENT = glm::vec4(96.f / 255.f, 125.f / 255.f, 139.f / 255.f, 1.f);
 static const int TAB_ACCENT_COLOR_SAMPLING_POINTS = 100;
 static const float TAB_SCROLLING_SENSOR_WIDTH = 0.2f;
@@ -37,10 +37,13 @@ static const float MASTER_PAUSE_ALPHA = 0.35f;
 static const float EYEINPUT_MOUSE_OVERRIDE_INIT_FRAME_DURATION = 0.25f; // duration between mouse movement is expected. Triggered by initial movement
 static const float EYEINPUT_MOUSE_OVERRIDE_INIT_DISTANCE = 100.f; // pixels on screen (not best but works)
 static const float EYEINPUT_MOUSE_OVERRIDE_STOP_DURATION = 1.5f; // duration until override is stopped when no mouse movement done
+static const float EYEINPUT_DROPPED_SAMPLE_LOG_INTERVAL = 1.f; // seconds between reports of samples dropped by eye tracker plugin
 static const std::string LOG_FILE_NAME = "log";
 static const std::string INTERACTION_FILE_NAME = "interaction";
 static const int LOG_FILE_MAX_SIZE = 1024 * 1024;
 static const int LOG_FILE_COUNT = 5;
+static const unsigned int LOG_RING_CAPACITY = 2048; // messages waiting for logging thread, power of two
+static const int LOG_WRITE_INTERVAL = 50; // milliseconds between regular checks of logging thread, errors are written right away
 static const float MOUSE_CURSOR_RELATIVE_SIZE = 0.1f;
 static const glm::vec3 DOM_TRIGGER_DEBUG_COLOR = glm::vec3(0, 1, 0);
 static const glm::vec3 DOM_TEXT_LINKS_DEBUG_COLOR = glm::vec3(0, 0, 1);
@@ -49,7 +52,9 @@ static const glm::vec3 FIXED_ELEMENT_DEBUG_COLOR = glm::vec3(1, 0, 0);
 static const float BLUR_FOCUS_RELATIVE_RADIUS = 0.25f; // relative to smaller of both width or height
 static const float BLUR_PERIPHERY_MULTIPLIER = 0.7f;
 static const std::string BOOKMARKS_FILE = "bookmarks.xml";
-static const std::string HISTORY_FILE = "history.xml";
+static const std::string HISTORY_FILE = "history.xml"; // only read to import history of older versions
+static const std::string HISTORY_JOURNAL_FILE = "history.journal";
+static const std::string FIREBASE_JOURNAL_FILE = "firebase.journal";
 static const std::string SETTINGS_FILE = "settings.xml";
 static const int URL_INPUT_BOOKMARKS_ROWS_ON_SCREEN = 6;
 static const int HISTORY_ROWS_ON_SCREEN = 6;
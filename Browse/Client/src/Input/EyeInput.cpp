@@ -15,7 +15,9 @@ EyeInput::EyeInput(MasterThreadsafeInterface* _pMasterThreadsafeInterface, Eyetr
 		new WeightedAverageFilter(
 			setup::FILTER_KERNEL,
 			setup::FILTER_WINDOW_TIME,
-			setup::FILTER_USE_OUTLIER_REMOVAL)))
+			setup::FILTER_USE_OUTLIER_REMOVAL,
+			setup::FILTER_USE_STREAMING))),
+	_sampleBuffer(EYETRACKER_SAMPLE_BUFFER_CAPACITY)
 {
 	// Create thread for connection to eye tracker
 	_upConnectionThread = std::unique_ptr<std::thread>(new std::thread([this, _pMasterThreadsafeInterface, geometry]()
@@ -63,6 +65,9 @@ EyeInput::EyeInput(MasterThreadsafeInterface* _pMasterThreadsafeInterface, Eyetr
 				// Fetch procedure to pause lab stream
 				_procPauseLabStream = (PAUSE_LAB_STREAM)GetProcAddress(_pluginHandle, "PauseLabStream");
 
+				// Fetch procedure to get count of dropped samples
+				_procGetDroppedSampleCount = (GET_DROPPED_SAMPLE_COUNT)GetProcAddress(_pluginHandle, "GetDroppedSampleCount");
+
 				// Check whether procedures could be loaded
 				if (procConnect != NULL
 					&& _procFetchGazeSamples != NULL
@@ -100,6 +105,7 @@ EyeInput::EyeInput(MasterThreadsafeInterface* _pMasterThreadsafeInterface, Eyetr
 						_procGetTrackboxInfo = NULL;
 						_procContinueLabStream = NULL;
 						_procPauseLabStream = NULL;
+						_procGetDroppedSampleCount = NULL;
 					}
 				}
 			}
@@ -176,6 +182,12 @@ EyeInput::~EyeInput()
 			typedef bool(__cdecl *DISCONNECT)();
 			DISCONNECT procDisconnect = (DISCONNECT)GetProcAddress(_pluginHandle, "Disconnect");
 
+			// Report samples dropped during session
+			if (_procGetDroppedSampleCount != NULL)
+			{
+				LogInfo("EyeInput: Eye tracker dropped ", _procGetDroppedSampleCount(), " samples in total.");
+			}
+
 			// Disconnect eye tracker when procedure available
 			if (procDisconnect != NULL)
 			{
@@ -224,17 +236,27 @@ std::shared_ptr<Input> EyeInput::Update(
 
 	if (_info.connected && _procFetchGazeSamples != NULL && _procIsTracking != NULL)
 	{
-		
-		// Prepare queue to fill
-		SampleQueue spSamples = SampleQueue(new std::deque<SampleData>);
+		// Fetch samples into preallocated buffer (buffer has capacity of plugin's ring, so one call drains it)
+		const int sampleCount = _procFetchGazeSamples(_sampleBuffer.data(), (int)_sampleBuffer.size());
 
-		// Fetch samples
-		_procFetchGazeSamples(spSamples); // shared pointered vector is filled by fetch procedure
+		// Report samples dropped since last report, at most once per interval
+		_droppedSampleLogTime -= tpf;
+		if (_procGetDroppedSampleCount != NULL && _droppedSampleLogTime <= 0.f)
+		{
+			_droppedSampleLogTime = EYEINPUT_DROPPED_SAMPLE_LOG_INTERVAL;
+			const unsigned int droppedSampleCount = _procGetDroppedSampleCount();
+			if (droppedSampleCount != _droppedSampleCount)
+			{
+				LogInfo("EyeInput: Eye tracker dropped ", droppedSampleCount - _droppedSampleCount, " samples, ", droppedSampleCount, " in total since connection.");
+				_droppedSampleCount = droppedSampleCount;
+			}
+		}
 
 		/*
 		// Expecting in screen pixel space
-		for (auto& sample : *spSamples)
+		for (int i = 0; i < sampleCount; i++)
 		{
+			auto& sample = _sampleBuffer[i];
 			switch (sample.system)
 			{
 			case SampleDataCoordinateSystem::SCREEN_PIXELS:
@@ -254,8 +276,10 @@ std::shared_ptr<Input> EyeInput::Update(
 		double windowHeightDouble = (double)windowHeight;
 
 		// Go over available samples and bring into window space
-		for (auto& sample : *spSamples)
+		for (int i = 0; i < sampleCount; i++)
 		{
+			auto& sample = _sampleBuffer[i];
+
 			// Do some clamping according to window coordinates for gaze x
 			sample.x = sample.x - windowXDouble;
 			sample.x = sample.x > 0.0 ? sample.x : 0.0;
@@ -268,7 +292,7 @@ std::shared_ptr<Input> EyeInput::Update(
 		}
 
 		// Update filter algorithm and provide local variables as reference
-		_spFilter->Update(spSamples, _info.samplerate);
+		_spFilter->Update(_sampleBuffer.data(), sampleCount, _info.samplerate);
 
 		// Check, whether eye tracker is tracking
 		isTracking = _procIsTracking();
@@ -24,12 +24,13 @@
 // Necessary for dynamic DLL loading in Windows
 #ifdef _WIN32
 #include <windows.h>
-typedef void(__cdecl *FETCH_SAMPLES)(SampleQueue&);
+typedef int(__cdecl *FETCH_SAMPLES)(SampleData*, int);
 typedef bool(__cdecl *IS_TRACKING)();
 typedef CalibrationResult(__cdecl *CALIBRATE)(std::shared_ptr<CalibrationInfo>&);
 typedef TrackboxInfo(__cdecl *GET_TRACKBOX_INFO)();
 typedef void(__cdecl *CONTINUE_LAB_STREAM)();
 typedef void(__cdecl *PAUSE_LAB_STREAM)();
+typedef unsigned int(__cdecl *GET_DROPPED_SAMPLE_COUNT)();
 #endif
 
 class EyeInput
@@ -100,6 +101,9 @@ private:
 
 	// Handle to pause lab stream
 	PAUSE_LAB_STREAM _procPauseLabStream = NULL;
+
+	// Handle to get count of dropped samples (optional)
+	GET_DROPPED_SAMPLE_COUNT _procGetDroppedSampleCount = NULL;
 #endif // _WIN32
 
 	// Info about eye tracking device
@@ -122,6 +126,15 @@ private:
 
 	// Filter of gaze data
 	std::shared_ptr<Filter> _spFilter;
+
+	// Preallocated buffer which is filled by plugin with fetched samples each frame
+	std::vector<SampleData> _sampleBuffer;
+
+	// Count of samples dropped by plugin since connection as known to the log
+	unsigned int _droppedSampleCount = 0;
+
+	// Time until count of dropped samples is checked again
+	float _droppedSampleLogTime = EYEINPUT_DROPPED_SAMPLE_LOG_INTERVAL;
 };
 
 #endif // EYEINPUT_H_
\ No newline at end of file
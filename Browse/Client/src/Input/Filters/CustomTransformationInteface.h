@@ -8,17 +8,31 @@
 #ifndef CUSTOMTRANSFORMATIONINTERFACE_H_
 #define CUSTOMTRANSFORMATIONINTERFACE_H_
 
+#include "src/Utils/glmWrapper.h"
 #include <functional>
+#include <string>
 
 // Typedef for custom transformation
 typedef std::function<void(double&, double&)> FilterTransformation;
 
+// Affine custom transformation. Samples are clamped to the given rectangle (if any) and then
+// multiplied as homogeneous coordinate with the matrix. Applied to many samples at once
+struct FilterAffineTransformation
+{
+	glm::dmat3 matrix = glm::dmat3(1.0);
+	bool clamp = false;
+	glm::dvec2 clampMin = glm::dvec2(0, 0);
+	glm::dvec2 clampMax = glm::dvec2(0, 0);
+};
+
 // Interface
 class CustomTransformationInterface
 {
 public:
 	virtual bool RegisterCustomTransformation(std::string name, FilterTransformation transformation) = 0;																			 
 	virtual bool ChangeCustomTransformation(std::string name, FilterTransformation transformation) = 0;
+	virtual bool RegisterCustomTransformation(std::string name, FilterAffineTransformation transformation) = 0;
+	virtual bool ChangeCustomTransformation(std::string name, FilterAffineTransformation transformation) = 0;
 	virtual bool UnregisterCustomTransformation(std::string name) = 0;
 	virtual double GetFilteredGazeX(std::string name) const = 0;
 	virtual double GetFilteredGazeY(std::string name) const = 0;
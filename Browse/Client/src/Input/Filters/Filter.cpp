@@ -10,7 +10,7 @@
 #include <algorithm>
 
 Filter::Filter() :
-	_spSamples(SampleQueue(new std::deque<SampleData>))
+	_samples(setup::FILTER_MEMORY_SIZE)
 {
 	// Nothing to do
 }
@@ -20,77 +20,54 @@ Filter::~Filter()
 	// For the sake of the C++ standard
 }
 
-void Filter::Update(const SampleQueue spSamples, float samplerate)
+void Filter::Update(const SampleData* pSamples, int count, float samplerate)
 {
-	// Only work with non-empty sample queue
-	if (!spSamples->empty())
+	// Remember samplerate for lazy evaluation of custom transformations
+	_samplerate = samplerate;
+
+	// Only work with non-empty sample array
+	if (count > 0)
 	{
 		// Update timestamp
-		_timestamp = spSamples->back().timestamp; // should be newest sample
+		_timestamp = pSamples[count - 1].timestamp; // should be newest sample
 		_timestampSetOnce = true;
 	}
 
-	// Copy samples over to member
-	_spSamples->insert(_spSamples->end(),
-		spSamples->begin(),
-		spSamples->end());
-	
-	// Delete front of queue to match maximum allowed queue length (delete oldest samples)
-	int size = (int)_spSamples->size(); // sample queue size
-	int overlap = size - setup::FILTER_MEMORY_SIZE;
-	for (int i = 0; i < overlap; i++)
-	{
-		_spSamples->pop_front();
-	}
+	// Copy samples over to member, oldest samples are dropped to match maximum allowed memory size
+	const long long previousCount = _samples.GetTotalCount();
+	_samples.Push(pSamples, count);
 
 	// Apply filtering to retrieve current filtered gaze coordinate and other information
-	ApplyFilter(_spSamples, _gazeX, _gazeY, _fixationDuration, samplerate);
-
-	// Work on custom transformations
-	for (auto& rCustomTransformation : _customTransformations)
+	if (_spStream)
 	{
-		// Make reference on custom transformation within map
-		auto& rTrans = rCustomTransformation.second;
-
-		// Copy current samples and apply current transformation
-		std::deque<SampleData> tmpQueue;
-		tmpQueue.insert(tmpQueue.end(),
-			spSamples->begin(),
-			spSamples->end());
-		for (auto& rSample : tmpQueue)
+		// Restart stream if more samples arrived than fit into memory
+		const long long front = _samples.GetFrontIndex();
+		if (previousCount < front)
 		{
-			rTrans.transformation(rSample.x, rSample.y);
+			_spStream = CreateStream();
 		}
 
-		// Move samples to queue
-		rTrans.queue->insert(rTrans.queue->end(),
-			std::make_move_iterator(tmpQueue.begin()),
-			std::make_move_iterator(tmpQueue.end()));
-
-		// Delete front of queue to match maximum allowed queue length (delete oldest samples)
-		size = (int)rTrans.queue->size(); // sample queue size
-		overlap = size - setup::FILTER_MEMORY_SIZE;
-		for (int i = 0; i < overlap; i++)
+		// Push new samples to stream
+		_samples.ForEachRun(std::max(previousCount, front), _samples.GetTotalCount(),
+			[&](const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int runCount)
 		{
-			rTrans.queue->pop_front();
-		}
-
-		// Apply filtering
-		float fixationDuration = 0; // not used
-		ApplyFilter(
-			rTrans.queue,
-			rTrans.gazeX,
-			rTrans.gazeY,
-			fixationDuration,
-			samplerate);
+			_spStream->Push(pX, pY, pTimestamps, runCount, samplerate);
+		});
+		_spStream->Apply(_gazeX, _gazeY, _fixationDuration);
+	}
+	else
+	{
+		ApplyFilter(_samples, _gazeX, _gazeY, _fixationDuration, samplerate);
 	}
+
+	// Custom transformations are evaluated lazily when their filtered gaze is retrieved
 }
 
 double Filter::GetRawGazeX() const
 {
-	if (!_spSamples->empty())
+	if (!_samples.IsEmpty())
 	{
-		return _spSamples->back().x;
+		return _samples.GetX(_samples.GetSize() - 1);
 	}
 	else
 	{
@@ -100,9 +77,9 @@ double Filter::GetRawGazeX() const
 
 double Filter::GetRawGazeY() const
 {
-	if (!_spSamples->empty())
+	if (!_samples.IsEmpty())
 	{
-		return _spSamples->back().y;
+		return _samples.GetY(_samples.GetSize() - 1);
 	}
 	else
 	{
@@ -147,36 +124,60 @@ bool Filter::IsTimestampSetOnce() const
 bool Filter::RegisterCustomTransformation(std::string name, FilterTransformation transformation)
 {
 	// Check whether custom transformation already exists
-	auto it = _customTransformations.find(name);
-	if (it == _customTransformations.end())
+	if (_customTransformations.find(name) == _customTransformations.end())
 	{
 		// Create and fill structure
 		CustomTransformation trans; // create struct
 		trans.transformation = transformation; // set transformation
-		trans.queue = SampleQueue(new std::deque<SampleData>(*_spSamples.get())); // deep copy of sample data
-
-		// Apply transformation on already retrieved samples
-		for (auto& rSample : *trans.queue.get())
-		{
-			trans.transformation(rSample.x, rSample.y);
-		}
+		InsertCustomTransformation(name, trans);
+		return true;
+	}
+	return false;
+}
 
-		// Insert this custom transformation
-		_customTransformations.insert(std::make_pair(
-			name,
-			trans
-		));
+bool Filter::RegisterCustomTransformation(std::string name, FilterAffineTransformation transformation)
+{
+	// Check whether custom transformation already exists
+	if (_customTransformations.find(name) == _customTransformations.end())
+	{
+		// Create and fill structure
+		CustomTransformation trans; // create struct
+		trans.affineTransformation = transformation; // set transformation
+		trans.affine = true;
+		InsertCustomTransformation(name, trans);
 		return true;
 	}
 	return false;
 }
 
+void Filter::EnableStreaming()
+{
+	_spStream = CreateStream();
+}
+
 bool Filter::ChangeCustomTransformation(std::string name, FilterTransformation transformation)
 {
 	auto it = _customTransformations.find(name);
 	if (it != _customTransformations.end())
 	{
+		// Samples retrieved so far are transformed with previous transformation
+		TransformCustomTransformation(it->second);
 		it->second.transformation = transformation;
+		it->second.affine = false;
+		return true;
+	}
+	return false;
+}
+
+bool Filter::ChangeCustomTransformation(std::string name, FilterAffineTransformation transformation)
+{
+	auto it = _customTransformations.find(name);
+	if (it != _customTransformations.end())
+	{
+		// Samples retrieved so far are transformed with previous transformation
+		TransformCustomTransformation(it->second);
+		it->second.affineTransformation = transformation;
+		it->second.affine = true;
 		return true;
 	}
 	return false;
@@ -199,10 +200,138 @@ bool Filter::UnregisterCustomTransformation(std::string name)
 
 double Filter::GetFilteredGazeX(std::string name) const
 {
-	return _customTransformations.at(name).gazeX;
+	auto& rTrans = _customTransformations.at(name);
+	EvaluateCustomTransformation(rTrans);
+	return rTrans.gazeX;
 }
 
 double Filter::GetFilteredGazeY(std::string name) const
 {
-	return _customTransformations.at(name).gazeY;
+	auto& rTrans = _customTransformations.at(name);
+	EvaluateCustomTransformation(rTrans);
+	return rTrans.gazeY;
+}
+
+void Filter::InsertCustomTransformation(std::string name, CustomTransformation transformation)
+{
+	// Memory for transformed samples is only necessary when filtering whole window each time
+	if (_spStream)
+	{
+		transformation.spStream = CreateStream();
+	}
+	else
+	{
+		transformation.samples = FilterSampleStore(setup::FILTER_MEMORY_SIZE);
+	}
+
+	// Existing samples are transformed at first evaluation
+	transformation.processedCount = _samples.GetFrontIndex();
+	_customTransformations.insert(std::make_pair(name, transformation));
+}
+
+void Filter::TransformCustomTransformation(CustomTransformation& rTrans) const
+{
+	const long long end = _samples.GetTotalCount();
+	if (rTrans.processedCount == end) { return; } // nothing new
+
+	// Restart when samples have been dropped from memory before being processed
+	const long long front = _samples.GetFrontIndex();
+	if (rTrans.processedCount < front)
+	{
+		if (rTrans.spStream)
+		{
+			rTrans.spStream = CreateStream();
+		}
+		else
+		{
+			rTrans.samples.Clear();
+		}
+		rTrans.processedCount = front;
+	}
+
+	// Transform new samples run by run
+	_samples.ForEachRun(rTrans.processedCount, end,
+		[&](const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count)
+	{
+		// Buffers are only allocated once as runs are never longer than memory
+		_transformedX.resize(count);
+		_transformedY.resize(count);
+		double* pOutX = _transformedX.data();
+		double* pOutY = _transformedY.data();
+
+		if (rTrans.affine)
+		{
+			// Simple loops over contiguous arrays, which the compiler can vectorize
+			const auto& rAffine = rTrans.affineTransformation;
+			const double m00 = rAffine.matrix[0][0], m01 = rAffine.matrix[1][0], m02 = rAffine.matrix[2][0];
+			const double m10 = rAffine.matrix[0][1], m11 = rAffine.matrix[1][1], m12 = rAffine.matrix[2][1];
+			if (rAffine.clamp)
+			{
+				const double minX = rAffine.clampMin.x, maxX = rAffine.clampMax.x;
+				const double minY = rAffine.clampMin.y, maxY = rAffine.clampMax.y;
+				for (int i = 0; i < count; i++)
+				{
+					const double x = std::min(std::max(pX[i], minX), maxX);
+					const double y = std::min(std::max(pY[i], minY), maxY);
+					pOutX[i] = m00 * x + m01 * y + m02;
+					pOutY[i] = m10 * x + m11 * y + m12;
+				}
+			}
+			else
+			{
+				for (int i = 0; i < count; i++)
+				{
+					pOutX[i] = m00 * pX[i] + m01 * pY[i] + m02;
+					pOutY[i] = m10 * pX[i] + m11 * pY[i] + m12;
+				}
+			}
+		}
+		else
+		{
+			for (int i = 0; i < count; i++)
+			{
+				pOutX[i] = pX[i];
+				pOutY[i] = pY[i];
+				rTrans.transformation(pOutX[i], pOutY[i]);
+			}
+		}
+
+		// Hand transformed samples over
+		if (rTrans.spStream)
+		{
+			rTrans.spStream->Push(pOutX, pOutY, pTimestamps, count, _samplerate);
+		}
+		else
+		{
+			rTrans.samples.Push(pOutX, pOutY, pTimestamps, count);
+		}
+	});
+
+	rTrans.processedCount = end;
+	rTrans.dirty = true;
+}
+
+void Filter::EvaluateCustomTransformation(CustomTransformation& rTrans) const
+{
+	// Make sure all retrieved samples are transformed
+	TransformCustomTransformation(rTrans);
+
+	// Filter only once per new samples, otherwise filtered values are cached
+	if (rTrans.dirty)
+	{
+		if (rTrans.spStream)
+		{
+			rTrans.spStream->Apply(rTrans.gazeX, rTrans.gazeY, rTrans.fixationDuration);
+		}
+		else
+		{
+			ApplyFilter(
+				rTrans.samples,
+				rTrans.gazeX,
+				rTrans.gazeY,
+				rTrans.fixationDuration,
+				_samplerate);
+		}
+		rTrans.dirty = false;
+	}
 }
\ No newline at end of file
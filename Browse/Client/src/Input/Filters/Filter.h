@@ -8,9 +8,26 @@
 #define FILTER_H_
 
 #include "src/Input/Filters/CustomTransformationInteface.h"
+#include "src/Input/Filters/FilterSampleStore.h"
 #include "plugins/Eyetracker/Interface/EyetrackerSample.h"
 #include <map>
+#include <memory>
 
+// Incrementally updated state of a streaming filter for one stream of samples.
+// Pushed samples must match the samples appended to the memory of the filter
+class FilterStream
+{
+public:
+
+	// Destructor
+	virtual ~FilterStream() {}
+
+	// Append new samples in window pixel coordinates
+	virtual void Push(const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count, float samplerate) = 0;
+
+	// Retrieve filtered gaze of pushed samples. Same contract as ApplyFilter of filter
+	virtual void Apply(double& rGazeX, double& rGazeY, float& rFixationDuration) const = 0;
+};
 
 // Filter class
 class Filter : public CustomTransformationInterface
@@ -23,8 +40,8 @@ public:
 	// Destructor
 	virtual ~Filter() = 0;
 
-	// Update. Takes samples in window pixel coordinates and samplerate of eye tracking device
-	void Update(const SampleQueue spSamples, float samplerate);
+	// Update. Takes array of new samples in window pixel coordinates and samplerate of eye tracking device
+	void Update(const SampleData* pSamples, int count, float samplerate);
 
 	// Various getters
 	double GetRawGazeX() const;
@@ -44,12 +61,15 @@ public:
 	// #######################################
 
 	// Register custom transformation of gaze before filtering (smooth pursuit fixation).
-	// For each custom transformation, retrieved samples are transformed with provided transformation and stored.
-	// At registration, provided transformation is applied on all existing samples after copying them
+	// Raw samples are stored only once. Each custom transformation is a view on them, which transforms
+	// and filters new samples lazily, when its filtered gaze is retrieved or its transformation changed.
+	// At registration, provided transformation is applied on all existing samples
 	bool RegisterCustomTransformation(std::string name, FilterTransformation transformation) override; // return whether successful
+	bool RegisterCustomTransformation(std::string name, FilterAffineTransformation transformation) override; // return whether successful
 
 	// Set transformation for incoming gaze data for the named custom transformation
 	bool ChangeCustomTransformation(std::string name, FilterTransformation transformation) override;
+	bool ChangeCustomTransformation(std::string name, FilterAffineTransformation transformation) override;
 
 	// Unregister custom transformation
 	bool UnregisterCustomTransformation(std::string name) override;
@@ -60,10 +80,19 @@ public:
 
 	// #######################################
 
+protected:
+
+	// Create streams for sample queue and custom transformations. Call from constructor of
+	// filter implementation, as stream creation is virtual
+	void EnableStreaming();
+
 private:
 
 	// Actual implementation of filtering
-	virtual void ApplyFilter(const SampleQueue& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const = 0;
+	virtual void ApplyFilter(const FilterSampleStore& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const = 0;
+
+	// Create stream for incremental filtering. Filter is applied on whole sample queue each frame if not supported
+	virtual std::shared_ptr<FilterStream> CreateStream() const { return nullptr; }
 
 	// Timestamp of last sample
 	std::chrono::milliseconds _timestamp;
@@ -71,20 +100,47 @@ private:
 	// Bool whether timestamp was set at least once (aka at least one sample received)
 	bool _timestampSetOnce = false;
 
+	// Samplerate of last update
+	float _samplerate = 0;
+
 	// Samples to filter
-	SampleQueue _spSamples; // samples as delivered by eye tracker / EyeInput class
+	FilterSampleStore _samples; // samples as delivered by eye tracker / EyeInput class
+
+	// Stream of samples when streaming is enabled, otherwise nullptr
+	std::shared_ptr<FilterStream> _spStream;
 
 	// Values per custom transformations
 	struct CustomTransformation
 	{
+		// Constructor
+		CustomTransformation() : samples(0) {}
+
 		// Fields
-		FilterTransformation transformation;
-		SampleQueue queue;
+		FilterTransformation transformation; // used when not affine
+		FilterAffineTransformation affineTransformation;
+		bool affine = false;
+		long long processedCount = 0; // count of raw samples transformed so far
+		bool dirty = false; // whether transformed samples have not been filtered yet
+		std::shared_ptr<FilterStream> spStream; // nullptr if streaming not enabled
+		FilterSampleStore samples; // transformed samples, only used when streaming not enabled
 		double gazeX = -1;
 		double gazeY = -1;
 		float fixationDuration = 0;
 	};
-	std::map<std::string, CustomTransformation> _customTransformations;
+	mutable std::map<std::string, CustomTransformation> _customTransformations; // lazily updated when filtered gaze is retrieved
+
+	// Insert new custom transformation and apply it to existing samples
+	void InsertCustomTransformation(std::string name, CustomTransformation transformation);
+
+	// Transform samples that arrived since last call with current transformation
+	void TransformCustomTransformation(CustomTransformation& rTrans) const;
+
+	// Transform and filter samples that arrived since last evaluation, otherwise keep cached values
+	void EvaluateCustomTransformation(CustomTransformation& rTrans) const;
+
+	// Buffers for transformed samples, reused by all custom transformations
+	mutable std::vector<double> _transformedX;
+	mutable std::vector<double> _transformedY;
 
 	// Filtered stuff
 	double _gazeX = -1; // filtered
@@ -0,0 +1,42 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "FilterSampleStore.h"
+
+FilterSampleStore::FilterSampleStore(int capacity) :
+	_capacity(capacity),
+	_x(capacity),
+	_y(capacity),
+	_timestamps(capacity)
+{
+	// Nothing to do
+}
+
+void FilterSampleStore::Push(const SampleData* pSamples, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		const int slot = Slot(_totalCount++);
+		_x[slot] = pSamples[i].x;
+		_y[slot] = pSamples[i].y;
+		_timestamps[slot] = pSamples[i].timestamp;
+	}
+}
+
+void FilterSampleStore::Push(const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count)
+{
+	for (int i = 0; i < count; i++)
+	{
+		const int slot = Slot(_totalCount++);
+		_x[slot] = pX[i];
+		_y[slot] = pY[i];
+		_timestamps[slot] = pTimestamps[i];
+	}
+}
+
+void FilterSampleStore::Clear()
+{
+	_totalCount = 0;
+}
@@ -0,0 +1,71 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Fixed-capacity memory of gaze samples as structure of arrays. Samples can be
+// accessed either relative to the oldest sample in memory (like a queue) or by
+// their absolute index, which counts all samples ever pushed.
+
+#ifndef FILTERSAMPLESTORE_H_
+#define FILTERSAMPLESTORE_H_
+
+#include "plugins/Eyetracker/Interface/EyetrackerSample.h"
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+class FilterSampleStore
+{
+public:
+
+	// Constructor
+	FilterSampleStore(int capacity);
+
+	// Append samples, oldest samples are overwritten when capacity is exceeded
+	void Push(const SampleData* pSamples, int count);
+	void Push(const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count);
+
+	// Remove all samples
+	void Clear();
+
+	// Count of samples in memory
+	int GetSize() const { return (int)(_totalCount - GetFrontIndex()); }
+	bool IsEmpty() const { return _totalCount == GetFrontIndex(); }
+
+	// Access relative to oldest sample in memory. Index must be in [0..size-1]
+	double GetX(int i) const { return _x[Slot(GetFrontIndex() + i)]; }
+	double GetY(int i) const { return _y[Slot(GetFrontIndex() + i)]; }
+	std::chrono::milliseconds GetTimestamp(int i) const { return _timestamps[Slot(GetFrontIndex() + i)]; }
+
+	// Absolute index of oldest sample in memory and count of all samples ever pushed
+	long long GetFrontIndex() const { return _totalCount > _capacity ? _totalCount - _capacity : 0; }
+	long long GetTotalCount() const { return _totalCount; }
+
+	// Call function for each contiguous run of samples in absolute index range [begin, end).
+	// Function takes pointers to x, y and timestamps and count of samples in run
+	template<typename Function>
+	void ForEachRun(long long begin, long long end, Function function) const
+	{
+		while (begin < end)
+		{
+			const int slot = Slot(begin);
+			const int count = (int)std::min((long long)(_capacity - slot), end - begin);
+			function(&_x[slot], &_y[slot], &_timestamps[slot], count);
+			begin += count;
+		}
+	}
+
+private:
+
+	// Slot in storage of absolute index
+	int Slot(long long index) const { return (int)(index % _capacity); }
+
+	// Members
+	int _capacity;
+	std::vector<double> _x;
+	std::vector<double> _y;
+	std::vector<std::chrono::milliseconds> _timestamps;
+	long long _totalCount = 0;
+};
+
+#endif // FILTERSAMPLESTORE_H_
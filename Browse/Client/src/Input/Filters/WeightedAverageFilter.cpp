@@ -4,24 +4,47 @@
 //============================================================================
 
 #include "WeightedAverageFilter.h"
+#include "src/Input/Filters/WeightedAverageStream.h"
 #include "src/Utils/Helper.h"
 #include "src/Setup.h"
 
 #include <iostream>
 
-WeightedAverageFilter::WeightedAverageFilter(FilterKernel kernel, float windowTime, bool outlierRemoval) :
-	_kernel(kernel), _windowTime(windowTime), _outlierRemoval(outlierRemoval) {}
+WeightedAverageFilter::WeightedAverageFilter(FilterKernel kernel, float windowTime, bool outlierRemoval, bool streaming) :
+	_kernel(kernel), _windowTime(windowTime), _outlierRemoval(outlierRemoval)
+{
+	if (streaming)
+	{
+		EnableStreaming();
+	}
+}
+
+void WeightedAverageFilter::ComputeWeights(FilterKernel kernel, int windowSize, std::vector<double>& rWeights)
+{
+	rWeights.resize(glm::max(0, windowSize));
+	for (int i = 0; i < (int)rWeights.size(); i++)
+	{
+		rWeights[i] = CalculateWeight(kernel, (unsigned int)i, windowSize);
+	}
+}
 
-void WeightedAverageFilter::ApplyFilter(const SampleQueue& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const
+void WeightedAverageFilter::ApplyFilter(const FilterSampleStore& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const
 {
 	// Prepare variables
 	double sumX = 0;
 	double sumY = 0;
 	double weightSum = 0;
 	int windowSize = glm::ceil(_windowTime * samplerate);
-	
+
+	// Update weights if window size changed
+	if (windowSize != _weightsWindowSize)
+	{
+		ComputeWeights(_kernel, windowSize, _weights);
+		_weightsWindowSize = windowSize;
+	}
+
 	// Indexing
-	const int size = (int)rSamples->size();
+	const int size = rSamples.GetSize();
 	int endIndex = glm::max(0, size - windowSize);
 	int startIndex = size - 1;
 
@@ -41,16 +64,16 @@ void WeightedAverageFilter::ApplyFilter(const SampleQueue& rSamples, double& rGa
 	for(int i = startIndex; i >= endIndex; --i) // latest to oldest means reverse order in queue
 	{
 		// Get current sample
-		const auto& rGaze = rSamples->at(i);
+		const glm::vec2 gaze(rSamples.GetX(i), rSamples.GetY(i));
 
 		// Saccade detection
 		if (i < size - 1) // only proceed when there is a previous sample to check against
 		{
 			// Check distance of current sample and previously filtered one
-			const auto& prevGaze = rSamples->at(i + 1); // in terms of time, prevGaze is newer than gaze
+			const glm::vec2 prevGaze(rSamples.GetX(i + 1), rSamples.GetY(i + 1)); // in terms of time, prevGaze is newer than gaze
 			if (glm::distance(
-				glm::vec2(prevGaze.x, prevGaze.y),
-				glm::vec2(rGaze.x, rGaze.y))
+				prevGaze,
+				gaze)
 				> setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS)
 			{
 				if (_outlierRemoval) // check whether to ignore this as outlier or really breaking
@@ -58,10 +81,10 @@ void WeightedAverageFilter::ApplyFilter(const SampleQueue& rSamples, double& rGa
 					int nextIndex = i - 1; // index of next sample to filter (which is older than current)
 					if (nextIndex >= 0)
 					{
-						const auto& nextGaze = rSamples->at(nextIndex);
+						const glm::vec2 nextGaze(rSamples.GetX(nextIndex), rSamples.GetY(nextIndex));
 						if (glm::distance(
-							glm::vec2(prevGaze.x, prevGaze.y),
-							glm::vec2(nextGaze.x, nextGaze.y))
+							prevGaze,
+							nextGaze)
 							> setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS)
 						{
 							break; // previous and next sample do not belong to the same fixation, so this sample is start of new fixation
@@ -85,11 +108,11 @@ void WeightedAverageFilter::ApplyFilter(const SampleQueue& rSamples, double& rGa
 		}
 
 		// Calculate weight
-		double weight = CalculateWeight(weightIndex, windowSize);
+		double weight = _weights[weightIndex];
 
 		// Sum values
-		sumX += rGaze.x * weight;
-		sumY += rGaze.y * weight;
+		sumX += rSamples.GetX(i) * weight;
+		sumY += rSamples.GetY(i) * weight;
 
 		// Sum weight for later normalization
 		weightSum += weight;
@@ -110,14 +133,19 @@ void WeightedAverageFilter::ApplyFilter(const SampleQueue& rSamples, double& rGa
 		rGazeY = sumY / weightSum;
 
 		// Calculate fixation duration (duration from now to receiving of oldest sample contributing to fixation)
-		fixationDuration = (float)((double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch() - rSamples->at(oldestUsedIndex).timestamp).count() / 1000.0);
+		fixationDuration = (float)((double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch() - rSamples.GetTimestamp(oldestUsedIndex)).count() / 1000.0);
 	}
 	rFixationDuration = fixationDuration; // update fixation duration
 }
 
-double WeightedAverageFilter::CalculateWeight(unsigned int i, int windowSize) const
+std::shared_ptr<FilterStream> WeightedAverageFilter::CreateStream() const
+{
+	return std::make_shared<WeightedAverageStream>(_kernel, _windowTime, _outlierRemoval);
+}
+
+double WeightedAverageFilter::CalculateWeight(FilterKernel kernel, unsigned int i, int windowSize)
 {
-	switch (_kernel)
+	switch (kernel)
 	{
 	case FilterKernel::LINEAR:
 		return 1.0;
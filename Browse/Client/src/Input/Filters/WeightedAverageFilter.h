@@ -12,6 +12,7 @@
 
 #include "src/Input/Filters/Filter.h"
 #include "src/Input/Filters/FilterKernel.h"
+#include <vector>
 
 class WeightedAverageFilter : public Filter
 {
@@ -21,21 +22,32 @@ public:
 	WeightedAverageFilter(
 		FilterKernel kernel, // type of weights used
 		float windowTime, // time of window from which samples are taken for filtering
-		bool outlierRemoval); // whether outlier detection is used, delays input by one sample
+		bool outlierRemoval, // whether outlier detection is used, delays input by one sample
+		bool streaming); // whether only new samples are processed each update instead of whole window
+
+	// Fill table with weight for each "oldness" of sample in interval [0..windowSize-1]
+	static void ComputeWeights(FilterKernel kernel, int windowSize, std::vector<double>& rWeights);
 
 private:
 
 	// Actual implementation of filtering
-	void ApplyFilter(const SampleQueue& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const override;
+	void ApplyFilter(const FilterSampleStore& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration, float samplerate) const override;
+
+	// Create stream for incremental filtering
+	std::shared_ptr<FilterStream> CreateStream() const override;
 
 	// Calulcate weight for a sample. Takes "oldness" of sample.
 	// Interval must be [0..windowSize-1]
-	double CalculateWeight(unsigned int i, int windowSize) const;
+	static double CalculateWeight(FilterKernel kernel, unsigned int i, int windowSize);
 
 	// Members
 	FilterKernel _kernel;
 	float _windowTime;
 	bool _outlierRemoval;
+
+	// Weights of last used window size, as sigma of gaussian kernel only depends on it
+	mutable std::vector<double> _weights;
+	mutable int _weightsWindowSize = -1;
 };
 
 #endif WEIGHTEDAVERAGEFILTER_H_
\ No newline at end of file
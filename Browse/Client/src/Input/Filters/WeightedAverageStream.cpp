@@ -0,0 +1,237 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "WeightedAverageStream.h"
+#include "src/Input/Filters/WeightedAverageFilter.h"
+#include "src/Setup.h"
+#include "src/Utils/glmWrapper.h"
+
+WeightedAverageStream::WeightedAverageStream(FilterKernel kernel, float windowTime, bool outlierRemoval) :
+	_kernel(kernel),
+	_windowTime(windowTime),
+	_outlierRemoval(outlierRemoval),
+	_capacity(setup::FILTER_MEMORY_SIZE + 1), // one more than memory of filter, so lower bound stays accessible
+	_x(_capacity),
+	_y(_capacity),
+	_timestamps(_capacity),
+	_status(_capacity, SampleStatus::UNKNOWN),
+	_used(_capacity)
+{
+	// Nothing to do
+}
+
+void WeightedAverageStream::Push(const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count, float samplerate)
+{
+	// Update window size and rebuild used samples if it changed
+	int windowSize = (int)glm::ceil(_windowTime * samplerate);
+	if (windowSize != _windowSize)
+	{
+		_windowSize = windowSize;
+		WeightedAverageFilter::ComputeWeights(_kernel, _windowSize, _weights);
+		Rebuild();
+	}
+
+	// Push samples one by one
+	for (int i = 0; i < count; i++)
+	{
+		PushSingle(pX[i], pY[i], pTimestamps[i]);
+	}
+}
+
+void WeightedAverageStream::Apply(double& rGazeX, double& rGazeY, float& rFixationDuration) const
+{
+	// Without outlier removal, latest sample is used regardless of its classification
+	const bool useLatest = !_outlierRemoval && _count > 0 && _windowSize > 0;
+	const long long latest = _count - 1;
+	const int usedCount = (int)(_usedEnd - _usedBegin);
+
+	// Nothing to filter
+	if (usedCount == 0 && !useLatest)
+	{
+		rFixationDuration = 0;
+		return;
+	}
+
+	// Accumulate weighted sum
+	double sumX = 0;
+	double sumY = 0;
+	double weightSum = 0;
+	switch (_kernel)
+	{
+	case FilterKernel::LINEAR:
+		sumX = _sumX;
+		sumY = _sumY;
+		weightSum = usedCount;
+		if (useLatest)
+		{
+			sumX += _x[Slot(latest)];
+			sumY += _y[Slot(latest)];
+			weightSum += 1.0;
+		}
+		break;
+	case FilterKernel::TRIANGULAR:
+	{
+		// Weight of rank is window size minus rank
+		const double size = _windowSize;
+		const double n = usedCount;
+		if (useLatest) // used samples are shifted by one rank
+		{
+			sumX = size * _x[Slot(latest)] + (size - 1.0) * _sumX - _rankSumX;
+			sumY = size * _y[Slot(latest)] + (size - 1.0) * _sumY - _rankSumY;
+			weightSum = size + n * size - (n * (n + 1.0)) / 2.0;
+		}
+		else
+		{
+			sumX = size * _sumX - _rankSumX;
+			sumY = size * _sumY - _rankSumY;
+			weightSum = n * size - (n * (n - 1.0)) / 2.0;
+		}
+		break;
+	}
+	case FilterKernel::GAUSSIAN:
+	{
+		int rank = 0;
+		if (useLatest)
+		{
+			sumX += _weights[rank] * _x[Slot(latest)];
+			sumY += _weights[rank] * _y[Slot(latest)];
+			weightSum += _weights[rank];
+			++rank;
+		}
+		for (long long i = _usedEnd - 1; i >= _usedBegin; --i, ++rank)
+		{
+			const int slot = Slot(_used[(int)(i % _capacity)]);
+			sumX += _weights[rank] * _x[slot];
+			sumY += _weights[rank] * _y[slot];
+			weightSum += _weights[rank];
+		}
+		break;
+	}
+	}
+
+	// Filter gaze
+	rGazeX = sumX / weightSum;
+	rGazeY = sumY / weightSum;
+
+	// Calculate fixation duration (duration from now to receiving of oldest sample contributing to fixation)
+	const long long oldest = usedCount > 0 ? _used[(int)(_usedBegin % _capacity)] : latest;
+	rFixationDuration = (float)((double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch() - _timestamps[Slot(oldest)]).count() / 1000.0);
+}
+
+void WeightedAverageStream::PushSingle(double x, double y, std::chrono::milliseconds timestamp)
+{
+	// Store sample
+	const long long index = _count++;
+	const int slot = Slot(index);
+	_x[slot] = x;
+	_y[slot] = y;
+	_timestamps[slot] = timestamp;
+	_status[slot] = SampleStatus::UNKNOWN;
+
+	// Classify predecessor, now that its newer neighbor is known
+	const long long previous = index - 1;
+	if (previous >= 0)
+	{
+		SampleStatus status = SampleStatus::USE;
+		if (Far(index, previous))
+		{
+			// Outlier if its neighbors belong to the same fixation
+			status = (_outlierRemoval && previous - 1 >= 0 && !Far(index, previous - 1)) ? SampleStatus::SKIP : SampleStatus::BREAK;
+		}
+		_status[Slot(previous)] = status;
+		Process(previous);
+	}
+
+	// Remove samples that left the window
+	Trim();
+}
+
+void WeightedAverageStream::Process(long long index)
+{
+	switch (_status[Slot(index)])
+	{
+	case SampleStatus::BREAK:
+		ResetUsed(); // start of new fixation, older samples are not used anymore
+		_bottom = index;
+		break;
+	case SampleStatus::USE:
+		if (index > _bottom) { AddUsed(index); }
+		break;
+	default:
+		break;
+	}
+}
+
+void WeightedAverageStream::Trim()
+{
+	// Lowest index within memory of filter and within window
+	const long long front = glm::max(0ll, _count - (long long)setup::FILTER_MEMORY_SIZE);
+	const long long windowFront = _count - _windowSize - (_outlierRemoval ? 1 : 0); // latest sample is not in window with outlier removal
+	const long long bottom = glm::max(front, windowFront) - 1;
+
+	// Move lower bound
+	while (_bottom < bottom)
+	{
+		++_bottom;
+		if (_usedEnd > _usedBegin && _used[(int)(_usedBegin % _capacity)] == _bottom)
+		{
+			RemoveOldestUsed();
+		}
+	}
+}
+
+void WeightedAverageStream::Rebuild()
+{
+	ResetUsed();
+	const long long front = glm::max(0ll, _count - (long long)setup::FILTER_MEMORY_SIZE);
+	_bottom = front - 1;
+	for (long long i = front; i < _count - 1; i++) // latest sample is not classified yet
+	{
+		Process(i);
+	}
+	Trim();
+}
+
+void WeightedAverageStream::AddUsed(long long index)
+{
+	// Ranks of all used samples increase by one, new sample gets rank zero
+	_rankSumX += _sumX;
+	_rankSumY += _sumY;
+	_sumX += _x[Slot(index)];
+	_sumY += _y[Slot(index)];
+	_used[(int)(_usedEnd % _capacity)] = index;
+	++_usedEnd;
+}
+
+void WeightedAverageStream::RemoveOldestUsed()
+{
+	// Oldest used sample has highest rank
+	const double rank = (double)(_usedEnd - _usedBegin - 1);
+	const int slot = Slot(_used[(int)(_usedBegin % _capacity)]);
+	_rankSumX -= rank * _x[slot];
+	_rankSumY -= rank * _y[slot];
+	_sumX -= _x[slot];
+	_sumY -= _y[slot];
+	++_usedBegin;
+}
+
+void WeightedAverageStream::ResetUsed()
+{
+	_usedBegin = _usedEnd;
+	_sumX = 0;
+	_sumY = 0;
+	_rankSumX = 0;
+	_rankSumY = 0;
+}
+
+bool WeightedAverageStream::Far(long long a, long long b) const
+{
+	const int slotA = Slot(a);
+	const int slotB = Slot(b);
+	return glm::distance(
+		glm::vec2(_x[slotA], _y[slotA]),
+		glm::vec2(_x[slotB], _y[slotB]))
+		> setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS;
+}
@@ -0,0 +1,91 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Streaming variant of the weighted average filter. Produces the same output
+// as WeightedAverageFilter::ApplyFilter, but classifies each sample only once
+// when its successor arrives (used, skipped as outlier or start of a new
+// fixation) and keeps the samples used by the current fixation in a sliding
+// window. Linear and triangular kernels are evaluated from running sums, so
+// per-frame cost depends on the number of new samples only. The gaussian
+// kernel is evaluated over the used samples with a precomputed weight table.
+
+#ifndef WEIGHTEDAVERAGESTREAM_H_
+#define WEIGHTEDAVERAGESTREAM_H_
+
+#include "src/Input/Filters/Filter.h"
+#include "src/Input/Filters/FilterKernel.h"
+#include <vector>
+
+class WeightedAverageStream : public FilterStream
+{
+public:
+
+	// Constructor
+	WeightedAverageStream(FilterKernel kernel, float windowTime, bool outlierRemoval);
+
+	// Append new samples
+	void Push(const double* pX, const double* pY, const std::chrono::milliseconds* pTimestamps, int count, float samplerate) override;
+
+	// Retrieve filtered gaze
+	void Apply(double& rGazeX, double& rGazeY, float& rFixationDuration) const override;
+
+private:
+
+	// Classification of sample against its neighbors
+	enum class SampleStatus : char { UNKNOWN, USE, SKIP, BREAK };
+
+	// Append single sample, classifies its predecessor
+	void PushSingle(double x, double y, std::chrono::milliseconds timestamp);
+
+	// Apply status of classified sample to used samples
+	void Process(long long index);
+
+	// Move lower bound of used samples to window and memory bounds
+	void Trim();
+
+	// Rebuild used samples from memory, necessary when window size changes
+	void Rebuild();
+
+	// Manipulation of used samples
+	void AddUsed(long long index);
+	void RemoveOldestUsed();
+	void ResetUsed();
+
+	// Check whether two samples in memory are further apart than fixation radius
+	bool Far(long long a, long long b) const;
+
+	// Slot in memory of sample index
+	int Slot(long long index) const { return (int)(index % _capacity); }
+
+	// Parameters
+	FilterKernel _kernel;
+	float _windowTime;
+	bool _outlierRemoval;
+	int _windowSize = 0;
+	std::vector<double> _weights; // weight per rank of used sample, newest first
+
+	// Memory of samples as structure of arrays, indexed by slot
+	int _capacity;
+	std::vector<double> _x;
+	std::vector<double> _y;
+	std::vector<std::chrono::milliseconds> _timestamps;
+	std::vector<SampleStatus> _status;
+	long long _count = 0; // count of pushed samples
+
+	// Indices of used samples, oldest first, as ring
+	std::vector<long long> _used;
+	long long _usedBegin = 0;
+	long long _usedEnd = 0;
+
+	// Exclusive lower bound of sample indices which may be used
+	long long _bottom = -1;
+
+	// Running sums over used samples. Rank sums weight each sample with its rank (newest is zero)
+	double _sumX = 0;
+	double _sumY = 0;
+	double _rankSumX = 0;
+	double _rankSumY = 0;
+};
+
+#endif // WEIGHTEDAVERAGESTREAM_H_
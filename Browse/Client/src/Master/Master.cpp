@@ -6,6 +6,7 @@
 #include "Master.h"
 #include "src/Utils/Helper.h"
 #include "src/Utils/Logger.h"
+#include "src/Global.h"
 #include "src/Arguments.h"
 #include "src/ContentPath.h"
 #include "submodules/glfw/include/GLFW/glfw3.h"
@@ -111,6 +112,9 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     _pCefMediator = pCefMediator;
 	_userDirectory = userDirectory;
 
+	// Workers for asynchronous jobs
+	_upAsyncJobExecutor = std::unique_ptr<AsyncJobExecutor>(new AsyncJobExecutor(setup::ASYNC_JOB_THREAD_COUNT));
+
     // ### GLFW AND OPENGL ###
 
     // Create OpenGL context
@@ -459,6 +463,9 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 
 	// ### FIREBASE MAILER ###
 
+	// Replay commands of previous runs which have not been uploaded
+	FirebaseMailer::Instance().PushBack_Journal(_userDirectory + FIREBASE_JOURNAL_FILE);
+
 	// Login (waits until complete)
 	std::promise<std::string> idTokenPromise; auto idTokenFuture = idTokenPromise.get_future(); // future provides initial idToken
 	bool pushedBack = FirebaseMailer::Instance().PushBack_Login(_upSettings->GetFirebaseEmail(), _upSettings->GetFirebasePassword(), _useDriftMap, &idTokenPromise);
@@ -559,6 +566,9 @@ Master::~Master()
 
 	// Wait for all async jobs to finish
 	UpdateAsyncJobs(true);
+	auto metrics = _upAsyncJobExecutor->GetMetrics();
+	LogInfo("Master: Executed ", metrics.completedCount, " async jobs on ", metrics.threadCount, " threads with average latency of ",
+		metrics.averageLatency, "s (maximum ", metrics.maxLatency, "s) and average duration of ", metrics.averageDuration, "s");
 
     // Terminate eyeGUI
     eyegui::terminateGUI(_pSuperGUI);
@@ -660,33 +670,21 @@ std::weak_ptr<CustomTransformationInterface> Master::GetCustomTransformationInte
 	return _upEyeInput->GetCustomTransformationInterface();
 }
 
-void Master::PushBackAsyncJob(std::function<bool()> job)
+void Master::PushBackAsyncJob(std::function<bool()> job, std::function<void(bool)> callback)
 {
-	// Delegate job into thread
-	_asyncJobs.push_back(std::async(
-		std::launch::async, // do it asynchronously
-		job));
+	// Delegate job to workers
+	_upAsyncJobExecutor->PushBack(job, callback);
 }
 
-void Master::SimplePushBackAsyncJob(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json record)
+void Master::AppendFirebaseRecord(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json record)
 {
 	// Add data to record
 	record.emplace("startIndex", FirebaseMailer::Instance().GetStartIndex()); // start index
 	record.emplace("date", GetDate()); // add date
 	record.emplace("timestamp", GetTimestamp()); // add timestamp
 
-	// Push back the job
-	PushBackAsyncJob(
-		[countKey, recordKey, record]() // copy of date, start index and success
-	{
-		// Persist record
-		std::promise<int> promise; auto future = promise.get_future(); // future provides index
-		bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(countKey, 1, &promise); // adds one to the count
-		if (pushedBack) { pushedBack = FirebaseMailer::Instance().PushBack_Put(recordKey, record, std::to_string(future.get() - 1)); } // send JSON to database
-
-		// Return some value (not used)
-		return true;
-	});
+	// Persist record, mailer puts it at previous count without waiting here
+	FirebaseMailer::Instance().PushBack_Append(countKey, recordKey, record);
 }
 
 eyegui::Layout* Master::AddLayout(std::string filepath, int layer, bool visible)
@@ -1115,31 +1113,13 @@ void Master::Loop()
 
 void Master::UpdateAsyncJobs(bool wait)
 {
-	// Check asynchronous jobs
-	int startIndex = _asyncJobs.size() - 1;
-	for (int i = startIndex; i >= 0; i--) // do it from the back
+	if (wait)
 	{
-		// Retrieve whether asynchronous call is done
-		bool remove = false;
-		if (wait)
-		{
-			_asyncJobs.at(i).wait();
-			remove = true; // waited until it is done, so remove it
-		}
-		else
-		{
-			// We have no time, so wait for nothing and just check
-			if (std::future_status::ready == _asyncJobs.at(i).wait_for(std::chrono::seconds(0)))
-			{
-				remove = true; // done by now, so remove it
-			}
-		}
-
-		// Remove future from list when job is done
-		if (remove)
-		{
-			_asyncJobs.erase(_asyncJobs.begin() + i);
-		}
+		_upAsyncJobExecutor->WaitAll(); // blocks until all jobs are done
+	}
+	else
+	{
+		_upAsyncJobExecutor->Update(); // just deliver callbacks of finished jobs
 	}
 }
 
@@ -1196,14 +1176,7 @@ void Master::PersistDriftGrid(PersistDriftGridReason reason)
 			{ "driftX", driftX },
 			{ "driftY", driftY }
 		};
-		PushBackAsyncJob(
-			[gridJSON]() // provide copy of data
-		{
-			std::promise<int> promise; auto future = promise.get_future(); // future provides index
-			bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(FirebaseIntegerKey::GENERAL_DRIFT_GRID_COUNT, 1, &promise); // adds one to the count
-			if (pushedBack) { FirebaseMailer::Instance().PushBack_Put(FirebaseJSONKey::GENERAL_DRIFT_GRID, gridJSON, std::to_string(future.get() - 1)); } // send JSON to database
-			return true; // give the future some value
-		});
+		FirebaseMailer::Instance().PushBack_Append(FirebaseIntegerKey::GENERAL_DRIFT_GRID_COUNT, FirebaseJSONKey::GENERAL_DRIFT_GRID, gridJSON); // adds one to the count and sends JSON to database
 	}
 }
 
@@ -1293,7 +1266,7 @@ void Master::MasterButtonListener::down(eyegui::Layout* pLayout, std::string id)
     {
         _pMaster->_paused = true;
         eyegui::setDescriptionVisibility(_pMaster->_pGUI, eyegui::DescriptionVisibility::VISIBLE);
-		_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_PAUSE_COUNT, FirebaseJSONKey::GENERAL_PAUSE);
+		_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_PAUSE_COUNT, FirebaseJSONKey::GENERAL_PAUSE);
     }
 	else if (pLayout == _pMaster->_pSuperCalibrationLayout)
 	{
@@ -1337,7 +1310,7 @@ void Master::MasterButtonListener::down(eyegui::Layout* pLayout, std::string id)
 
 			// Store this recalibration in Firebase
 			nlohmann::json record = { { "success", success } };
-			_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_RECALIBRATION_COUNT, FirebaseJSONKey::GENERAL_RECALIBRATION, record);
+			_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_RECALIBRATION_COUNT, FirebaseJSONKey::GENERAL_RECALIBRATION, record);
 
 			// Remove points of last calibration
 			for (const auto& index : _pMaster->_lastCalibrationPointsFrameIndices)
@@ -1402,7 +1375,7 @@ void Master::MasterButtonListener::up(eyegui::Layout* pLayout, std::string id)
     {
         _pMaster->_paused = false;
         eyegui::setDescriptionVisibility(_pMaster->_pGUI, eyegui::DescriptionVisibility::ON_PENETRATION); // TODO look up in Settings for set value
-		_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_UNPAUSE_COUNT, FirebaseJSONKey::GENERAL_UNPAUSE);
+		_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_UNPAUSE_COUNT, FirebaseJSONKey::GENERAL_UNPAUSE);
     }
 }
 
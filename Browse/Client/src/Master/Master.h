@@ -23,6 +23,7 @@
 #include "src/Utils/LerpValue.h"
 #include "src/Utils/Framebuffer.h"
 #include "src/Utils/RenderItem.h"
+#include "src/Utils/AsyncJobExecutor.h"
 #include "src/Input/Filters/CustomTransformationInteface.h"
 #include "externals/OGL/gl_core_3_3.h"
 #include "submodules/eyeGUI/include/eyeGUI.h"
@@ -101,9 +102,11 @@ public:
 		return DashboardParameters(_upSettings->GetFirebaseEmail(), _upSettings->GetFirebasePassword(), setup::FIREBASE_API_KEY, setup::FIREBASE_PROJECT_ID);
 	}
 
-	// Push back async job. Only provide threadsafe calls to the job!!!
-	void PushBackAsyncJob(std::function<bool()> job);
-	void SimplePushBackAsyncJob(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json record = nlohmann::json()); // automatically adds start index and date
+	// Push back async job. Only provide threadsafe calls to the job!!! Callback is executed in main loop after job has finished
+	void PushBackAsyncJob(std::function<bool()> job, std::function<void(bool)> callback = nullptr);
+
+	// Append record at count in Firebase, automatically adds start index and date. Appended by Firebase mailer, does not occupy a worker
+	void AppendFirebaseRecord(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json record = nlohmann::json());
 
     // ### EYEGUI DELEGATION ###
 
@@ -277,7 +280,7 @@ private:
     // Loop of master
     void Loop();
 
-	// Update async jobs
+	// Update async jobs, delivers callbacks of finished ones
 	void UpdateAsyncJobs(bool wait); // wait indicates that it should block the thread until all async jobs are finished
 
 	// Show super calibration layout
@@ -397,7 +400,7 @@ private:
 	bool _dataTransfer = true;
 
 	// Asyncronous calls, e.g. persist Firebase entries
-	std::vector<std::future<bool> > _asyncJobs; // abuse async calls since it is easier to determine whether finished or not
+	std::unique_ptr<AsyncJobExecutor> _upAsyncJobExecutor;
 
 	// Indicator whether computer should shut down at exit
 	bool _shouldShutdownAtExit = false;
@@ -0,0 +1,187 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "FirebaseJournal.h"
+#include "src/Utils/Logger.h"
+#include "src/Utils/Helper.h"
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+// Tags of records
+static const char PUT_RECORD = 'P';
+static const char TRANSFORM_RECORD = 'T';
+static const char APPEND_RECORD = 'A';
+
+// Upper limit of string length in record, longer ones are not written and indicate corrupted journal
+static const unsigned int MAX_RECORD_STRING_LENGTH = 1 << 24;
+
+FirebaseJournal::FirebaseJournal(std::string fullpath) : _fullpath(fullpath)
+{
+	// Nothing to do
+}
+
+bool FirebaseJournal::Load(std::vector<Record>& rRecords)
+{
+	rRecords.clear();
+	_recordCount = 0;
+
+	// Open journal
+	std::ifstream stream(_fullpath, std::ios_base::in | std::ios_base::binary);
+	if (!stream.is_open()) { return false; }
+
+	// Readers of fields
+	auto readInt = [&](int& rValue) -> bool
+	{
+		return (bool)stream.read(reinterpret_cast<char*>(&rValue), sizeof(rValue));
+	};
+	auto readString = [&](std::string& rString) -> bool
+	{
+		unsigned int length = 0;
+		if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > MAX_RECORD_STRING_LENGTH) { return false; }
+		rString.resize(length);
+		return length == 0 || (bool)stream.read(&rString[0], length);
+	};
+
+	// Read record by record
+	char tag = 0;
+	while (stream.get(tag))
+	{
+		Record record;
+		bool success = false;
+		switch (tag)
+		{
+		case PUT_RECORD:
+			record.type = Type::PUT;
+			success = readString(record.uid) && readString(record.path) && readString(record.body);
+			break;
+		case TRANSFORM_RECORD:
+			record.type = Type::TRANSFORM;
+			success = readString(record.uid) && readString(record.path) && readInt(record.delta);
+			break;
+		case APPEND_RECORD:
+			record.type = Type::APPEND;
+			success = readString(record.uid) && readString(record.path) && readString(record.recordPath) && readString(record.body);
+			break;
+		}
+
+		// Incomplete record at the end, e.g. after crash while writing
+		if (!success)
+		{
+			LogInfo("FirebaseJournal: Stopped reading at corrupted record after ", rRecords.size(), " records");
+			_recordCount++; // corrupted record is removed at next reset
+			break;
+		}
+		rRecords.push_back(std::move(record));
+		_recordCount++;
+	}
+
+	return true;
+}
+
+bool FirebaseJournal::Append(const Record& rRecord)
+{
+	if (!EncodeRecord(_buffer, rRecord))
+	{
+		LogError("FirebaseJournal: Record of ", rRecord.path, " is too large for journal");
+		return false;
+	}
+	_recordCount++;
+	return true;
+}
+
+void FirebaseJournal::Write()
+{
+	if (_buffer.empty()) { return; }
+
+	// Append all records at once
+	std::ofstream stream(_fullpath, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+	stream.write(_buffer.data(), _buffer.size());
+	stream.flush();
+	if (!stream)
+	{
+		LogError("FirebaseJournal: Failed to write records");
+	}
+	_buffer.clear();
+}
+
+void FirebaseJournal::Reset(const std::vector<Record>& rRecords)
+{
+	_buffer.clear();
+
+	// Remove journal when everything has been uploaded
+	if (rRecords.empty())
+	{
+		if (_recordCount > 0) { std::remove(_fullpath.c_str()); }
+		_recordCount = 0;
+		return;
+	}
+
+	// Write records into temporary file
+	const std::string temporaryPath = _fullpath + ".tmp";
+	{
+		std::string buffer;
+		for (const auto& rRecord : rRecords)
+		{
+			if (!EncodeRecord(buffer, rRecord)) { LogError("FirebaseJournal: Record of ", rRecord.path, " is too large for journal"); }
+		}
+		std::ofstream temporary(temporaryPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+		temporary.write(buffer.data(), buffer.size());
+		if (!temporary)
+		{
+			LogError("FirebaseJournal: Failed to write reset journal");
+			return; // records are still in old journal, maybe even the uploaded ones
+		}
+	}
+
+	// Replace journal by temporary file
+	if (!ReplaceFileAtomically(temporaryPath, _fullpath))
+	{
+		LogError("FirebaseJournal: Failed to replace journal");
+	}
+	_recordCount = (int)rRecords.size();
+}
+
+bool FirebaseJournal::EncodeRecord(std::string& rBuffer, const Record& rRecord)
+{
+	// Truncated strings would be uploaded corrupted, so reject whole record
+	if (rRecord.uid.size() > MAX_RECORD_STRING_LENGTH
+		|| rRecord.path.size() > MAX_RECORD_STRING_LENGTH
+		|| rRecord.recordPath.size() > MAX_RECORD_STRING_LENGTH
+		|| rRecord.body.size() > MAX_RECORD_STRING_LENGTH)
+	{
+		return false;
+	}
+
+	auto encodeString = [&](const std::string& rString)
+	{
+		const unsigned int length = (unsigned int)rString.size();
+		rBuffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+		rBuffer.append(rString.data(), length);
+	};
+	switch (rRecord.type)
+	{
+	case Type::PUT:
+		rBuffer.push_back(PUT_RECORD);
+		encodeString(rRecord.uid);
+		encodeString(rRecord.path);
+		encodeString(rRecord.body);
+		break;
+	case Type::TRANSFORM:
+		rBuffer.push_back(TRANSFORM_RECORD);
+		encodeString(rRecord.uid);
+		encodeString(rRecord.path);
+		rBuffer.append(reinterpret_cast<const char*>(&rRecord.delta), sizeof(rRecord.delta));
+		break;
+	case Type::APPEND:
+		rBuffer.push_back(APPEND_RECORD);
+		encodeString(rRecord.uid);
+		encodeString(rRecord.path);
+		encodeString(rRecord.recordPath);
+		encodeString(rRecord.body);
+		break;
+	}
+	return true;
+}
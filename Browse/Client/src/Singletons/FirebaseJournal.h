@@ -0,0 +1,73 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Append-only journal of Firebase commands which have not been uploaded yet.
+// Records are collected in memory and written together, usually once per
+// batch of commands before the network is accessed. Not threadsafe, used by
+// the thread of the Firebase mailer only. Paths are relative to the user,
+// whose uid is stored in each record.
+// Record layout, integers in host byte order:
+//	'P' : uint32 length, uid, uint32 length, path, uint32 length, body (put of JSON body)
+//	'T' : uint32 length, uid, uint32 length, path, int32 delta (transform of integer)
+//	'A' : uint32 length, uid, uint32 length, count path, uint32 length, record path, uint32 length, body
+//	      (count is incremented and body put at record path with old count appended)
+
+#ifndef FIREBASEJOURNAL_H_
+#define FIREBASEJOURNAL_H_
+
+#include <string>
+#include <vector>
+
+class FirebaseJournal
+{
+public:
+
+	// Type of record
+	enum class Type { PUT, TRANSFORM, APPEND };
+
+	// Record of command
+	struct Record
+	{
+		Type type = Type::PUT;
+		std::string path; // path of put or transform, count path of append
+		std::string recordPath; // only used by append
+		std::string body; // used by put and append
+		int delta = 0; // only used by transform
+		std::string uid; // user who issued the command
+	};
+
+	// Constructor
+	FirebaseJournal(std::string fullpath);
+
+	// Read journal record by record. Records are ordered from oldest to newest. Returns whether successful
+	bool Load(std::vector<Record>& rRecords);
+
+	// Append record, written at next write. Returns false if record is too large for journal
+	bool Append(const Record& rRecord);
+
+	// Write appended records to disk
+	void Write();
+
+	// Replace journal by given records, e.g. after some were uploaded. Removes journal if empty
+	void Reset(const std::vector<Record>& rRecords);
+
+	// Count of records in journal, including not yet written ones
+	int GetRecordCount() const { return _recordCount; }
+
+private:
+
+	// Encode record. Returns false and leaves buffer untouched if a string exceeds the length limit
+	static bool EncodeRecord(std::string& rBuffer, const Record& rRecord);
+
+	// Fullpath to journal file
+	std::string _fullpath;
+
+	// Encoded records which are not yet written
+	std::string _buffer;
+
+	// Count of records in journal
+	int _recordCount = 0;
+};
+
+#endif // FIREBASEJOURNAL_H_
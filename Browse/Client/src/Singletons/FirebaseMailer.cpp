@@ -7,9 +7,9 @@
 #include "src/Utils/glmWrapper.h"
 #include "src/Utils/Logger.h"
 #include "src/Utils/Helper.h"
-#include "externals/curl/include/curl/curl.h"
-#include <sstream>
+#include <algorithm>
 #include <chrono>
+#include <stdexcept>
 
 using json = nlohmann::json;
 
@@ -27,64 +27,79 @@ template<> json fallback<json>()				{ return json(); };
 // ### HTTP HELPERS ###
 // ####################
 
-// Write callback for CURL
-size_t WriteCallback(void *contents, size_t size, size_t nmemb, void *userp)
-{
-	((std::string*)userp)->append((char*)contents, size * nmemb);
-	return size * nmemb;
-}
+// Status codes of HTTP
+static const long HTTP_OK = 200;
+static const long HTTP_PRECONDITION_FAILED = 412;
 
-// Checks for something in the first line of HTTP header
-bool HttpHeaderFirstLineContains(const std::string& rHeader, const std::string& rCompareTo)
+// Parse answer body, empty structure if not valid JSON
+json ParseBody(const std::string& rBody)
 {
-	std::string firstLine = rHeader.substr(0, rHeader.find("\n"));
-	return firstLine.find(rCompareTo) != std::string::npos;
+	try
+	{
+		return json::parse(rBody);
+	}
+	catch (const std::exception&)
+	{
+		return json();
+	}
 }
 
-// Checks header for ok
-bool HttpHeaderOK(const std::string& rHeader)
+// Parse integer from answer body, fallback if not available
+int ParseInteger(const std::string& rBody)
 {
-	return HttpHeaderFirstLineContains(rHeader, "200 OK")
-		|| HttpHeaderFirstLineContains(rHeader, "100 Continue"); // Google sometimes returns this and in the third line 200. For now, treating as synonyms
+	json value = ParseBody(rBody);
+	return value.is_number_integer() ? value.get<int>() : fallback<int>();
 }
 
-// Checks header for failed precondition
-bool HttpHeaderPreconditionFailed(const std::string& rHeader)
+// ##########################
+// ### FIREBASE INTERFACE ###
+// ##########################
+
+void FirebaseMailer::FirebaseInterface::OpenJournal(std::string fullpath)
 {
-	return HttpHeaderFirstLineContains(rHeader, "412 Precondition Failed");
+	// Records of previous runs are replayed once their user is logged in
+	std::unique_ptr<FirebaseJournal> upJournal(new FirebaseJournal(fullpath));
+	if (upJournal->Load(_journalRecords))
+	{
+		LogInfo("FirebaseInterface: ", "Loaded ", _journalRecords.size(), " commands from journal.");
+	}
+	ReplayJournalRecords();
+
+	// Journal is rewritten with merged commands, including the ones deferred before opening
+	upJournal->Reset(GetPendingRecords());
+	_upJournal = std::move(upJournal);
 }
 
-// Extract ETag from header, returns empty string if not found
-std::string HttpHeaderExtractETag(const std::string& rHeader)
+void FirebaseMailer::FirebaseInterface::ReplayJournalRecords()
 {
-	std::istringstream lineStream(rHeader);
-	std::string line;
-	std::getline(lineStream, line); // first line is not of interest
-	while(std::getline(lineStream, line)) // go over lines
+	if (_uid == "0") { return; } // not logged in yet
+
+	// Commands of same path are merged while deferring. Records without user were issued before any login
+	std::vector<FirebaseJournal::Record> otherRecords;
+	for (auto& rRecord : _journalRecords)
 	{
-		std::istringstream tokenStream(line);
-		std::string token;
-		std::vector<std::string> tokens;
-		while (std::getline(tokenStream, token, ':')) // go over tokens
+		if (rRecord.uid != _uid && rRecord.uid != "0")
 		{
-			tokens.push_back(token); // collect tokens
+			otherRecords.push_back(std::move(rRecord));
+			continue;
 		}
-
-		// Should be two tokens, and first should be "ETag"
-		if (tokens.size() == 2 && tokens.at(0) == "ETag")
+		switch (rRecord.type)
 		{
-			// Extract second token as ETag
-			return tokens.at(1).substr(1, tokens.at(1).length() - 1); // return without preceeding space
+		case FirebaseJournal::Type::PUT:
+			DeferPut(rRecord.path, rRecord.body);
+			break;
+		case FirebaseJournal::Type::TRANSFORM:
+			DeferTransform(rRecord.path, rRecord.delta, nullptr);
+			break;
+		case FirebaseJournal::Type::APPEND:
+			DeferAppend(rRecord.path, rRecord.recordPath, rRecord.body);
+			break;
 		}
 	}
-
-	return ""; // return empty string in case of non exisiting ETag
+	LogInfo("FirebaseInterface: ", "Replayed ", _journalRecords.size() - otherRecords.size(), " commands from journal, keeping ", otherRecords.size(), " of other users.");
+	_journalRecords = std::move(otherRecords);
 }
 
-// ##########################
-// ### FIREBASE INTERFACE ###
-// ##########################
-
 bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string password, bool useDriftMap, std::promise<std::string>* pPromise)
 {
 	// Store email and password
@@ -92,22 +107,36 @@ bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string pas
 	_password = password;
 
 	// Perform actual login
+	Flush();
 	bool success = Login();
 
 	// If success, retrieve start index
 	if (success)
 	{
+		// Commands of previous runs by this user are uploaded with the next flush
+		ReplayJournalRecords();
+		if (_upJournal) { _upJournal->Reset(GetPendingRecords()); }
+
 		std::promise<int> promise; auto future = promise.get_future(); // future provides index
 		Transform(FirebaseIntegerKey::GENERAL_APPLICATION_START_COUNT, 1, &promise); // adds one to the count
-		int index = future.get() - 1;
-		nlohmann::json record = {
-			{ "date", GetDate() }, // add date
-			{ "timestamp", GetTimestamp() }, // add timestamp
-			{ "version", CLIENT_VERSION }, // add version
-			{ "useDriftMap", useDriftMap } // add information whether drift map is used
-		};
-		Put(FirebaseJSONKey::GENERAL_APPLICATION_START, record, std::to_string(index)); // send JSON to database
-		*_pStartIndex = index;
+		Flush(); // transform is deferred, so perform it before waiting
+		try
+		{
+			int index = future.get() - 1;
+			nlohmann::json record = {
+				{ "date", GetDate() }, // add date
+				{ "timestamp", GetTimestamp() }, // add timestamp
+				{ "version", CLIENT_VERSION }, // add version
+				{ "useDriftMap", useDriftMap } // add information whether drift map is used
+			};
+			Put(FirebaseJSONKey::GENERAL_APPLICATION_START, record, std::to_string(index)); // send JSON to database
+			*_pStartIndex = index;
+		}
+		catch (const std::exception&)
+		{
+			// Count is incremented by a later flush, so index is unknown. Record would overwrite the one of another start
+			LogInfo("FirebaseInterface: ", "Application start could not be counted, so it is not recorded.");
+		}
 	}
 
 	// Fullfill the promise
@@ -120,92 +149,10 @@ bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string pas
 template<typename T>
 void FirebaseMailer::FirebaseInterface::Put(T key, typename FirebaseValue<T>::type value, std::string subpath)
 {
-	// Only continue if logged in
-	bool success = false;
-	if (_pIdToken->IsSet())
-	{
-		// Setup CURL
-		CURL *curl;
-		curl = curl_easy_init();
-
-		// Continue if CURL was initialized
-		if (curl)
-		{
-			// Local variables
-			std::string answerHeaderBuffer;
-			std::string answerBodyBuffer;
-
-			// Request URL
-			std::string requestURL =
-				_URL + "/"
-				+ BuildFirebaseKey(key, _uid) + "/" + subpath
-				+ ".json"
-				+ "?auth=" + _pIdToken->Get();
-
-			// Setup CURL
-			curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT"); // tell about PUTting
-			curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L); // CURL told me to use it
-			curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback); // set callback for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback); // set callback for answer body
-			curl_easy_setopt(curl, CURLOPT_HEADERDATA, &answerHeaderBuffer); // set buffer for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
-
-			// Post field
-			const std::string postField = json(value).dump();
-
-			// Fill request
-			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postField.c_str()); // value to put
-			curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of request
-
-			 // Perform the request
-			CURLcode res = curl_easy_perform(curl);
-			if (res == CURLE_OK) // everything ok with CURL
-			{
-				// Check header
-				if (HttpHeaderOK(answerHeaderBuffer))
-				{
-					success = true; // fine!
-				}
-				else // there is something else in header
-				{
-					// Try to relogin
-					if (Relogin()) // returns whether successful
-					{
-						// Setup CURL request (reuse stuff from first)
-						answerHeaderBuffer.clear();
-						answerBodyBuffer.clear();
-						requestURL =
-							_URL + "/"
-							+ BuildFirebaseKey(key, _uid) + "/" + subpath
-							+ ".json"
-							+ "?auth=" + _pIdToken->Get();
-						curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of new request
-
-						// Try again to PUT data
-						res = curl_easy_perform(curl);
-						if (res == CURLE_OK) // everything ok with CURL
-						{
-							if (HttpHeaderOK(answerHeaderBuffer))
-							{
-								success = true; // fine!
-							}
-							// else: ok, it failed.
-						}
-					}
-				}
-			}
-
-			// Cleanup
-			curl_easy_cleanup(curl); curl = nullptr;
-		}
-	}
-
-	// Tell user about no success
-	if (!success)
-	{
-		LogError("FirebaseInterface: ", "Data transfer to Firebase failed.");
-	}
+	const std::string path = FirebaseAddress(key) + "/" + subpath;
+	const std::string body = json(value).dump();
+	if (_upJournal) { _upJournal->Append({ FirebaseJournal::Type::PUT, path, "", body, 0, _uid }); }
+	DeferPut(path, body);
 }
 
 template<typename T>
@@ -222,105 +169,279 @@ void FirebaseMailer::FirebaseInterface::Get(T key, std::promise<typename Firebas
 	}
 }
 
+void FirebaseMailer::FirebaseInterface::Append(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, json value, std::string subpath)
+{
+	const std::string countPath = FirebaseAddress(countKey);
+	const std::string recordPath = FirebaseAddress(recordKey) + "/" + subpath;
+	const std::string body = value.dump();
+	if (_upJournal) { _upJournal->Append({ FirebaseJournal::Type::APPEND, countPath, recordPath, body, 0, _uid }); }
+	DeferAppend(countPath, recordPath, body);
+}
+
 void FirebaseMailer::FirebaseInterface::Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise)
 {
-	// Just add the delta to the existing value
-	auto result = Apply(key, [delta](int DBvalue) { return DBvalue + delta; });
-	if (pPromise != nullptr) { pPromise->set_value(result); }
+	const std::string path = FirebaseAddress(key);
+	if (_upJournal && pPromise == nullptr) { _upJournal->Append({ FirebaseJournal::Type::TRANSFORM, path, "", "", delta, _uid }); } // promises do not survive the run
+	DeferTransform(path, delta, pPromise);
 }
 
 void FirebaseMailer::FirebaseInterface::Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise)
 {
 	// Use maximum of database value and this
-	auto result = Apply(key, [value](int DBvalue) { return glm::max(DBvalue, value); });
+	Flush();
+	std::vector<bool> successes;
+	auto result = Apply({ BuildFirebaseKey(key, _uid) }, { [value](int DBvalue) { return glm::max(DBvalue, value); } }, successes).front();
 	if (pPromise != nullptr) { pPromise->set_value(result); }
 }
 
-bool FirebaseMailer::FirebaseInterface::Login()
+void FirebaseMailer::FirebaseInterface::Flush()
 {
-	bool success = false;
-
-	// Invalidate tokens
-	_pIdToken->Reset();
-	_refreshToken = "";
+	// Make commands persistent before network is accessed
+	if (_upJournal) { _upJournal->Write(); }
+	if (!HasPending()) { return; }
+	bool uploaded = false; // whether anything has been uploaded, so journal must be reset
 
-	// Setup CURL
-	CURL *curl;
-	curl = curl_easy_init();
-
-	// Continue if CURL was initialized
-	if (curl)
-	{
-		// Local variables
-		CURLcode res;
-		std::string postBuffer;
-		std::string answerHeaderBuffer;
-		std::string answerBodyBuffer;
-		struct curl_slist* headers = nullptr; // init to NULL is important 
-		headers = curl_slist_append(headers, "Content-Type: application/json"); // type is JSON
-
-		// Set options
-		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers); // apply header
-		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-		curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback); // set callback for answer header
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback); // set callback for answer body
-		curl_easy_setopt(curl, CURLOPT_HEADERDATA, &answerHeaderBuffer); // set buffer for answer header
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
-
-		// Post field
-		const json jsonPost =
+	// Combine transforms and appends per path, paths are applied at the same time
+	if (!_pendingTransforms.empty() || !_pendingAppends.empty())
+	{
+		auto transforms = std::move(_pendingTransforms);
+		auto appends = std::move(_pendingAppends);
+		_pendingTransforms.clear();
+		_pendingAppends.clear();
+		std::vector<std::string> paths;
+		std::vector<int> deltas;
+		auto indexOf = [&](const std::string& rPath)
 		{
-			{ "email", _email }, // email of user
-			{ "password", _password }, // password to access database
-			{ "returnSecureToken", true } // of course, thats what this is about
+			size_t i = std::find(paths.begin(), paths.end(), rPath) - paths.begin();
+			if (i == paths.size())
+			{
+				paths.push_back(rPath);
+				deltas.push_back(0);
+			}
+			return i;
 		};
-		postBuffer = jsonPost.dump(); // store in a string, otherwise it breaks (CURL probably wants a reference)
-
-									  // Fill request
-		curl_easy_setopt(curl, CURLOPT_URL, "https://www.googleapis.com/identitytoolkit/v3/relyingparty/verifyPassword?key=" + _API_KEY); // URL to access
-		curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postBuffer); // fill post body
-
-		// Execute request
-		res = curl_easy_perform(curl);
-		if (res != CURLE_OK) // something went wrong
+		for (const auto& rTransform : transforms) { deltas[indexOf(rTransform.path)] += rTransform.delta; }
+		for (const auto& rAppend : appends) { deltas[indexOf(rAppend.countPath)] += 1; }
+		std::vector<std::string> fullPaths;
+		std::vector<std::function<int(int)> > functions;
+		for (size_t i = 0; i < paths.size(); i++)
 		{
-			LogError("FirebaseInterface: ", "User login to Firebase failed: ", curl_easy_strerror(res));
-			return false;
+			const int delta = deltas[i];
+			fullPaths.push_back(BuildFirebasePath(paths[i], _uid));
+			functions.push_back([delta](int DBvalue) { return DBvalue + delta; });
 		}
+		std::vector<bool> successes;
+		auto results = Apply(fullPaths, functions, successes);
 
-		// Cleanup
-		curl_slist_free_all(headers); headers = nullptr;
-		curl_easy_cleanup(curl); curl = nullptr;
+		// Each promise receives value like after applying the transforms one by one, appends follow the transforms.
+		// Promises of paths which could not be applied receive an exception, as the delta is applied later
+		std::vector<int> values(paths.size());
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			values[i] = results[i] - deltas[i];
+			uploaded |= successes[i];
+		}
+		std::vector<int> failedDeltas(paths.size(), 0);
+		for (const auto& rTransform : transforms)
+		{
+			const size_t i = indexOf(rTransform.path);
+			values[i] += rTransform.delta;
+			if (successes[i])
+			{
+				if (rTransform.pPromise != nullptr) { rTransform.pPromise->set_value(values[i]); }
+			}
+			else
+			{
+				if (rTransform.pPromise != nullptr) { rTransform.pPromise->set_exception(std::make_exception_ptr(std::runtime_error("Transform not applied"))); }
+				failedDeltas[i] += rTransform.delta;
+			}
+		}
+		for (size_t i = 0; i < paths.size(); i++)
+		{
+			if (failedDeltas[i] != 0) { _pendingTransforms.push_back({ paths[i], failedDeltas[i], nullptr }); } // try again later
+		}
+		for (const auto& rAppend : appends)
+		{
+			const size_t i = indexOf(rAppend.countPath);
+			if (successes[i])
+			{
+				DeferPut(rAppend.recordPath + std::to_string(values[i]), rAppend.body); // previous count is index of record
+				values[i]++;
+			}
+			else
+			{
+				_pendingAppends.push_back(rAppend); // try again later
+			}
+		}
+	}
 
-		// Parse answer to JSON object and extract id token
-		const auto jsonAnswer = json::parse(answerBodyBuffer);
-		auto result = jsonAnswer.find("idToken");
-		if (result != jsonAnswer.end())
+	// Perform puts at the same time
+	if (!_pendingPuts.empty())
+	{
+		auto puts = std::move(_pendingPuts);
+		_pendingPuts.clear();
+		std::vector<Request> requests;
+		for (const auto& rPut : puts)
 		{
-			_pIdToken->Set(result.value().get<std::string>());
-			LogInfo("FirebaseInterface: ", "User successfully logged into Firebase.");
-			success = true;
+			requests.push_back({ "PUT", BuildFirebasePath(rPut.path, _uid), {}, rPut.body });
 		}
-		else
+		auto responses = Perform(requests);
+		bool failed = false;
+		for (size_t i = 0; i < responses.size(); i++)
 		{
+			if (responses[i].status == HTTP_OK)
+			{
+				uploaded = true;
+			}
+			else // also not performed
+			{
+				failed = true;
+				DeferPut(puts[i].path, puts[i].body); // try again later
+			}
+		}
+		if (failed) { LogError("FirebaseInterface: ", "Data transfer to Firebase failed."); }
+	}
 
-			LogError("FirebaseInterface: ", "User login to Firebase failed.");
+	// Journal keeps only commands which are still deferred
+	if (_upJournal && uploaded) { _upJournal->Reset(GetPendingRecords()); }
+}
+
+void FirebaseMailer::FirebaseInterface::DeferPut(std::string path, std::string body)
+{
+	// Later put replaces earlier transforms of same path. Transforms with promise are kept, as transforms are performed before puts anyway
+	_pendingTransforms.erase(std::remove_if(_pendingTransforms.begin(), _pendingTransforms.end(), [&](const PendingTransform& rTransform)
+	{
+		return rTransform.pPromise == nullptr && path == rTransform.path + "/";
+	}), _pendingTransforms.end());
+
+	// Later put on same path replaces earlier one
+	for (auto& rPut : _pendingPuts)
+	{
+		if (rPut.path == path)
+		{
+			rPut.body = body;
+			return;
 		}
+	}
+	_pendingPuts.push_back({ path, body });
+}
 
-		// Search for refresh token (optional)
-		result = jsonAnswer.find("refreshToken");
-		if (result != jsonAnswer.end())
+void FirebaseMailer::FirebaseInterface::DeferTransform(std::string path, int delta, std::promise<int>* pPromise)
+{
+	// Transform after put of same path is applied on put
+	for (auto& rPut : _pendingPuts)
+	{
+		if (rPut.path == path + "/")
 		{
-			_refreshToken = result.value().get<std::string>();
+			const int value = ParseInteger(rPut.body) + delta;
+			rPut.body = json(value).dump();
+			if (pPromise != nullptr) { pPromise->set_value(value); }
+			return;
 		}
+	}
 
-		// Search for uid
-		result = jsonAnswer.find("localId");
-		if (result != jsonAnswer.end())
+	// Transforms of same path without promise are combined right away, others at flush
+	if (pPromise == nullptr)
+	{
+		for (auto& rTransform : _pendingTransforms)
 		{
-			_uid = result.value().get<std::string>(); // one could "break mailer" if not provided as nothing makes sense
+			if (rTransform.pPromise == nullptr && rTransform.path == path)
+			{
+				rTransform.delta += delta;
+				return;
+			}
 		}
 	}
+	_pendingTransforms.push_back({ path, delta, pPromise });
+}
+
+void FirebaseMailer::FirebaseInterface::DeferAppend(std::string countPath, std::string recordPath, std::string body)
+{
+	_pendingAppends.push_back({ countPath, recordPath, body });
+}
+
+std::vector<FirebaseJournal::Record> FirebaseMailer::FirebaseInterface::GetPendingRecords() const
+{
+	std::vector<FirebaseJournal::Record> records;
+	for (const auto& rTransform : _pendingTransforms)
+	{
+		if (rTransform.pPromise == nullptr) { records.push_back({ FirebaseJournal::Type::TRANSFORM, rTransform.path, "", "", rTransform.delta, _uid }); }
+	}
+	for (const auto& rAppend : _pendingAppends)
+	{
+		records.push_back({ FirebaseJournal::Type::APPEND, rAppend.countPath, rAppend.recordPath, rAppend.body, 0, _uid });
+	}
+	for (const auto& rPut : _pendingPuts)
+	{
+		records.push_back({ FirebaseJournal::Type::PUT, rPut.path, "", rPut.body, 0, _uid });
+	}
+	records.insert(records.end(), _journalRecords.begin(), _journalRecords.end());
+	return records;
+}
+
+bool FirebaseMailer::FirebaseInterface::Login()
+{
+	bool success = false;
+
+	// Invalidate tokens
+	_pIdToken->Reset();
+	_refreshToken = "";
+
+	// Post field
+	const json jsonPost =
+	{
+		{ "email", _email }, // email of user
+		{ "password", _password }, // password to access database
+		{ "returnSecureToken", true } // of course, thats what this is about
+	};
+
+	// Execute request
+	HttpTransport::Request request;
+	request.method = "POST";
+	request.URL = "https://www.googleapis.com/identitytoolkit/v3/relyingparty/verifyPassword?key=" + _API_KEY; // URL to access
+	request.headers = { "Content-Type: application/json" }; // type is JSON
+	request.body = jsonPost.dump();
+	auto response = _transport.Perform(request);
+	if (!response.performed) // something went wrong
+	{
+		LogError("FirebaseInterface: ", "User login to Firebase failed: ", response.error);
+		return false;
+	}
+
+	// Parse answer to JSON object and extract id token
+	const auto jsonAnswer = ParseBody(response.body);
+	if (!jsonAnswer.is_object())
+	{
+		LogError("FirebaseInterface: ", "User login to Firebase failed.");
+		return false;
+	}
+	auto result = jsonAnswer.find("idToken");
+	if (result != jsonAnswer.end())
+	{
+		_pIdToken->Set(result.value().get<std::string>());
+		LogInfo("FirebaseInterface: ", "User successfully logged into Firebase.");
+		success = true;
+	}
+	else
+	{
+
+		LogError("FirebaseInterface: ", "User login to Firebase failed.");
+	}
+
+	// Search for refresh token (optional)
+	result = jsonAnswer.find("refreshToken");
+	if (result != jsonAnswer.end())
+	{
+		_refreshToken = result.value().get<std::string>();
+	}
+
+	// Search for uid
+	result = jsonAnswer.find("localId");
+	if (result != jsonAnswer.end())
+	{
+		_uid = result.value().get<std::string>(); // one could "break mailer" if not provided as nothing makes sense
+	}
+
 	return success;
 }
 
@@ -343,309 +464,167 @@ bool FirebaseMailer::FirebaseInterface::Relogin()
 	}
 	else // relogin possilbe
 	{
-		// Setup CURL
-		CURL *curl;
-		curl = curl_easy_init();
-
-		// Continue if CURL was initialized
-		if (curl)
+		// Execute request
+		HttpTransport::Request request;
+		request.method = "POST";
+		request.URL = "https://securetoken.googleapis.com/v1/token?key=" + _API_KEY; // URL to access
+		request.headers = { "Content-Type: application/x-www-form-urlencoded" }; // type is simple form encoding
+		request.body = "grant_type=refresh_token&refresh_token=" + refreshToken;
+		auto response = _transport.Perform(request);
+		if (!response.performed) // something went wrong
 		{
-			// Local variables
-			CURLcode res;
-			std::string answerBodyBuffer;
-			struct curl_slist* headers = nullptr; // init to NULL is important 
-			headers = curl_slist_append(headers, "Content-Type: application/x-www-form-urlencoded"); // type is simple form encoding
-
-			// Set options
-			curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers); // apply header
-			curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback); // set callback for answer body
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
-
-			// Post field
-			const std::string postBuffer = "grant_type=refresh_token&refresh_token=" + refreshToken;
-
-			// Fill request
-			curl_easy_setopt(curl, CURLOPT_URL, "https://securetoken.googleapis.com/v1/token?key=" + _API_KEY); // URL to access
-			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postBuffer); // fill post body
-
-			// Execute request
-			res = curl_easy_perform(curl);
-			if (res != CURLE_OK) // something went wrong
-			{
-				LogError("FirebaseInterface: ", "User reauthentifiation to Firebase failed: ", curl_easy_strerror(res));
-				return false;
-			}
-
-			// Cleanup
-			curl_slist_free_all(headers); headers = nullptr;
-			curl_easy_cleanup(curl); curl = nullptr;
+			LogError("FirebaseInterface: ", "User reauthentifiation to Firebase failed: ", response.error);
+			return false;
+		}
 
-			// Parse answer to JSON object and extract id token
-			const auto jsonAnswer = json::parse(answerBodyBuffer);
-			auto result = jsonAnswer.find("id_token"); // different from email and password login
-			if (result != jsonAnswer.end())
-			{
-				_pIdToken->Set(result.value().get<std::string>());
-				LogInfo("FirebaseInterface: ", "User reauthentifiation to Firebase successful.");
-				success = true;
-			}
-			else
-			{
-				LogError("FirebaseInterface: ", "User reauthentifiation to Firebase failed.");
-			}
+		// Parse answer to JSON object and extract id token
+		const auto jsonAnswer = ParseBody(response.body);
+		auto result = jsonAnswer.is_object() ? jsonAnswer.find("id_token") : jsonAnswer.end(); // different from email and password login
+		if (result != jsonAnswer.end())
+		{
+			_pIdToken->Set(result.value().get<std::string>());
+			LogInfo("FirebaseInterface: ", "User reauthentifiation to Firebase successful.");
+			success = true;
+		}
+		else
+		{
+			LogError("FirebaseInterface: ", "User reauthentifiation to Firebase failed.");
+		}
 
-			// Search for refresh token (optional)
-			result = jsonAnswer.find("refresh_token");
-			if (result != jsonAnswer.end())
-			{
-				_refreshToken = result.value().get<std::string>();
-			}
+		// Search for refresh token (optional)
+		result = jsonAnswer.is_object() ? jsonAnswer.find("refresh_token") : jsonAnswer.end();
+		if (result != jsonAnswer.end())
+		{
+			_refreshToken = result.value().get<std::string>();
 		}
 	}
 
 	return success;
 }
 
-template<typename T>
-bool FirebaseMailer::FirebaseInterface::Put(T key, std::string ETag, typename FirebaseValue<T>::type value, std::string& rNewETag, typename FirebaseValue<T>::type& rNewValue, std::string subpath)
+std::vector<HttpTransport::Response> FirebaseMailer::FirebaseInterface::Perform(const std::vector<Request>& rRequests)
 {
-	bool success = false;
-	rNewETag = "";
-	rNewValue = fallback<typename FirebaseValue<T>::type>();
+	std::vector<HttpTransport::Response> responses(rRequests.size());
 
 	// Only continue if logged in
-	if (_pIdToken->IsSet())
-	{
-		// Setup CURL
-		CURL *curl;
-		curl = curl_easy_init();
+	if (!_pIdToken->IsSet()) { return responses; }
 
-		// Continue if CURL was initialized
-		if (curl)
+	// Perform requests with current id token
+	auto perform = [&](const std::vector<size_t>& rIndices)
+	{
+		std::vector<HttpTransport::Request> requests;
+		for (size_t i : rIndices)
 		{
-			// Local variables
-			std::string answerHeaderBuffer;
-			std::string answerBodyBuffer;
-			struct curl_slist* headers = nullptr; // init to NULL is important
-			const std::string putHeaderBuffer = "if-match:" + ETag;
-			headers = curl_slist_append(headers, putHeaderBuffer.c_str()); // 'if-match' criteria to use the ETag
-
-			// Request URL
-			std::string requestURL =
-				_URL + "/"
-				+ BuildFirebaseKey(key, _uid) + "/" + subpath
-				+ ".json"
-				+ "?auth=" + _pIdToken->Get();
-
-			// Setup CURL
-			curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers); // apply header
-			curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-			curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "PUT"); // tell about PUTting
-			curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L); // CURL told me to use it
-			curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback); // set callback for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback); // set callback for answer body
-			curl_easy_setopt(curl, CURLOPT_HEADERDATA, &answerHeaderBuffer); // set buffer for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
-
-			// Post field
-			const std::string postField = json(value).dump();
-
-			// Fill request
-			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postField.c_str()); // value to put
-			curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of request
-
-			// Perform the request
-			CURLcode res = curl_easy_perform(curl);
-			if (res == CURLE_OK) // everything ok with CURL
-			{
-				// Check header
-				if (HttpHeaderOK(answerHeaderBuffer))
-				{
-					success = true; // fine!
-				}
-				else if (HttpHeaderPreconditionFailed(answerHeaderBuffer))
-				{
-					// Fill newETag and newValue
-					rNewETag = HttpHeaderExtractETag(answerHeaderBuffer);
-					rNewValue = json::parse(answerBodyBuffer).get<typename FirebaseValue<T>::type>();
-				}
-				else // there is something else in header
-				{
-					// Try to relogin
-					if (Relogin()) // returns whether successful
-					{
-						// Setup CURL request (reuse stuff from first)
-						answerHeaderBuffer.clear();
-						answerBodyBuffer.clear();
-						requestURL =
-							_URL + "/"
-							+ BuildFirebaseKey(key, _uid) + "/" + subpath
-							+ ".json"
-							+ "?auth=" + _pIdToken->Get();
-						curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of new request
-
-						// Try again to PUT data
-						res = curl_easy_perform(curl);
-						if (res == CURLE_OK) // everything ok with CURL
-						{
-							if (HttpHeaderOK(answerHeaderBuffer))
-							{
-								success = true; // fine!
-							}
-							else if (HttpHeaderPreconditionFailed(answerHeaderBuffer))
-							{
-								// Fill newETag and newValue
-								rNewETag = HttpHeaderExtractETag(answerHeaderBuffer);
-								rNewValue = json::parse(answerBodyBuffer).get<typename FirebaseValue<T>::type>();
-							}
-							// else: ok, it failed.
-						}
-					}
-				}
-			}
-
-			// Cleanup
-			curl_slist_free_all(headers); headers = nullptr;
-			curl_easy_cleanup(curl); curl = nullptr;
+			HttpTransport::Request request;
+			request.method = rRequests[i].method;
+			request.URL = _URL + "/" + rRequests[i].path + ".json" + "?auth=" + _pIdToken->Get();
+			request.headers = rRequests[i].headers;
+			request.body = rRequests[i].body;
+			requests.push_back(std::move(request));
 		}
+		auto results = _transport.Perform(requests);
+		for (size_t j = 0; j < rIndices.size(); j++) { responses[rIndices[j]] = std::move(results[j]); }
+	};
+	std::vector<size_t> indices(rRequests.size());
+	for (size_t i = 0; i < indices.size(); i++) { indices[i] = i; }
+	perform(indices);
+
+	// Something else in header than expected, guess timeout of id token. Try again after relogin
+	std::vector<size_t> failed;
+	for (size_t i : indices)
+	{
+		const auto& rResponse = responses[i];
+		if (rResponse.performed && rResponse.status != HTTP_OK && rResponse.status != HTTP_PRECONDITION_FAILED) { failed.push_back(i); }
+	}
+	if (!failed.empty() && Relogin())
+	{
+		perform(failed);
 	}
 
-	return success;
+	return responses;
 }
 
 FirebaseMailer::FirebaseInterface::DBEntry FirebaseMailer::FirebaseInterface::Get(std::string key)
 {
-	// Return value
-	DBEntry result;
+	// Perform deferred changes first
+	Flush();
 
-	// Only continue if logged in
-	if (_pIdToken->IsSet())
-	{
-		// Setup CURL
-		CURL *curl;
-		curl = curl_easy_init();
+	// Tell it to deliver ETag to identify the state
+	auto response = Perform({ { "GET", key, { "X-Firebase-ETag: true" }, "" } }).front();
 
-		// Continue if CURL was initialized
-		if (curl)
-		{
-			// Local variables
-			std::string answerHeaderBuffer;
-			std::string answerBodyBuffer;
-			struct curl_slist* headers = nullptr; // init to NULL is important 
-			headers = curl_slist_append(headers, "X-Firebase-ETag: true"); // tell it to deliver ETag to identify the state
-
-			// Request URL
-			std::string requestURL =
-				_URL + "/"
-				+ key
-				+ ".json"
-				+ "?auth=" + _pIdToken->Get();
-
-			// Setup CURL
-			curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers); // apply header
-			curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-			curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, WriteCallback); // set callback for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback); // set callback for answer body
-			curl_easy_setopt(curl, CURLOPT_HEADERDATA, &answerHeaderBuffer); // set buffer for answer header
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
-			curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of request
-
-			// Perform the request
-			CURLcode res = curl_easy_perform(curl);
-			if (res == CURLE_OK) // everything ok with CURL
-			{
-				// Check header for OK
-				if (HttpHeaderOK(answerHeaderBuffer))
-				{
-					// Parse
-					result = DBEntry(HttpHeaderExtractETag(answerHeaderBuffer), json::parse(answerBodyBuffer));
-				}
-				else // not ok, guess timeout of id token?
-				{
-					// Try to relogin
-					if (Relogin()) // returns whether successful
-					{
-						// Setup CURL request (reuse stuff from first)
-						answerHeaderBuffer.clear();
-						answerBodyBuffer.clear();
-						requestURL =
-							_URL + "/"
-							+ key
-							+ ".json"
-							+ "?auth=" + _pIdToken->Get(); // update request URL as id token should be new
-						curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of new request
-
-						// Try again to GET data
-						res = curl_easy_perform(curl);
-						if (res == CURLE_OK && HttpHeaderOK(answerHeaderBuffer)) // everything ok with CURL and header
-						{
-							// Parse
-							result = DBEntry(HttpHeaderExtractETag(answerHeaderBuffer), json::parse(answerBodyBuffer));
-						}
-					}
-				}
-			}
-
-			// Cleanup of CURL
-			curl_easy_cleanup(curl); curl = nullptr;
-		}
+	// Parse
+	DBEntry result;
+	if (response.status == HTTP_OK)
+	{
+		result = DBEntry(HttpTransport::ExtractHeaderField(response.header, "ETag"), ParseBody(response.body));
 	}
-
-	// Return result
 	return result;
 }
 
-int FirebaseMailer::FirebaseInterface::Apply(FirebaseIntegerKey key, std::function<int(int)> function)
+std::vector<int> FirebaseMailer::FirebaseInterface::Apply(const std::vector<std::string>& rPaths, const std::vector<std::function<int(int)> >& rFunctions, std::vector<bool>& rSuccesses)
 {
-	bool success = false;
-
-	// Call own get method
-	const auto entry = this->Get(BuildFirebaseKey(key, _uid));
-
-	// Check whether data was found, create new with fallback value, if necessary
-	int value = (!entry.value.empty() && entry.value.is_number_integer()) ? entry.value.get<int>() : fallback<int>();
-
-	// Apply function on the value
-	value = function(value);
+	// Get current values of all paths at the same time
+	std::vector<Request> requests;
+	for (const auto& rPath : rPaths)
+	{
+		requests.push_back({ "GET", rPath, { "X-Firebase-ETag: true" }, "" });
+	}
+	auto responses = Perform(requests);
 
-	// Put value in database
-	std::string ETag = entry.ETag;
-	std::string newETag = "";
-	int newValue = 0;
-	const int maxTrialCount = 10;
-	int trialCount = 0;
+	// Apply functions on values, create new with fallback value, if necessary
+	rSuccesses.assign(rPaths.size(), false);
+	std::vector<std::string> ETags(rPaths.size());
+	std::vector<int> values(rPaths.size());
+	for (size_t i = 0; i < rPaths.size(); i++)
+	{
+		int value = fallback<int>();
+		if (responses[i].status == HTTP_OK)
+		{
+			ETags[i] = HttpTransport::ExtractHeaderField(responses[i].header, "ETag");
+			value = ParseInteger(responses[i].body);
+		}
+		values[i] = rFunctions[i](value);
+	}
 
 	// Try as long as no success but still new ETags
-	do
+	const int maxTrialCount = 10;
+	std::vector<size_t> open(rPaths.size());
+	for (size_t i = 0; i < open.size(); i++) { open[i] = i; }
+	for (int trialCount = 0; !open.empty(); trialCount++)
 	{
-		// Try to put on database
-		newETag = "";
-		newValue = 0;
-		success = Put(key, ETag, value, newETag, newValue);
-
-		// If no new ETag provided, just quit this (either success or database just does not like us)
-		if (newETag.empty()) { break; }
-
-		// Store new values
-		ETag = newETag;
-		value = newValue;
-
-		// Transform retrieved value
-		value = function(value);
+		// Try to put on database, only if ETag is still the same
+		requests.clear();
+		for (size_t i : open)
+		{
+			requests.push_back({ "PUT", rPaths[i] + "/", { "if-match: " + ETags[i] }, json(values[i]).dump() });
+		}
+		responses = Perform(requests);
 
-		// Increase trial count
-		++trialCount;
+		// Retry with new values where database has changed meanwhile
+		std::vector<size_t> retry;
+		for (size_t j = 0; j < open.size(); j++)
+		{
+			const size_t i = open[j];
+			const auto& rResponse = responses[j];
+			if (rResponse.status == HTTP_OK) { rSuccesses[i] = true; continue; } // fine!
 
-	} while (!success && trialCount <= maxTrialCount);
+			// If no new ETag provided, just quit this (database just does not like us)
+			const std::string ETag = rResponse.status == HTTP_PRECONDITION_FAILED ? HttpTransport::ExtractHeaderField(rResponse.header, "ETag") : "";
+			if (ETag.empty() || trialCount >= maxTrialCount)
+			{
+				LogError("FirebaseInterface: ", "Data transfer to Firebase failed.");
+				continue;
+			}
 
-	// Tell user about no success
-	if (!success)
-	{
-		LogError("FirebaseInterface: ", "Data transfer to Firebase failed.");
+			// Transform retrieved value
+			ETags[i] = ETag;
+			values[i] = rFunctions[i](ParseInteger(rResponse.body));
+			retry.push_back(i);
+		}
+		open = std::move(retry);
 	}
 
-	return value;
+	return values;
 }
 
 // #######################
@@ -675,22 +654,29 @@ FirebaseMailer::FirebaseMailer()
 			// Wait for data
 			{
 				std::unique_lock<std::mutex> lock(*pMutex); // acquire lock
-				pConditionVariable->wait(
-					lock, // lock that is handled by condition variable
-					[pCommandQueue, pShouldStop]
-					{
-						return !pCommandQueue->empty() || *pShouldStop; // condition is either there are some commands or it is called to stop and becomes joinable
-					}); // hand over locking to the conidition variable which waits for notification by main thread
+				auto condition = [pCommandQueue, pShouldStop]
+				{
+					return !pCommandQueue->empty() || *pShouldStop; // condition is either there are some commands or it is called to stop and becomes joinable
+				};
+				if (interface.HasPending()) // failed commands are retried after some time, even without new commands
+				{
+					pConditionVariable->wait_for(lock, std::chrono::seconds(setup::FIREBASE_RETRY_INTERVAL), condition);
+				}
+				else
+				{
+					pConditionVariable->wait(lock, condition); // hand over locking to the conidition variable which waits for notification by main thread
+				}
 				localCommandQueue = std::move(*pCommandQueue); // move content of command queue to local one
 				pCommandQueue->clear(); // clear original queue
 				lock.unlock(); // do not trust the scope stuff. But should be not necessary
 			}
 
-			// Work on commands
+			// Work on commands, deferred ones are performed together afterwards
 			for (const auto& rCommand : localCommandQueue)
 			{
 				(*rCommand.get())(interface);
 			}
+			interface.Flush();
 		}
 
 		// Collect last commands before shutdown
@@ -703,9 +689,19 @@ FirebaseMailer::FirebaseMailer()
 		{
 			(*rCommand.get())(interface);
 		}
+		interface.Flush();
 	}));
 }
 
+bool FirebaseMailer::PushBack_Journal(std::string fullpath)
+{
+	// Add command to queue, take parameters as copy
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		rInterface.OpenJournal(fullpath);
+	})));
+}
+
 bool FirebaseMailer::PushBack_Login(std::string email, std::string password, bool useDriftMap, std::promise<std::string>* pPromise)
 {
 	// Add command to queue, take parameters as copy
@@ -760,6 +756,15 @@ bool FirebaseMailer::PushBack_Put(FirebaseJSONKey key, json value, std::string s
 	})));
 }
 
+bool FirebaseMailer::PushBack_Append(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, json value, std::string subpath)
+{
+	// Add command to queue, take parameters as copy
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		rInterface.Append(countKey, recordKey, value, subpath);
+	})));
+}
+
 bool FirebaseMailer::PushBack_Get(FirebaseIntegerKey key, std::promise<int>* pPromise)
 {
 	// Add command to queue, take parameters as copy
@@ -4,6 +4,7 @@
 //============================================================================
 // Singleton which receives and sends data to Firebase. The mailer manages
 // the command queue and the interface the connection to the Firebase.
+// Commands which could not be uploaded are kept in a journal on disk.
 // Mailer access is threadsafe.
 
 #ifndef FIREBASEMAILER_H_
@@ -11,6 +12,8 @@
 
 #include "src/Setup.h"
 #include "src/Award.h"
+#include "src/Utils/HttpTransport.h"
+#include "src/Singletons/FirebaseJournal.h"
 #include "submodules/json/src/json.hpp"
 #include <string>
 #include <deque>
@@ -18,6 +21,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <memory>
 
 // Available database keys
 enum class FirebaseIntegerKey	{ 
@@ -318,7 +322,11 @@ private:
 	template<typename T>
 	static std::string BuildFirebaseKey(T key, std::string uid)
 	{
-		return "users/" + uid + "/" + FirebaseAddress<T>(key);
+		return BuildFirebasePath(FirebaseAddress<T>(key), uid);
+	}
+	static std::string BuildFirebasePath(std::string path, std::string uid)
+	{
+		return "users/" + uid + "/" + path;
 	}
 
 public:
@@ -344,12 +352,14 @@ public:
 	void Pause() { _paused = true; }
 
 	// Available commands. Returns whether successful pushed back the command. If not, do not wait for the promise to be fulfilled!
+	bool PushBack_Journal	(std::string fullpath); // keeps not uploaded puts, transforms and appends on disk and replays the ones of previous runs
 	bool PushBack_Login		(std::string email, std::string password, bool useDriftMap, std::promise<std::string>* pPromise = nullptr); // promise delivers initial idToken value and sets internal start index
-	bool PushBack_Transform	(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // promise delivers future database value
+	bool PushBack_Transform	(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // promise delivers future database value, or exception if transform could not be applied yet
 	bool PushBack_Maximum	(FirebaseIntegerKey key, int value, std::promise<int>* pPromise = nullptr); // promise delivers future database value
 	bool PushBack_Put		(FirebaseIntegerKey key, int value, std::string subpath = "");
 	bool PushBack_Put		(FirebaseStringKey key, std::string value, std::string subpath = "");
 	bool PushBack_Put		(FirebaseJSONKey key, nlohmann::json value, std::string subpath = ""); // json return value might be empty in case of failure
+	bool PushBack_Append	(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json value, std::string subpath = ""); // adds one to count and puts value at subpath followed by previous count
 	bool PushBack_Get		(FirebaseIntegerKey key, std::promise<int>* pPromise);
 	bool PushBack_Get		(FirebaseStringKey key, std::promise<std::string>* pPromise);
 	bool PushBack_Get		(FirebaseJSONKey key, std::promise<nlohmann::json>* pPromise);
@@ -406,23 +416,35 @@ private:
 		// Constructor
 		FirebaseInterface(IdToken* pIdToken, std::atomic<int>* pStartIndex) : _pIdToken(pIdToken), _pStartIndex(pStartIndex) {}
 
+		// Open journal and replay its records. Not uploaded commands are written to the journal from now on
+		void OpenJournal(std::string fullpath);
+
 		// Log in. Return whether successful
 		bool Login(std::string email, std::string password, bool useDriftMap, std::promise<std::string>* pPromise);
 
-		// Simple put functionality. Replaces existing value if available, no ETag used
+		// Simple put functionality. Replaces existing value if available, no ETag used. Deferred until flush
 		template<typename T>
-		void Put(T key, typename FirebaseValue<T>::type value, std::string subpath = ""); // delegates private put
+		void Put(T key, typename FirebaseValue<T>::type value, std::string subpath = "");
+
+		// Add one to count and put value at subpath followed by previous count. Deferred until flush, where appends and transforms of same count are combined
+		void Append(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json value, std::string subpath = "");
 
 		// Get
 		template<typename T>
 		void Get(T key, std::promise<typename FirebaseValue<T>::type>* pPromise); // delegates private get
 
-		// Transform value
-		void Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
+		// Transform value. Deferred until flush, where transforms of same key are combined
+		void Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set. Exception is set if not applied
 
 		// Save maximum in database, either my value or the one in the database
 		void Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
 
+		// Perform deferred puts, transforms and appends, requests for different keys are in flight at the same time. Failed ones stay deferred
+		void Flush();
+
+		// Whether there are deferred puts, transforms or appends
+		bool HasPending() const { return !_pendingPuts.empty() || !_pendingTransforms.empty() || !_pendingAppends.empty(); }
+
 	private:
 
 		// Struct for ETag and database value
@@ -440,19 +462,61 @@ private:
 		// Relogin via refresh token. Returns whether successful
 		bool Relogin();
 
-		// Put single value in database. Uses ETag to check whether ok to put or working on outdated value. Return true if successful, otherwise do it another time, maybe with new value provided by this method
-		template<typename T> // TODO: here on could get rid of templates and just work on JSON objects
-		bool Put(T key, std::string ETag, typename FirebaseValue<T>::type value, std::string& rNewETag, typename FirebaseValue<T>::type& rNewValue, std::string subpath = ""); // fills newETag and newValue if ETag was outdated. Please try again with these values
+		// Request to database, path without ".json" and authentification
+		struct Request
+		{
+			std::string method;
+			std::string path;
+			std::vector<std::string> headers;
+			std::string body;
+		};
+
+		// Deferred put, path relative to user
+		struct PendingPut
+		{
+			std::string path;
+			std::string body;
+		};
+
+		// Deferred transform, path relative to user
+		struct PendingTransform
+		{
+			std::string path;
+			int delta;
+			std::promise<int>* pPromise;
+		};
+
+		// Deferred append, paths relative to user
+		struct PendingAppend
+		{
+			std::string countPath;
+			std::string recordPath;
+			std::string body;
+		};
+
+		// Defer commands without writing to journal
+		void DeferPut(std::string path, std::string body);
+		void DeferTransform(std::string path, int delta, std::promise<int>* pPromise);
+		void DeferAppend(std::string countPath, std::string recordPath, std::string body);
+
+		// Records of deferred commands for journal, followed by records not replayed yet
+		std::vector<FirebaseJournal::Record> GetPendingRecords() const;
+
+		// Defer commands of journal records which belong to logged in user. Records of other users are kept
+		void ReplayJournalRecords();
+
+		// Perform requests at the same time with current id token. Requests failing for other reasons than ETag are repeated once after relogin
+		std::vector<HttpTransport::Response> Perform(const std::vector<Request>& rRequests);
 
 		// Get of JSON structure by key. Returns empty structure if not available
 		DBEntry Get(std::string key);
 
-		// Apply function on value in database. Returns final value that is stored in database
-		int Apply(FirebaseIntegerKey key, std::function<int(int)> function); // function parameter takes value from database on which function is applied. Its return value is then written to database
+		// Apply functions on values in database, paths at the same time. Uses ETag to check whether working on outdated value and retries. Returns final values that are stored in database and whether they could be stored
+		std::vector<int> Apply(const std::vector<std::string>& rPaths, const std::vector<std::function<int(int)> >& rFunctions, std::vector<bool>& rSuccesses); // function parameter takes value from database on which function is applied. Its return value is then written to database
 
 		// Constants
 		const std::string _API_KEY = setup::FIREBASE_API_KEY;
-		const std::string _URL = "https://" + setup::FIREBASE_PROJECT_ID + ".firebaseio.com";
+		const std::string _URL = setup::FIREBASE_DATABASE_URL;
 
 		// Members
 		IdToken* _pIdToken = nullptr; // set at construction
@@ -461,6 +525,12 @@ private:
 		std::string _uid = "0"; // user identifier (initialized with something that indicates "broken")
 		std::string _email = ""; // taken from login attempt
 		std::string _password = ""; // taken from login attempt (guess this is bad design to store password, but simplies everything a lot)
+		HttpTransport _transport; // keeps connections alive
+		std::vector<PendingPut> _pendingPuts;
+		std::vector<PendingTransform> _pendingTransforms;
+		std::vector<PendingAppend> _pendingAppends;
+		std::unique_ptr<FirebaseJournal> _upJournal; // not uploaded commands, nullptr if not opened
+		std::vector<FirebaseJournal::Record> _journalRecords; // records of previous runs waiting for login of their user
 	};
 	// #################################
 
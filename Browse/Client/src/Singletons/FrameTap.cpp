@@ -0,0 +1,221 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "FrameTap.h"
+#include "src/Setup.h"
+#include <cstring>
+
+FrameTapSubscription::FrameTapSubscription(std::function<void(std::shared_ptr<const TapFrame>)> callback, int queueCapacity) :
+	_callback(callback),
+	_queueCapacity(queueCapacity)
+{
+	_upThread = std::unique_ptr<std::thread>(new std::thread([this]() { this->Work(); }));
+}
+
+FrameTapSubscription::~FrameTapSubscription()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shouldStop = true;
+	}
+	_conditionVariable.notify_one();
+	_upThread->join();
+}
+
+void FrameTapSubscription::Push(std::shared_ptr<const TapFrame> spFrame)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		while ((int)_queue.size() >= _queueCapacity)
+		{
+			_queue.pop_front();
+			_droppedCount++;
+		}
+		_queue.push_back(std::move(spFrame));
+	}
+	_conditionVariable.notify_one();
+}
+
+void FrameTapSubscription::Work()
+{
+	while (true)
+	{
+		std::shared_ptr<const TapFrame> spFrame;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_conditionVariable.wait(lock, [this]() { return _shouldStop || !_queue.empty(); });
+			if (_shouldStop) { return; }
+			spFrame = std::move(_queue.front());
+			_queue.pop_front();
+		}
+
+		// Frame is released right after the callback, so pool can recycle it
+		_callback(spFrame);
+		_deliveredCount++;
+	}
+}
+
+FrameTap::FrameTap() : _spPool(std::make_shared<Pool>())
+{
+	// Nothing to do
+}
+
+std::shared_ptr<FrameTapSubscription> FrameTap::Subscribe(
+	std::function<void(std::shared_ptr<const TapFrame>)> callback,
+	int queueCapacity)
+{
+	std::shared_ptr<FrameTapSubscription> spSubscription(new FrameTapSubscription(callback, queueCapacity > 0 ? queueCapacity : 1));
+	std::lock_guard<std::mutex> lock(_mutex);
+	_subscriptions.push_back(spSubscription);
+	return spSubscription;
+}
+
+void FrameTap::Publish(
+	int browserId,
+	int width,
+	int height,
+	unsigned char const * pBuffer,
+	const std::vector<glm::ivec4>& rDirtyRects,
+	bool shown)
+{
+	// Collect living subscriptions and remove expired ones
+	std::vector<std::shared_ptr<FrameTapSubscription> > subscriptions;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		std::vector<std::weak_ptr<FrameTapSubscription> > living;
+		for (const auto& rwpSubscription : _subscriptions)
+		{
+			if (auto spSubscription = rwpSubscription.lock())
+			{
+				subscriptions.push_back(spSubscription);
+				living.push_back(rwpSubscription);
+			}
+		}
+		_subscriptions.swap(living);
+	}
+
+	// Give frames back to pool when nobody listens
+	if (subscriptions.empty())
+	{
+		_latest.clear();
+		return;
+	}
+	if (pBuffer == nullptr || width <= 0 || height <= 0) { return; }
+
+	const size_t size = (size_t)width * (size_t)height * 4;
+	Latest& rLatest = _latest[browserId];
+	rLatest.sequence++;
+
+	// Reuse last frame of browser if all subscriptions have released it, so only dirty rects must be copied
+	std::shared_ptr<TapFrame> spFrame;
+	bool inPlace = false;
+	if (rLatest.spFrame && rLatest.spFrame.use_count() == 1)
+	{
+		// Pairs with release of the references by worker threads, which might have read the pixels
+		std::atomic_thread_fence(std::memory_order_acquire);
+		spFrame = rLatest.spFrame;
+		inPlace = spFrame->width == width && spFrame->height == height && !rDirtyRects.empty();
+	}
+	else
+	{
+		// Still in use by subscriptions, which will give it back to pool
+		rLatest.spFrame.reset();
+		spFrame = Acquire();
+
+		// Give up last frames of other browsers if pool is exhausted
+		if (!spFrame)
+		{
+			for (auto& rPair : _latest)
+			{
+				if (rPair.second.spFrame && rPair.second.spFrame.use_count() == 1)
+				{
+					rPair.second.spFrame.reset();
+				}
+			}
+			spFrame = Acquire();
+		}
+		if (!spFrame)
+		{
+			_droppedCount++;
+			return;
+		}
+	}
+
+	// Copy pixels
+	if (inPlace)
+	{
+		for (const auto& rRect : rDirtyRects)
+		{
+			const int minX = glm::clamp(rRect.x, 0, width);
+			const int minY = glm::clamp(rRect.y, 0, height);
+			const int maxX = glm::clamp(rRect.x + rRect.z, 0, width);
+			const int maxY = glm::clamp(rRect.y + rRect.w, 0, height);
+			if (minX >= maxX) { continue; }
+			const size_t rowBytes = (size_t)(maxX - minX) * 4;
+			for (int y = minY; y < maxY; y++)
+			{
+				const size_t offset = ((size_t)y * (size_t)width + (size_t)minX) * 4;
+				std::memcpy(spFrame->pixels.data() + offset, pBuffer + offset, rowBytes);
+			}
+		}
+	}
+	else
+	{
+		spFrame->pixels.resize(size);
+		std::memcpy(spFrame->pixels.data(), pBuffer, size);
+	}
+
+	// Describe frame
+	spFrame->browserId = browserId;
+	spFrame->sequence = rLatest.sequence;
+	spFrame->width = width;
+	spFrame->height = height;
+	spFrame->shown = shown;
+	if (rDirtyRects.empty())
+	{
+		spFrame->dirtyRects.assign(1, glm::ivec4(0, 0, width, height));
+	}
+	else
+	{
+		spFrame->dirtyRects = rDirtyRects;
+	}
+	rLatest.spFrame = spFrame;
+
+	// Share frame read-only with subscriptions
+	for (const auto& rspSubscription : subscriptions)
+	{
+		rspSubscription->Push(spFrame);
+	}
+}
+
+std::shared_ptr<TapFrame> FrameTap::Acquire()
+{
+	std::unique_ptr<TapFrame> upFrame;
+	{
+		std::lock_guard<std::mutex> lock(_spPool->mutex);
+		if (!_spPool->free.empty())
+		{
+			upFrame = std::move(_spPool->free.back());
+			_spPool->free.pop_back();
+		}
+		else if (_spPool->allocatedCount < setup::FRAME_TAP_POOL_SIZE)
+		{
+			upFrame = std::unique_ptr<TapFrame>(new TapFrame);
+			_spPool->allocatedCount++;
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+
+	// Deleter puts frame back into pool, keeping the memory of its pixels
+	std::shared_ptr<Pool> spPool = _spPool;
+	return std::shared_ptr<TapFrame>(upFrame.release(), [spPool](TapFrame* pFrame)
+	{
+		std::lock_guard<std::mutex> lock(spPool->mutex);
+		spPool->free.push_back(std::unique_ptr<TapFrame>(pFrame));
+	});
+}
@@ -0,0 +1,147 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Singleton to share paints of web views with consumers which need pixels
+// on the CPU, e.g. for recordings or analytics. Renderer publishes each paint
+// into a frame of a bounded pool, which is shared read-only by all
+// subscriptions. Each subscription has a worker thread and a bounded queue.
+// If a consumer is too slow, its oldest queued frames are dropped instead of
+// stalling the paint. A subscription is removed when it is destroyed.
+
+#ifndef FRAMETAP_H_
+#define FRAMETAP_H_
+
+#include "src/Utils/glmWrapper.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+// Frame of one web view. Frames are recycled by the tap after all references are released
+struct TapFrame
+{
+	int browserId = -1;
+	unsigned long long sequence = 0; // per browser, increased by every published paint
+	int width = 0;
+	int height = 0;
+	bool shown = false; // whether browser was shown right away, i.e. is in active tab
+	std::vector<unsigned char> pixels; // BGRA, rows without padding
+	std::vector<glm::ivec4> dirtyRects; // x, y, width and height of regions changed since frame with previous sequence
+};
+
+// Subscription to frames. Callback is executed on worker thread of subscription.
+// Callback must not destroy the subscription. If sequence of frames of one browser
+// has gaps, frames have been dropped and dirty rects do not cover all changes
+class FrameTapSubscription
+{
+public:
+
+	// Destructor, stops worker thread. Queued frames are not delivered anymore
+	~FrameTapSubscription();
+
+	// Subscription owns thread, so it must not be copied
+	FrameTapSubscription(const FrameTapSubscription&) = delete;
+	FrameTapSubscription& operator=(const FrameTapSubscription&) = delete;
+
+	// Count of frames which were dropped because queue was full
+	long long GetDroppedCount() const { return _droppedCount; }
+
+	// Count of frames which were delivered to callback
+	long long GetDeliveredCount() const { return _deliveredCount; }
+
+private:
+
+	// FrameTap creates subscriptions and pushes frames
+	friend class FrameTap;
+
+	// Constructor, starts worker thread
+	FrameTapSubscription(std::function<void(std::shared_ptr<const TapFrame>)> callback, int queueCapacity);
+
+	// Push frame into queue, drops oldest frame if queue is full
+	void Push(std::shared_ptr<const TapFrame> spFrame);
+
+	// Loop of worker thread
+	void Work();
+
+	// Members
+	std::function<void(std::shared_ptr<const TapFrame>)> _callback;
+	int _queueCapacity;
+	std::deque<std::shared_ptr<const TapFrame> > _queue;
+	std::mutex _mutex;
+	std::condition_variable _conditionVariable;
+	bool _shouldStop = false;
+	std::unique_ptr<std::thread> _upThread;
+	std::atomic<long long> _droppedCount = 0;
+	std::atomic<long long> _deliveredCount = 0;
+};
+
+// Actual class
+class FrameTap
+{
+public:
+
+	// Get instance
+	static FrameTap& instance()
+	{
+		static FrameTap _instance;
+		return _instance;
+	}
+
+	// Subscribe to frames of all browsers. Frames are delivered until returned subscription is destroyed
+	std::shared_ptr<FrameTapSubscription> Subscribe(
+		std::function<void(std::shared_ptr<const TapFrame>)> callback,
+		int queueCapacity);
+
+	// Publish paint of browser. Should be called by renderer, always from the same thread.
+	// Does nothing without subscriptions
+	void Publish(
+		int browserId,
+		int width,
+		int height,
+		unsigned char const * pBuffer,
+		const std::vector<glm::ivec4>& rDirtyRects,
+		bool shown);
+
+	// Count of paints which were not published because all frames of pool were in use
+	long long GetDroppedCount() const { return _droppedCount; }
+
+private:
+
+	// Pool of frames, shared with deleters of frames which might be released after the tap
+	struct Pool
+	{
+		std::mutex mutex;
+		std::vector<std::unique_ptr<TapFrame> > free;
+		int allocatedCount = 0; // frames in use or in free list
+	};
+
+	// Last published frame of browser
+	struct Latest
+	{
+		std::shared_ptr<TapFrame> spFrame; // reused in place when released by all subscriptions
+		unsigned long long sequence = 0; // increased by every paint, also by dropped ones
+	};
+
+	// Take frame from pool. Returns nullptr if pool is exhausted
+	std::shared_ptr<TapFrame> Acquire();
+
+	// Members
+	std::mutex _mutex; // guards subscriptions
+	std::vector<std::weak_ptr<FrameTapSubscription> > _subscriptions;
+	std::shared_ptr<Pool> _spPool;
+	std::map<int, Latest> _latest; // per browser, only accessed by publishing thread
+	std::atomic<long long> _droppedCount = 0;
+
+	// Private copy / assignment constructors
+	FrameTap();
+	FrameTap(const FrameTap&) {}
+	FrameTap& operator = (const FrameTap &) { return *this; }
+};
+
+#endif // FRAMETAP_H_
@@ -0,0 +1,220 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "HistoryJournal.h"
+#include "src/Utils/Logger.h"
+#include "src/Utils/Helper.h"
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+
+// Tags of records
+static const char PAGE_RECORD = 'P';
+static const char TITLE_RECORD = 'T';
+
+// Upper limit of string length in record, longer ones indicate corrupted journal
+static const unsigned int MAX_RECORD_STRING_LENGTH = 1 << 20;
+
+HistoryJournal::HistoryJournal(std::string fullpath) : _fullpath(fullpath)
+{
+	// Create writer thread, which keeps journal open for appending
+	std::string path = _fullpath;
+	auto* pMutex = &_jobMutex;
+	auto* pConditionVariable = &_conditionVariable;
+	auto* pJobQueue = &_jobQueue;
+	auto const * pShouldStop = &_shouldStop; // read-only
+	_upThread = std::unique_ptr<std::thread>(new std::thread([path, pMutex, pConditionVariable, pJobQueue, pShouldStop]()
+	{
+		std::ofstream stream(path, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+		std::deque<Job> localJobQueue;
+		bool stop = false;
+		while (!stop)
+		{
+			// Wait for jobs
+			{
+				std::unique_lock<std::mutex> lock(*pMutex);
+				pConditionVariable->wait(lock, [pJobQueue, pShouldStop]
+				{
+					return !pJobQueue->empty() || *pShouldStop;
+				});
+				localJobQueue = std::move(*pJobQueue);
+				pJobQueue->clear();
+				stop = *pShouldStop; // remaining jobs are still executed below
+			}
+
+			// Work on jobs and make records persistent
+			for (const auto& rJob : localJobQueue)
+			{
+				rJob(stream);
+			}
+			stream.flush();
+		}
+	}));
+}
+
+HistoryJournal::~HistoryJournal()
+{
+	// Tell thread to stop after pending jobs
+	{
+		std::lock_guard<std::mutex> lock(_jobMutex);
+		_shouldStop = true;
+	}
+	_conditionVariable.notify_all();
+	_upThread->join();
+}
+
+bool HistoryJournal::Load(const std::string& rFullpath, std::vector<Entry>& rEntries, int& rRecordCount)
+{
+	rEntries.clear();
+	rRecordCount = 0;
+
+	// Open journal
+	std::ifstream stream(rFullpath, std::ios_base::in | std::ios_base::binary);
+	if (!stream.is_open()) { return false; }
+
+	// Readers of fields
+	auto readInt = [&](int& rValue) -> bool
+	{
+		return (bool)stream.read(reinterpret_cast<char*>(&rValue), sizeof(rValue));
+	};
+	auto readString = [&](std::string& rString) -> bool
+	{
+		unsigned int length = 0;
+		if (!stream.read(reinterpret_cast<char*>(&length), sizeof(length)) || length > MAX_RECORD_STRING_LENGTH) { return false; }
+		rString.resize(length);
+		return length == 0 || (bool)stream.read(&rString[0], length);
+	};
+
+	// Read record by record, maps id to index of latest page with that id
+	std::unordered_map<int, size_t> indices;
+	char tag = 0;
+	while (stream.get(tag))
+	{
+		int id = 0;
+		bool success = readInt(id);
+		if (success && tag == PAGE_RECORD)
+		{
+			Entry entry;
+			entry.id = id;
+			success = readString(entry.URL) && readString(entry.title);
+			if (success)
+			{
+				indices[id] = rEntries.size();
+				rEntries.push_back(std::move(entry));
+			}
+		}
+		else if (success && tag == TITLE_RECORD)
+		{
+			std::string title;
+			success = readString(title);
+			if (success)
+			{
+				auto it = indices.find(id);
+				if (it != indices.end()) { rEntries[it->second].title = std::move(title); }
+			}
+		}
+		else
+		{
+			success = false;
+		}
+
+		// Incomplete record at the end, e.g. after crash while writing. Ignored until next compaction
+		if (!success)
+		{
+			LogInfo("HistoryJournal: Stopped reading at corrupted record after ", rRecordCount, " records");
+			rRecordCount = std::numeric_limits<int>::max(); // enforces compaction
+			break;
+		}
+		rRecordCount++;
+	}
+
+	return true;
+}
+
+void HistoryJournal::AppendPage(int id, const std::string& rURL, const std::string& rTitle)
+{
+	std::string record = EncodePage(id, rURL, rTitle);
+	PushBackJob([record](std::ofstream& rStream) { rStream.write(record.data(), record.size()); });
+	_recordCount++;
+}
+
+void HistoryJournal::AppendTitle(int id, const std::string& rTitle)
+{
+	std::string record = EncodeTitle(id, rTitle);
+	PushBackJob([record](std::ofstream& rStream) { rStream.write(record.data(), record.size()); });
+	_recordCount++;
+}
+
+void HistoryJournal::Compact(std::vector<Entry> entries)
+{
+	_recordCount = (int)entries.size();
+	std::string path = _fullpath;
+	auto spEntries = std::make_shared<std::vector<Entry> >(std::move(entries));
+	PushBackJob([path, spEntries](std::ofstream& rStream)
+	{
+		// Write entries into temporary file
+		const std::string temporaryPath = path + ".tmp";
+		{
+			std::ofstream temporary(temporaryPath, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+			for (const auto& rEntry : *spEntries)
+			{
+				const std::string record = EncodePage(rEntry.id, rEntry.URL, rEntry.title);
+				temporary.write(record.data(), record.size());
+			}
+			if (!temporary)
+			{
+				LogError("HistoryJournal: Failed to write compacted journal");
+				return;
+			}
+		}
+
+		// Replace journal by temporary file
+		rStream.close();
+		if (!ReplaceFileAtomically(temporaryPath, path))
+		{
+			LogError("HistoryJournal: Failed to replace journal by compacted one");
+		}
+		rStream.clear();
+		rStream.open(path, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+	});
+}
+
+void HistoryJournal::PushBackJob(Job job)
+{
+	{
+		std::lock_guard<std::mutex> lock(_jobMutex);
+		_jobQueue.push_back(std::move(job));
+	}
+	_conditionVariable.notify_all();
+}
+
+void HistoryJournal::EncodeInt(std::string& rRecord, int value)
+{
+	rRecord.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void HistoryJournal::EncodeString(std::string& rRecord, const std::string& rString)
+{
+	const unsigned int length = (unsigned int)std::min(rString.size(), (size_t)MAX_RECORD_STRING_LENGTH);
+	rRecord.append(reinterpret_cast<const char*>(&length), sizeof(length));
+	rRecord.append(rString.data(), length);
+}
+
+std::string HistoryJournal::EncodePage(int id, const std::string& rURL, const std::string& rTitle)
+{
+	std::string record(1, PAGE_RECORD);
+	EncodeInt(record, id);
+	EncodeString(record, rURL);
+	EncodeString(record, rTitle);
+	return record;
+}
+
+std::string HistoryJournal::EncodeTitle(int id, const std::string& rTitle)
+{
+	std::string record(1, TITLE_RECORD);
+	EncodeInt(record, id);
+	EncodeString(record, rTitle);
+	return record;
+}
@@ -0,0 +1,92 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Append-only journal of history on hard disk. Changes are written as small
+// binary records by a background thread, so navigation does not wait for disk
+// access. Compaction rewrites the journal with the current entries only.
+// Record layout, integers in host byte order:
+//	'P' : int32 id, uint32 length, URL, uint32 length, title (page added)
+//	'T' : int32 id, uint32 length, title (title of page changed)
+// Ids are only unique within one session. Records are applied in order, so a
+// title record belongs to the latest page record with the same id.
+
+#ifndef HISTORYJOURNAL_H_
+#define HISTORYJOURNAL_H_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <fstream>
+
+class HistoryJournal
+{
+public:
+
+	// Entry of history as stored in journal
+	struct Entry
+	{
+		int id;
+		std::string URL;
+		std::string title;
+	};
+
+	// Constructor, starts writer thread
+	HistoryJournal(std::string fullpath);
+
+	// Destructor, writes pending records and stops writer thread
+	virtual ~HistoryJournal();
+
+	// Read journal record by record. Entries are ordered from oldest to newest. Returns whether successful
+	static bool Load(const std::string& rFullpath, std::vector<Entry>& rEntries, int& rRecordCount);
+
+	// Append record of added page
+	void AppendPage(int id, const std::string& rURL, const std::string& rTitle);
+
+	// Append record of changed title
+	void AppendTitle(int id, const std::string& rTitle);
+
+	// Replace journal by records of given entries, ordered from oldest to newest
+	void Compact(std::vector<Entry> entries);
+
+	// Count of records in journal, including pending ones
+	int GetRecordCount() const { return _recordCount; }
+
+	// Set count of records after loading
+	void SetRecordCount(int recordCount) { _recordCount = recordCount; }
+
+private:
+
+	// Job executed by writer thread with open journal stream
+	typedef std::function<void(std::ofstream&)> Job;
+
+	// Add job to queue of writer thread
+	void PushBackJob(Job job);
+
+	// Encode records
+	static void EncodeInt(std::string& rRecord, int value);
+	static void EncodeString(std::string& rRecord, const std::string& rString);
+	static std::string EncodePage(int id, const std::string& rURL, const std::string& rTitle);
+	static std::string EncodeTitle(int id, const std::string& rTitle);
+
+	// Fullpath to journal file
+	std::string _fullpath;
+
+	// Count of records in journal, only accessed by owner
+	int _recordCount = 0;
+
+	// Threading
+	std::mutex _jobMutex; // mutex for access of job queue
+	std::condition_variable _conditionVariable; // used to wake up thread at available work
+	std::deque<Job> _jobQueue; // executed sequentially within thread
+	std::unique_ptr<std::thread> _upThread;
+	std::atomic<bool> _shouldStop = false; // written by this, read by thread
+};
+
+#endif // HISTORYJOURNAL_H_
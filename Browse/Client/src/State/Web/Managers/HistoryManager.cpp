@@ -10,6 +10,12 @@
 #include "submodules/eyeGUI/externals/TinyXML2/tinyxml2.h"
 #include <iterator>
 
+// Journal is compacted when it holds that many times more records than pages in history
+static const int JOURNAL_COMPACTION_RATIO = 2;
+
+// Journal is not compacted before holding that many records
+static const int JOURNAL_COMPACTION_MIN_RECORDS = 1000;
+
 const std::vector<std::string> HistoryManager::_filterURLs
 {
 	"about:blank",
@@ -22,10 +28,19 @@ HistoryManager::HistoryManager(std::string userDirectory)
 {
 	// Fill members
 	_fullpathHistory = userDirectory + HISTORY_FILE;
+	_fullpathJournal = userDirectory + HISTORY_JOURNAL_FILE;
 	_spPages = std::make_shared<std::deque<std::shared_ptr<Page> > >();
 
-	// Load existing history
-	if (!LoadHistory()) { LogInfo("HistoryManager: No history file found or parsing error"); }
+	// Load existing history, import XML file of older versions at first start
+	int recordCount = 0;
+	bool loaded = LoadHistory(recordCount);
+	bool imported = !loaded && LoadXMLHistory();
+	if (!loaded && !imported) { LogInfo("HistoryManager: No history file found or parsing error"); }
+
+	// Open journal for writing
+	_upJournal = std::unique_ptr<HistoryJournal>(new HistoryJournal(_fullpathJournal));
+	_upJournal->SetRecordCount(recordCount);
+	CompactIfNecessary(imported);
 }
 
 HistoryManager::~HistoryManager()
@@ -60,107 +75,48 @@ std::shared_ptr<const std::deque<std::shared_ptr<HistoryManager::Page> > > Histo
 	return _spPages;
 }
 
-bool HistoryManager::SavePageInHistory(bool initialStoring, int id, std::string URL, std::string title)
+void HistoryManager::SavePageInHistory(bool initialStoring, int id, std::string URL, std::string title)
 {
-	// Try to open XML file
-	tinyxml2::XMLDocument doc;
-	tinyxml2::XMLError result = doc.LoadFile(_fullpathHistory.c_str());
-
-	// Try to create XML file on failure
-	tinyxml2::XMLNode* pRoot = NULL;
-	if (result != tinyxml2::XMLError::XML_SUCCESS)
-	{
-		// Create and insert root
-		pRoot = doc.NewElement("history");
-		doc.InsertFirstChild(pRoot);
-
-		// Try to save file
-		result = doc.SaveFile(_fullpathHistory.c_str());
-
-		// Return at failure
-		if (result != tinyxml2::XMLError::XML_SUCCESS)
-		{
-			LogInfo("HistoryManager: Failed to create history file");
-			return false;
-		}
-	}
-	else
-	{
-		// Fetch root node when file exists
-		pRoot = doc.FirstChild();
-	}
-
-	// Check whether root exists
-	if (pRoot == NULL)
-	{
-		LogInfo("HistoryManager: Failed to add page to history");
-		return false;
-	}
-
-	// Check whether this is the initial storing or an update
+	// Append record to journal, written by background thread
 	if (initialStoring)
 	{
-		// Create element for page
-		tinyxml2::XMLElement* pElement = doc.NewElement("page");
-		pElement->SetAttribute("url", URL.c_str());
-		pElement->SetAttribute("title", title.c_str());
-		pElement->SetAttribute("id", id); // this is used to identify the entry for later changes
-
-		// Append to top of XML file
-		pRoot->InsertFirstChild(pElement);
+		_upJournal->AppendPage(id, URL, title);
 	}
 	else
 	{
-		// Find the element by URL and id
-		tinyxml2::XMLElement* pElement = pRoot->FirstChildElement("page");
-		while (pElement != NULL)
-		{
-			// Check for both URL and id
-			if (pElement->Attribute("url") == URL && pElement->IntAttribute("id") == id)
-			{
-				// Update title
-				pElement->SetAttribute("title", title.c_str());
-				break;
-			}
-			else // continue search
-			{
-				pElement = pElement->NextSiblingElement("page");
-			}
-		}
+		_upJournal->AppendTitle(id, title);
 	}
-	
-	// Check length of vector and delete history if too many pages have been saved
+
+	// Check length of deque and delete history if too many pages have been saved. Journal keeps them until compaction
 	int pagesSize = (int)_spPages->size();
 	if (pagesSize > (int)setup::HISTORY_MAX_PAGE_COUNT)
 	{
-		// Count of pages that should be deleted
-		int deleteCount = pagesSize - setup::HISTORY_MAX_PAGE_COUNT;
+		_spPages->erase(_spPages->begin() + setup::HISTORY_MAX_PAGE_COUNT, _spPages->end());
+	}
 
-		// Delete older ones from vector
-		_spPages->erase(_spPages->end() - deleteCount, _spPages->end());
+	// Get rid of outdated records
+	CompactIfNecessary();
+}
 
-		// Delete older ones from XML file
-		for (int i = 0; i < deleteCount; i++)
-		{
-			auto pLastChild = pRoot->LastChild();
-			pRoot->DeleteChild(pLastChild);
-		}
-	}
+bool HistoryManager::LoadHistory(int& rRecordCount)
+{
+	// Clean local history copy
+	_spPages->clear();
 
-	// Try to save file
-	result = doc.SaveFile(_fullpathHistory.c_str());
+	// Read journal record by record
+	std::vector<HistoryJournal::Entry> entries;
+	if (!HistoryJournal::Load(_fullpathJournal, entries, rRecordCount)) { return false; }
 
-	// Log at failure
-	if (result != tinyxml2::XMLError::XML_SUCCESS)
+	// Collect newest pages, newest first
+	for (auto it = entries.rbegin(); it != entries.rend() && _spPages->size() < setup::HISTORY_MAX_PAGE_COUNT; ++it)
 	{
-		LogInfo("HistoryManager: Failed to save history file");
-		return false;
+		_spPages->push_back(std::make_shared<Page>(this, std::move(it->URL), std::move(it->title)));
 	}
 
 	return true;
 }
 
-bool HistoryManager::LoadHistory()
+bool HistoryManager::LoadXMLHistory()
 {
     // Clean local history copy
 	_spPages->clear();
@@ -180,7 +136,7 @@ bool HistoryManager::LoadHistory()
 	tinyxml2::XMLElement* pElement = pRoot->FirstChildElement("page");
 	if (pElement == NULL) { return true; } // nothing found but somehow successful
 
-    // Collect pages (not checked whether maximum number exceeded. Only done at saving)
+    // Collect pages
 	do
 	{
 		// Preparation
@@ -210,12 +166,33 @@ bool HistoryManager::LoadHistory()
 			_spPages->push_back(std::make_shared<Page>(this, URL, title));
 		}
 
-	} while ((pElement = pElement->NextSiblingElement("page")) != NULL);
+	} while ((pElement = pElement->NextSiblingElement("page")) != NULL && _spPages->size() < setup::HISTORY_MAX_PAGE_COUNT);
 
 	// When you came to here no real errors occured
 	return true;
 }
 
+
+void HistoryManager::CompactIfNecessary(bool force)
+{
+	const int recordCount = _upJournal->GetRecordCount();
+	if (!force
+		&& (recordCount < JOURNAL_COMPACTION_MIN_RECORDS
+			|| recordCount / JOURNAL_COMPACTION_RATIO < (int)_spPages->size()))
+	{
+		return;
+	}
+
+	// Write current pages from oldest to newest
+	std::vector<HistoryJournal::Entry> entries;
+	entries.reserve(_spPages->size());
+	for (auto it = _spPages->rbegin(); it != _spPages->rend(); ++it)
+	{
+		entries.push_back({ (*it)->GetId(), (*it)->GetURL(), (*it)->GetTitle() });
+	}
+	_upJournal->Compact(std::move(entries));
+}
+
 bool HistoryManager::FilterPage(std::string URL) const
 {
 	// Go over filter list and test for substring
@@ -2,7 +2,9 @@
 // Distributed under the Apache License, Version 2.0.
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
-// Manager of history.
+// Manager of history. Pages are stored in an append-only journal, which is
+// compacted when it has grown too much. History of older versions is imported
+// from XML file once.
 // TODO: Id is not necessary for loaded entries, they are only used for pages
 // that are still active and which title might change.
 
@@ -14,6 +16,7 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include "src/State/Web/Managers/HistoryJournal.h"
 
 class HistoryManager
 {
@@ -41,11 +44,17 @@ private:
 	// List of filtered pages which will not be added to history
 	static const std::vector<std::string> _filterURLs;
 
-	// Save history to hard disk. Returns whether successful
-	bool SavePageInHistory(bool initialStoring, int id, std::string URL, std::string title);
+	// Save history to journal
+	void SavePageInHistory(bool initialStoring, int id, std::string URL, std::string title);
 
-	// Load history from hard disk. Returns whether successful
-	bool LoadHistory();
+	// Load history from journal and count its records. Returns whether successful
+	bool LoadHistory(int& rRecordCount);
+
+	// Load history from XML file of older versions. Returns whether successful
+	bool LoadXMLHistory();
+
+	// Rewrite journal with current pages if it has grown too much
+	void CompactIfNecessary(bool force = false);
 
 	// Filter pages like about:blank. Returns true when page should be NOT added
 	bool FilterPage(std::string URL) const;
@@ -53,8 +62,12 @@ private:
 	// Deque of pages
 	std::shared_ptr<std::deque<std::shared_ptr<Page> > > _spPages;
 
-	// Fullpath to history file
+	// Fullpath to history files
 	std::string _fullpathHistory;
+	std::string _fullpathJournal;
+
+	// Journal of history on hard disk
+	std::unique_ptr<HistoryJournal> _upJournal;
 
 public:
 
@@ -71,8 +84,8 @@ public:
 
 		// Read attributes
 		int GetId() const { return _id; }
-		std::string GetURL() const { return _URL; }
-		std::string GetTitle() const { return _title; }
+		const std::string& GetURL() const { return _URL; }
+		const std::string& GetTitle() const { return _title; }
 
 	private:
 
@@ -0,0 +1,231 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "PreviewManager.h"
+
+// Frames waiting for update of previews. Older ones are dropped, previews are recomputed completely then
+static const int PREVIEW_QUEUE_CAPACITY = 2;
+
+PreviewManager::PreviewManager(int level, int detailedLevel) : _level(level), _detailedLevel(detailedLevel)
+{
+	_spSubscription = FrameTap::instance().Subscribe([this](std::shared_ptr<const TapFrame> spFrame)
+	{
+		this->Update(*spFrame);
+	}, PREVIEW_QUEUE_CAPACITY);
+}
+
+bool PreviewManager::GetPreview(int browserId, int& rWidth, int& rHeight, std::vector<unsigned char>& rData, unsigned int& rGeneration) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto iter = _previews.find(browserId);
+	if (iter == _previews.end() || iter->second.pixels.empty()) { return false; }
+	rWidth = iter->second.width;
+	rHeight = iter->second.height;
+	rData = iter->second.pixels;
+	rGeneration = iter->second.generation;
+	return true;
+}
+
+bool PreviewManager::GetDetailedPreview(int browserId, int& rWidth, int& rHeight, std::vector<unsigned char>& rData) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (browserId < 0 || browserId != _detailedBrowserId || _detailedPreview.pixels.empty()) { return false; }
+	rWidth = _detailedPreview.width;
+	rHeight = _detailedPreview.height;
+	rData = _detailedPreview.pixels;
+	return true;
+}
+
+unsigned int PreviewManager::GetGeneration(int browserId) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto iter = _previews.find(browserId);
+	return iter != _previews.end() ? iter->second.generation : 0;
+}
+
+void PreviewManager::RemovePreview(int browserId)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_previews.erase(browserId);
+	if (browserId == _detailedBrowserId)
+	{
+		_detailedBrowserId = -1;
+		_detailedPreview = Preview();
+	}
+	_removedBrowserIds.insert(browserId);
+	_pendingRemovals.push_back(browserId);
+}
+
+void PreviewManager::Update(const TapFrame& rFrame)
+{
+	// Forget working previews of removed browsers, which might not paint anymore
+	std::vector<int> removals;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		removals.swap(_pendingRemovals);
+		if (_removedBrowserIds.count(rFrame.browserId) > 0) { return; }
+	}
+	for (int browserId : removals)
+	{
+		_workingPreviews.erase(browserId);
+		if (browserId == _workingDetailedBrowserId)
+		{
+			_workingDetailedBrowserId = -1;
+			_workingDetailedPreview = WorkingPreview();
+		}
+	}
+
+	// Preview of every browser
+	WorkingPreview& rPreview = _workingPreviews[rFrame.browserId];
+	rPreview.level = _level;
+	Compute(rPreview, rFrame);
+	if (!Publish(rPreview, rFrame.browserId, false)) { return; } // working preview is forgotten with next frame
+
+	// Detailed preview of shown browser, started from scratch when another browser is shown
+	if (rFrame.shown)
+	{
+		if (rFrame.browserId != _workingDetailedBrowserId)
+		{
+			_workingDetailedBrowserId = rFrame.browserId;
+			_workingDetailedPreview = WorkingPreview();
+			_workingDetailedPreview.level = _detailedLevel;
+		}
+		Compute(_workingDetailedPreview, rFrame);
+		Publish(_workingDetailedPreview, rFrame.browserId, true);
+	}
+	else if (rFrame.browserId == _workingDetailedBrowserId)
+	{
+		// Browser has been hidden, release memory of its detailed preview
+		_workingDetailedBrowserId = -1;
+		_workingDetailedPreview = WorkingPreview();
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_detailedBrowserId == rFrame.browserId)
+		{
+			_detailedBrowserId = -1;
+			_detailedPreview = Preview();
+		}
+	}
+}
+
+void PreviewManager::Compute(WorkingPreview& rPreview, const TapFrame& rFrame) const
+{
+	// Dirty rects only cover changes since previous frame, so recompute everything after gap in sequence or resize
+	const bool complete =
+		rPreview.pixels.empty()
+		|| rPreview.frameWidth != rFrame.width
+		|| rPreview.frameHeight != rFrame.height
+		|| rFrame.sequence != rPreview.sequence + 1;
+	rPreview.sequence = rFrame.sequence;
+	if (complete)
+	{
+		rPreview.frameWidth = rFrame.width;
+		rPreview.frameHeight = rFrame.height;
+		rPreview.width = glm::max(1, rFrame.width >> rPreview.level);
+		rPreview.height = glm::max(1, rFrame.height >> rPreview.level);
+		rPreview.pixels.resize((size_t)rPreview.width * (size_t)rPreview.height * 4);
+		UpdateBlocks(rPreview, rFrame, glm::ivec4(0, 0, rFrame.width, rFrame.height));
+	}
+	else
+	{
+		for (const auto& rRect : rFrame.dirtyRects)
+		{
+			UpdateBlocks(rPreview, rFrame, rRect);
+		}
+	}
+}
+
+bool PreviewManager::Publish(WorkingPreview& rPreview, int browserId, bool detailed)
+{
+	// Copy for main thread outside of lock
+	std::vector<unsigned char> pixels;
+	pixels.swap(rPreview.spare);
+	pixels.assign(rPreview.pixels.begin(), rPreview.pixels.end());
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (_removedBrowserIds.count(browserId) > 0) { return false; }
+		Preview& rPublished = detailed ? _detailedPreview : _previews[browserId];
+		if (detailed) { _detailedBrowserId = browserId; }
+		rPublished.width = rPreview.width;
+		rPublished.height = rPreview.height;
+		rPublished.pixels.swap(pixels);
+		rPublished.generation = ++_lastGeneration;
+	}
+	rPreview.spare.swap(pixels);
+	return true;
+}
+
+void PreviewManager::UpdateBlocks(WorkingPreview& rPreview, const TapFrame& rFrame, glm::ivec4 region) const
+{
+	// Clamp region to frame
+	const int minX = glm::clamp(region.x, 0, rFrame.width);
+	const int minY = glm::clamp(region.y, 0, rFrame.height);
+	const int maxX = glm::clamp(region.x + region.z, 0, rFrame.width);
+	const int maxY = glm::clamp(region.y + region.w, 0, rFrame.height);
+	if (minX >= maxX || minY >= maxY) { return; }
+
+	// Pixels are only reordered from BGRA to RGBA at base level
+	if (rPreview.level == 0)
+	{
+		for (int y = minY; y < maxY; y++)
+		{
+			unsigned char const * pSource = rFrame.pixels.data() + ((size_t)y * (size_t)rFrame.width + (size_t)minX) * 4;
+			unsigned char* pTarget = &rPreview.pixels[((size_t)y * (size_t)rPreview.width + (size_t)minX) * 4];
+			for (int i = 0; i < (maxX - minX) * 4; i += 4)
+			{
+				pTarget[i] = pSource[i + 2];
+				pTarget[i + 1] = pSource[i + 1];
+				pTarget[i + 2] = pSource[i];
+				pTarget[i + 3] = pSource[i + 3];
+			}
+		}
+		return;
+	}
+
+	// Blocks covered by region. Last block in row or column also covers remaining pixels, like a mip map
+	const int blockSize = 1 << rPreview.level;
+	const int minBlockX = glm::min(minX / blockSize, rPreview.width - 1);
+	const int minBlockY = glm::min(minY / blockSize, rPreview.height - 1);
+	const int maxBlockX = glm::min((maxX - 1) / blockSize, rPreview.width - 1);
+	const int maxBlockY = glm::min((maxY - 1) / blockSize, rPreview.height - 1);
+
+	// Sum up channels per block. Inner loop runs over contiguous bytes of one row, which compilers vectorize
+	std::vector<unsigned int> sums;
+	for (int blockY = minBlockY; blockY <= maxBlockY; blockY++)
+	{
+		const int beginY = blockY * blockSize;
+		const int endY = (blockY == rPreview.height - 1) ? rFrame.height : beginY + blockSize;
+		for (int blockX = minBlockX; blockX <= maxBlockX; blockX++)
+		{
+			const int beginX = blockX * blockSize;
+			const int endX = (blockX == rPreview.width - 1) ? rFrame.width : beginX + blockSize;
+			const int rowBytes = (endX - beginX) * 4;
+
+			// Sum per byte of row, reduced to channels afterwards
+			sums.assign(rowBytes, 0);
+			for (int y = beginY; y < endY; y++)
+			{
+				unsigned char const * pRow = rFrame.pixels.data() + ((size_t)y * (size_t)rFrame.width + (size_t)beginX) * 4;
+				unsigned int* pSums = sums.data();
+				for (int i = 0; i < rowBytes; i++)
+				{
+					pSums[i] += pRow[i];
+				}
+			}
+			unsigned int channels[4] = { 0, 0, 0, 0 };
+			for (int i = 0; i < rowBytes; i++)
+			{
+				channels[i & 3] += sums[i];
+			}
+
+			// Store average in RGBA order, frame is BGRA
+			const unsigned int count = (unsigned int)((endX - beginX) * (endY - beginY));
+			unsigned char* pBlock = &rPreview.pixels[((size_t)blockY * (size_t)rPreview.width + (size_t)blockX) * 4];
+			pBlock[0] = (unsigned char)(channels[2] / count);
+			pBlock[1] = (unsigned char)(channels[1] / count);
+			pBlock[2] = (unsigned char)(channels[0] / count);
+			pBlock[3] = (unsigned char)(channels[3] / count);
+		}
+	}
+}
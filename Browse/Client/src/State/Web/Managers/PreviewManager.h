@@ -0,0 +1,94 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Manager of low resolution previews of web views, e.g. for the tab overview.
+// Previews are computed from paints shared by the frame tap, on the worker
+// thread of the subscription, so the texture of a web view is never read back.
+// Only blocks covered by dirty rects are recomputed, unless paints have been
+// dropped in between. Previews are kept per browser. The browser which is
+// shown additionally has a detailed preview.
+
+#ifndef PREVIEWMANAGER_H_
+#define PREVIEWMANAGER_H_
+
+#include "src/Singletons/FrameTap.h"
+#include <map>
+#include <vector>
+#include <memory>
+#include <set>
+#include <mutex>
+
+class PreviewManager
+{
+public:
+
+	// Constructor, subscribes to frame tap. Each pixel of preview averages block of web view as in given mip map
+	// level, detailed preview of shown browser uses its own level
+	PreviewManager(int level, int detailedLevel);
+
+	// Get RGBA preview of browser and its generation. Returns whether available
+	bool GetPreview(int browserId, int& rWidth, int& rHeight, std::vector<unsigned char>& rData, unsigned int& rGeneration) const;
+
+	// Get RGBA detailed preview of browser. Returns whether available, which requires browser to be shown
+	bool GetDetailedPreview(int browserId, int& rWidth, int& rHeight, std::vector<unsigned char>& rData) const;
+
+	// Generation of preview of browser, changed by every paint and unique among browsers. Zero if not available
+	unsigned int GetGeneration(int browserId) const;
+
+	// Forget previews of closed browser. Frames of it which are still queued are ignored
+	void RemovePreview(int browserId);
+
+private:
+
+	// Preview of one browser as read by main thread
+	struct Preview
+	{
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels; // RGBA
+		unsigned int generation = 0;
+	};
+
+	// Preview of one browser while it is computed, only accessed by worker thread
+	struct WorkingPreview
+	{
+		int level = 0;
+		int frameWidth = 0;
+		int frameHeight = 0;
+		unsigned long long sequence = 0; // sequence of last frame, see TapFrame
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> pixels; // RGBA
+		std::vector<unsigned char> spare; // pixels given back by last publication, reused for next one
+	};
+
+	// Update previews with frame, called on worker thread of subscription
+	void Update(const TapFrame& rFrame);
+
+	// Bring working preview up to date with frame
+	void Compute(WorkingPreview& rPreview, const TapFrame& rFrame) const;
+
+	// Copy working preview into published one. Lock is only held to swap it in. Returns false if browser has been removed
+	bool Publish(WorkingPreview& rPreview, int browserId, bool detailed);
+
+	// Recompute blocks of preview which are covered by region of frame given as x, y, width and height
+	void UpdateBlocks(WorkingPreview& rPreview, const TapFrame& rFrame, glm::ivec4 region) const;
+
+	// Members
+	int _level;
+	int _detailedLevel;
+	mutable std::mutex _mutex; // guards previews, detailed preview, removed browser ids and generation
+	std::map<int, Preview> _previews;
+	int _detailedBrowserId = -1;
+	Preview _detailedPreview;
+	std::set<int> _removedBrowserIds; // browser ids are not reused by CEF
+	unsigned int _lastGeneration = 0;
+	std::vector<int> _pendingRemovals; // removed browsers whose working previews are not yet forgotten
+	std::map<int, WorkingPreview> _workingPreviews; // only accessed by worker thread, so no lock is held while computing
+	int _workingDetailedBrowserId = -1; // only accessed by worker thread
+	WorkingPreview _workingDetailedPreview; // only accessed by worker thread
+	std::shared_ptr<FrameTapSubscription> _spSubscription; // last member, so worker thread stops first at destruction
+};
+
+#endif // PREVIEWMANAGER_H_
@@ -160,7 +160,7 @@ void History::HistoryButtonListener::down(eyegui::Layout* pLayout, std::string i
 			_pHistory->_collectedURL = URL16;
 			_pHistory->_finished = true;
 			nlohmann::json record = { { "url", URL } };
-			_pHistory->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_HISTORY_USAGE_COUNT, FirebaseJSONKey::GENERAL_HISTORY_USAGE, record);
+			_pHistory->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_HISTORY_USAGE_COUNT, FirebaseJSONKey::GENERAL_HISTORY_USAGE, record);
 		}
 	}
 }
\ No newline at end of file
@@ -226,7 +226,7 @@ void URLInput::URLButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		{
 			_pURLInput->_status = URLInput::Status::MANUAL_URL;
 			nlohmann::json record = { { "charCount", _pURLInput->_collectedURL.length() } };
-			_pURLInput->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_URL_INPUT_COUNT, FirebaseJSONKey::GENERAL_URL_INPUT, record);
+			_pURLInput->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_URL_INPUT_COUNT, FirebaseJSONKey::GENERAL_URL_INPUT, record);
 			LabStreamMailer::instance().Send("URL input done");
 		}
 		else if (id == "com")
@@ -331,7 +331,7 @@ void URLInput::URLButtonListener::down(eyegui::Layout* pLayout, std::string id)
 
 					// Log it
 					nlohmann::json record = { { "url", URL } };
-					_pURLInput->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_BOOKMARK_REMOVAL_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_REMOVAL, record);
+					_pURLInput->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_BOOKMARK_REMOVAL_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_REMOVAL, record);
 					LabStreamMailer::instance().Send("Remove bookmark: " + URL);
 
 					// Reset screen and notify user
@@ -347,7 +347,7 @@ void URLInput::URLButtonListener::down(eyegui::Layout* pLayout, std::string id)
 					_pURLInput->_collectedURL = URL16;
 					_pURLInput->_status = URLInput::Status::BOOKMARK_URL;
 					nlohmann::json record = { { "url", URL } };
-					_pURLInput->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_BOOKMARK_USAGE_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_USAGE, record);
+					_pURLInput->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_BOOKMARK_USAGE_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_USAGE, record);
 					LabStreamMailer::instance().Send("Open bookmark: " + URL);
 				}
 			}
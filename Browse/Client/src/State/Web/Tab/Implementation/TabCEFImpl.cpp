@@ -162,10 +162,7 @@ bool Tab::IsFaviconAlreadyAvailable(std::string img_url)
 void Tab::AddDOMTextInput(int id)
 {
 	
-	std::shared_ptr<DOMTextInput> spNode = std::make_shared<DOMTextInput>(id, this);
-
-	// Add node to ID->node map
-	_TextInputMap.emplace(id, spNode);
+	std::shared_ptr<DOMTextInput> spNode = _TextInputStore.Emplace(id, this);
 
 	/*
 
@@ -185,15 +182,12 @@ void Tab::AddDOMTextInput(int id)
 
 void Tab::AddDOMLink(int id)
 {
-	_TextLinkMap.emplace(id, std::make_shared<DOMLink>(id));
+	_linkIndex.Insert(_TextLinkStore.Emplace(id));
 }
 
 void Tab::AddDOMSelectField(int id)
 {
-	std::shared_ptr<DOMSelectField> spNode = std::make_shared<DOMSelectField>(id, this);
-
-	// Add node to ID->node map
-	_SelectFieldMap.emplace(id, spNode);
+	std::shared_ptr<DOMSelectField> spNode = _SelectFieldStore.Emplace(id, this);
 
 	// Create DOMTrigger
 	std::unique_ptr<SelectFieldTrigger> upDOMTrigger = std::unique_ptr<SelectFieldTrigger>(new SelectFieldTrigger(this, _triggers, spNode));
@@ -210,15 +204,12 @@ void Tab::AddDOMSelectField(int id)
 
 void Tab::AddDOMOverflowElement(int id)
 {
-	_OverflowElementMap.emplace(id, std::make_shared<DOMOverflowElement>(id, this));
+	_OverflowElementStore.Emplace(id, this);
 }
 
 void Tab::AddDOMVideo(int id)
 {
-	std::shared_ptr<DOMVideo> spNode = std::make_shared<DOMVideo>(id, this);
-
-	// Add node to ID->node map
-	_VideoMap.emplace(id, spNode);
+	std::shared_ptr<DOMVideo> spNode = _VideoStore.Emplace(id, this);
 
 	// Create DOMTrigger
 	std::unique_ptr<VideoModeTrigger> upDOMTrigger = std::unique_ptr<VideoModeTrigger>(new VideoModeTrigger(this, _triggers, spNode,
@@ -239,38 +230,38 @@ void Tab::AddDOMVideo(int id)
 
 void Tab::AddDOMCheckbox(int id)
 {
-	_CheckboxMap.emplace(id, std::make_shared<DOMCheckbox>(id, this));
+	_CheckboxStore.Emplace(id, this);
 }
 
 
 std::weak_ptr<DOMTextInput> Tab::GetDOMTextInput(int id)
 {
-	return (_TextInputMap.find(id) != _TextInputMap.end()) ? _TextInputMap.at(id) : std::weak_ptr<DOMTextInput>();
+	return _TextInputStore.GetWeak(id);
 }
 
 std::weak_ptr<DOMLink> Tab::GetDOMLink(int id)
 {
-	return (_TextLinkMap.find(id) != _TextLinkMap.end()) ? _TextLinkMap.at(id) : std::weak_ptr<DOMLink>();
+	return _TextLinkStore.GetWeak(id);
 }
 
 std::weak_ptr<DOMSelectField> Tab::GetDOMSelectField(int id)
 {
-	return (_SelectFieldMap.find(id) != _SelectFieldMap.end()) ? _SelectFieldMap.at(id) : std::weak_ptr<DOMSelectField>();
+	return _SelectFieldStore.GetWeak(id);
 }
 
 std::weak_ptr<DOMOverflowElement> Tab::GetDOMOverflowElement(int id)
 {
-	return (_OverflowElementMap.find(id) != _OverflowElementMap.end()) ? _OverflowElementMap.at(id) : std::weak_ptr<DOMOverflowElement>();
+	return _OverflowElementStore.GetWeak(id);
 }
 
 std::weak_ptr<DOMVideo> Tab::GetDOMVideo(int id)
 {
-	return (_VideoMap.find(id) != _VideoMap.end()) ? _VideoMap.at(id) : std::weak_ptr<DOMVideo>();
+	return _VideoStore.GetWeak(id);
 }
 
 std::weak_ptr<DOMCheckbox> Tab::GetDOMCheckbox(int id)
 {
-	return (_CheckboxMap.find(id) != _CheckboxMap.end()) ? _CheckboxMap.at(id) : std::weak_ptr<DOMCheckbox>();
+	return _CheckboxStore.GetWeak(id);
 }
 
 
@@ -287,40 +278,42 @@ void Tab::ClearDOMNodes()
 	_selectFieldTriggers.clear();
 	_videoModeTriggers.clear();
 
-	// Clear ID->node maps
-	_TextLinkMap.clear();
-	_TextInputMap.clear();
-	_SelectFieldMap.clear();
-	_VideoMap.clear();
-	_CheckboxMap.clear();
+	// Clear node stores
+	_TextLinkStore.Clear();
+	_linkIndex.Clear();
+	_TextInputStore.Clear();
+	_SelectFieldStore.Clear();
+	_VideoStore.Clear();
+	_CheckboxStore.Clear();
 
 	// Clear fixed elements
 	_fixedElements.clear();
 
 	// Clear overflow elements
-	_OverflowElementMap.clear();
+	_OverflowElementStore.Clear();
 }
 
 void Tab::RemoveDOMTextInput(int id)
 {
 	if (_textInputTriggers.find(id) != _textInputTriggers.end()) { _textInputTriggers.erase(id); }
-	if (_TextInputMap.find(id) != _TextInputMap.end()) { _TextInputMap.erase(id); }
+	_TextInputStore.Remove(id);
 }
 
 void Tab::RemoveDOMLink(int id)
 {
-	if (_TextLinkMap.find(id) != _TextLinkMap.end()) { _TextLinkMap.erase(id); }
+	_TextLinkStore.Remove(id);
+	_linkIndex.Remove(id);
 }
 
 void Tab::RemoveDOMSelectField(int id)
 {
 	if (_selectFieldTriggers.find(id) != _selectFieldTriggers.end()) { _selectFieldTriggers.erase(id); }
-	if (_SelectFieldMap.find(id) != _SelectFieldMap.end()) { _SelectFieldMap.erase(id); }
+	_SelectFieldStore.Remove(id);
 }
 
 void Tab::RemoveDOMOverflowElement(int id)
 {
-	if (_OverflowElementMap.find(id) != _OverflowElementMap.end()) { _OverflowElementMap.erase(id); }
+	_OverflowElementStore.Remove(id);
 }
 
 void Tab::RemoveDOMVideo(int id)
@@ -332,12 +325,12 @@ void Tab::RemoveDOMVideo(int id)
 	}
 
 	if (_videoModeTriggers.find(id) != _videoModeTriggers.end()) { _videoModeTriggers.erase(id); }
-	if (_VideoMap.find(id) != _VideoMap.end()) { _VideoMap.erase(id); }
+	_VideoStore.Remove(id);
 }
 
 void Tab::RemoveDOMCheckbox(int id)
 {
-	if (_CheckboxMap.find(id) != _CheckboxMap.end()) { _CheckboxMap.erase(id); }
+	_CheckboxStore.Remove(id);
 }
 
 
@@ -433,6 +426,13 @@ void Tab::SetLoadingStatus(bool isLoading, bool isMainFrame)
 			_pWeb->PushUpdateAwardJob(this, FirebaseMailer::Instance().GetUserAward());
 		}
 
+		// Restore scrolling of page which was hibernated
+		if (_restoreScrolling)
+		{
+			_pCefMediator->SetScrolling(this, _restoreScrollingX, _restoreScrollingY);
+			_restoreScrolling = false;
+		}
+
 		// Tell lab stream layer
 		LabStreamMailer::instance().Send("Finished Loading URL: " + _url);
     }
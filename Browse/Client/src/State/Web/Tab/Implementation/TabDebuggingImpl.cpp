@@ -147,9 +147,8 @@ void Tab::DrawDebuggingOverlay() const
 		_upDebugLineQuad->GetShader()->UpdateValue("color", DOM_TEXT_LINKS_DEBUG_COLOR);
 
 		// Go over all DOMTextLinks
-		for (const auto& rIdNodePair : _TextLinkMap)
+		for (const auto& rDOMTextLink : _TextLinkStore)
 		{
-			const auto& rDOMTextLink = rIdNodePair.second;
 			// Render rects
 			for (const auto rRect : rDOMTextLink->GetRects())
 			{
@@ -173,9 +172,8 @@ void Tab::DrawDebuggingOverlay() const
 
 		// DEBUG - links containing line break are shown in another color
 		_upDebugLineQuad->GetShader()->UpdateValue("color", glm::vec3(1.f, 0.f, 1.f));
-		for (const auto& rIdNodePair : _TextLinkMap)
+		for (const auto& rDOMTextLink : _TextLinkStore)
 		{
-			const auto& rDOMTextLink = rIdNodePair.second;
 			if (rDOMTextLink->GetRects().size() > 1)
 				renderRect(
 					rDOMTextLink->GetRects()[1], 
@@ -186,9 +184,8 @@ void Tab::DrawDebuggingOverlay() const
 		// ### SELECT FIELDS ###
 		// Set rendering up for DOMSelectFields
 		_upDebugLineQuad->GetShader()->UpdateValue("color", DOM_SELECT_FIELD_DEBUG_COLOR);
-		for (const auto& rIdNodePair : _SelectFieldMap)
+		for (const auto& rDOMSelectField : _SelectFieldStore)
 		{
-			const auto& rDOMSelectField = rIdNodePair.second;
 			// Render rects
 			for (const auto rRect : rDOMSelectField->GetRects())
 			{
@@ -219,9 +216,8 @@ void Tab::DrawDebuggingOverlay() const
 		// ### OVERFLOW ELEMENTS ###
 		_upDebugLineQuad->GetShader()->UpdateValue("color", glm::vec3(255.f / 255.f, 127.f / 255.f, 35.f / 255.f));
 
-		for (const auto& rIdNodePair : _OverflowElementMap)
+		for (const auto& rOverflowElement : _OverflowElementStore)
 		{
-			const auto& rOverflowElement = rIdNodePair.second;
 			for (const auto& rect : rOverflowElement->GetRects())
 			{
 				renderRect(
@@ -234,9 +230,8 @@ void Tab::DrawDebuggingOverlay() const
 		// ### DOM VIDEO ELEMENTS ### 
 		_upDebugLineQuad->GetShader()->UpdateValue("color", glm::vec3(255.f / 255.f, 255.f / 255.f, 60.f / 255.f));
 
-		for (const auto& rIdNodePair : _VideoMap)
+		for (const auto& rVideoNode : _VideoStore)
 		{
-			const auto& rVideoNode = rIdNodePair.second;
 			for (const auto& rect : rVideoNode->GetRects())
 			{
 				renderRect(
@@ -249,9 +244,8 @@ void Tab::DrawDebuggingOverlay() const
 		// ### DOM CHECKBOX ELEMENTS ### 
 		_upDebugLineQuad->GetShader()->UpdateValue("color", glm::vec3(120.f / 255.f, 0.f / 255.f, 255.f / 255.f));
 
-		for (const auto& rIdNodePair : _CheckboxMap)
+		for (const auto& rCheckboxNode : _CheckboxStore)
 		{
-			const auto& rCheckboxNode = rIdNodePair.second;
 			for (const auto& rect : rCheckboxNode->GetRects())
 			{
 				renderRect(
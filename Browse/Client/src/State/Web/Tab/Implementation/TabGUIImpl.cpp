@@ -82,46 +82,46 @@ void Tab::TabButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		// ### Vide mode layout ###
 		if (id == "play")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SetPlaying(true);
+				pVideo->SetPlaying(true);
 				eyegui::setVisibilityOfLayout(_pTab->_pVideoModePauseOverlayLayout, false, false, true); // hide pause overlay
 			}
 		}
 		else if (id == "pause")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SetPlaying(false);
+				pVideo->SetPlaying(false);
 				eyegui::setVisibilityOfLayout(_pTab->_pVideoModePauseOverlayLayout, true, true, true); // show pause overlay
 			}
 		}
 		else if (id == "volume_up")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SetMuted(false);
-				iter->second->ChangeVolume(0.25f);
+				pVideo->SetMuted(false);
+				pVideo->ChangeVolume(0.25f);
 			}
 		}
 		else if (id == "volume_down")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SetMuted(false);
-				iter->second->ChangeVolume(-0.25f);
+				pVideo->SetMuted(false);
+				pVideo->ChangeVolume(-0.25f);
 			}
 		}
 		else if (id == "mute")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->ToggleMuted();
+				pVideo->ToggleMuted();
 			}
 		}
 		else if (id == "exit")
@@ -134,18 +134,18 @@ void Tab::TabButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		// ### Vide mode pause overlay layout ###
 		if (id == "skip-10")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SkipSeconds(-10);
+				pVideo->SkipSeconds(-10);
 			}
 		}
 		if (id == "skip+30")
 		{
-			auto iter = _pTab->_VideoMap.find(_pTab->_videoModeId);
-			if (iter != _pTab->_VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+			DOMVideo* pVideo = _pTab->_VideoStore.Get(_pTab->_videoModeId);
+			if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 			{
-				iter->second->SkipSeconds(30);
+				pVideo->SkipSeconds(30);
 			}
 		}
 	}
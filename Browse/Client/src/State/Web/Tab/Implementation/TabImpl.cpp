@@ -9,6 +9,7 @@
 #include "src/Setup.h"
 #include "src/Utils/Helper.h"
 #include "src/Utils/Logger.h"
+#include "src/Utils/Texture.h"
 #include "src/State/Web/Tab/SocialRecord.h"
 #include <algorithm>
 
@@ -17,12 +18,13 @@ Tab::Tab(
 	Mediator* pCefMediator,
 	WebTabInterface* pWeb,
 	std::string url,
-	bool dataTransfer, CefRefPtr<CefRequestContext> request_context) : _dataTransfer(dataTransfer)
+	bool dataTransfer, CefRefPtr<CefRequestContext> request_context) : _linkIndex(setup::DOM_NODE_INDEX_CELL_SIZE), _dataTransfer(dataTransfer)
 {
 	// Fill members
 	_pMaster = pMaster;
 	_pCefMediator = pCefMediator;
 	_pWeb = pWeb;
+	_requestContext = request_context;
 	// URL etc. is set by meditator
 
 	// Create layouts for Tab (overlay at first, because behind other layouts)
@@ -228,18 +230,15 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 	// Update highlight rectangle of webview
 	// TODO: alternative: give webview shared pointer to DOM nodes
 	std::vector<Rect> rects;
-	for (const auto& rIdNodePair : _TextLinkMap)
+	for (const auto& rspNode : _TextLinkStore)
 	{
-		if (!rIdNodePair.second)
-			continue;
-
 		// Check whether link is visible
-		bool visible = !rIdNodePair.second->IsOccluded();
+		bool visible = !rspNode->IsOccluded();
 
 		// Only highlight if visible
 		if (visible)
 		{
-			for (const auto& rRect : rIdNodePair.second->GetRects())
+			for (const auto& rRect : rspNode->GetRects())
 			{
 				rects.push_back(rRect);
 			}
@@ -296,7 +295,11 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
         "Fixed:\n"
         + std::to_string(spTabInput->CEFPixelGazeX) + ", " + std::to_string(spTabInput->CEFPixelGazeY) + "\n"
         + "Scrolled:\n"
-        + std::to_string((int)(spTabInput->CEFPixelGazeX + _scrollingOffsetX)) + ", " + std::to_string((int)(spTabInput->CEFPixelGazeY + _scrollingOffsetY)));
+        + std::to_string((int)(spTabInput->CEFPixelGazeX + _scrollingOffsetX)) + ", " + std::to_string((int)(spTabInput->CEFPixelGazeY + _scrollingOffsetY)) + "\n"
+        + "Frame time:\n"
+        + std::to_string(_averageFrameTime * 1000.0) + " ms\n"
+        + "Skipped uploads:\n"
+        + std::to_string(_pCefMediator->GetSkippedUploadCount(this)));
 
 	// #######################################
     // ### UPDATE PIPELINE OR STANDARD GUI ###
@@ -443,9 +446,8 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
         }
 
 		// Autoscroll inside of DOMOverflowElement if gazed upon
-		for (auto& rIdOverflowPair : _OverflowElementMap)
+		for (const auto& rspOverflowElement : _OverflowElementStore)
 		{
-			auto& rspOverflowElement = rIdOverflowPair.second;
 			if (rspOverflowElement)
 			{
 				for (const auto& rRect : rspOverflowElement->GetRects())
@@ -549,6 +551,21 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 
 void Tab::Draw() const
 {
+	// Measure frame time, includes texture uploads of web view in between draw calls
+	const auto now = std::chrono::steady_clock::now();
+	if (_lastDrawTime != std::chrono::steady_clock::time_point())
+	{
+		_frameTimeSum += std::chrono::duration<double>(now - _lastDrawTime).count();
+		_frameTimeCount++;
+		if (_frameTimeSum >= 1.0)
+		{
+			_averageFrameTime = _frameTimeSum / (double)_frameTimeCount;
+			_frameTimeSum = 0.0;
+			_frameTimeCount = 0;
+		}
+	}
+	_lastDrawTime = now;
+
 	// Draw WebView
 	_upWebView->Draw(
 		_webViewParameters,
@@ -606,6 +623,12 @@ void Tab::Deactivate()
 	eyegui::setVisibilityOfLayout(_pPanelLayout, false, true, false);
     eyegui::setVisibilityOfLayout(_pDebugLayout, false, true, false);
 
+	// Frame time measurement restarts when drawn again
+	_lastDrawTime = std::chrono::steady_clock::time_point();
+
+	// Idle time for hibernation starts now
+	_lastActiveTime = std::chrono::steady_clock::now();
+
 	// TODO: THIS SHOULD NOT BE NECESSARY SINCE _pScrollingOverlayLayout IS HIDDEN! WHY?
 	eyegui::setVisibilityOFloatingFrame(_pScrollingOverlayLayout, _scrollUpProgressFrameIndex, false, false, true);
 	eyegui::setVisibilityOFloatingFrame(_pScrollingOverlayLayout, _scrollDownProgressFrameIndex, false, false, true);
@@ -622,6 +645,82 @@ void Tab::Deactivate()
 	_active = false;
 }
 
+void Tab::Hibernate(std::vector<unsigned char> thumbnail, int thumbnailWidth, int thumbnailHeight)
+{
+	if (_hibernating)
+	{
+		return;
+	}
+
+	// Latest paint in background is never shown, release its copy
+	_pCefMediator->DiscardDeferredPaint(this);
+
+	// Keep thumbnail for tab overview
+	_thumbnail = std::move(thumbnail);
+	_thumbnailWidth = thumbnailWidth;
+	_thumbnailHeight = thumbnailHeight;
+
+	// Remember scrolling, unless page has not been loaded since last waking up
+	if (!_restoreScrolling)
+	{
+		_restoreScrolling = true;
+		_restoreScrollingX = _scrollingOffsetX;
+		_restoreScrollingY = _scrollingOffsetY;
+	}
+
+	// Same as in destructor, but layouts stay
+	EndSocialRecord();
+	ClearDOMNodes();
+	AbortAndClearPipelines();
+	_fixedElements.clear();
+	_pCefMediator->UnregisterTab(this);
+
+	// Renderer only holds weak pointer to texture, so it is freed here
+	_upWebView->ReleaseResources();
+
+	_hibernating = true;
+	LogInfo("Tab: Hibernated tab with URL: ", _url);
+}
+
+void Tab::WakeUp()
+{
+	if (!_hibernating)
+	{
+		return;
+	}
+	_hibernating = false;
+
+	// Zoom level is applied by handler when page is loaded, scrolling in SetLoadingStatus
+	_upWebView->RestoreResources();
+	_pCefMediator->RegisterTab(this, _url, _requestContext);
+	_thumbnail.clear();
+
+	LogInfo("Tab: Woke up tab with URL: ", _url);
+}
+
+int Tab::GetBrowserId()
+{
+	return _pCefMediator->GetBrowserId(this);
+}
+
+const std::vector<unsigned char>& Tab::GetThumbnail(int& rWidth, int& rHeight) const
+{
+	rWidth = _thumbnailWidth;
+	rHeight = _thumbnailHeight;
+	return _thumbnail;
+}
+
+size_t Tab::GetMemoryEstimate()
+{
+	if (_hibernating)
+	{
+		return _thumbnail.size();
+	}
+	return _upWebView->GetMemoryEstimate()
+		+ _pCefMediator->GetDeferredPaintBytes(this)
+		+ (size_t)setup::TAB_BROWSER_MEMORY_ESTIMATE * 1024 * 1024;
+}
+
 void Tab::OpenURL(std::string URL)
 {
 	// Tell CEF to load a new URL (sets later URL and title here)
@@ -745,15 +844,15 @@ void Tab::ScheduleVideoModeTrigger(int id)
 std::vector<Tab::DOMLinkInfo> Tab::RetrieveDOMLinkInfos() const
 {
 	std::vector<Tab::DOMLinkInfo> result;
-	result.reserve(_TextLinkMap.size());
-	for (const auto& rLink : _TextLinkMap)
+	result.reserve(_TextLinkStore.size());
+	for (const auto& rspLink : _TextLinkStore)
 	{
-		if (!rLink.second->GetRects().empty()) // there is at least one rectangle
+		if (!rspLink->GetRects().empty()) // there is at least one rectangle
 		{
-			std::string text = rLink.second->GetText();
+			std::string text = rspLink->GetText();
 			if (!text.empty()) // there is some text
 			{
-				result.push_back(Tab::DOMLinkInfo(rLink.second->GetRects(), text));
+				result.push_back(Tab::DOMLinkInfo(rspLink->GetRects(), text));
 			}
 		}
 	}
@@ -799,14 +898,14 @@ void Tab::EnterVideoMode(int id)
 {
 	if (!_pipelineActive)
 	{
-		auto iter = _VideoMap.find(id);
-		if (iter != _VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+		DOMVideo* pVideo = _VideoStore.Get(id);
+		if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 		{
 			// Set fullscreen
-			iter->second->SetFullscreen(true);
+			pVideo->SetFullscreen(true);
 
 			// Hide controls
-			iter->second->ShowControls(false);
+			pVideo->ShowControls(false);
 
 			// Store id
 			_videoModeId = id;
@@ -833,14 +932,14 @@ void Tab::ExitVideoMode(bool immediately)
 {
 	if (_videoModeId >= 0)
 	{
-		auto iter = _VideoMap.find(_videoModeId);
-		if (iter != _VideoMap.end()) // search for DOMVideo corresponding to videoModeId
+		DOMVideo* pVideo = _VideoStore.Get(_videoModeId);
+		if (pVideo != nullptr) // search for DOMVideo corresponding to videoModeId
 		{
 			// Return from fullscreen
-			iter->second->SetFullscreen(false);
+			pVideo->SetFullscreen(false);
 
 			// Show controls
-			iter->second->ShowControls(true);
+			pVideo->ShowControls(true);
 		}
 
 		// Reset id
@@ -41,11 +41,17 @@ public:
 
 	// Set input data value
 	template <typename T>
-	void SetInputValue(std::string type, T value) { _inputData.SetValue(type, value); }
+	void SetInputValue(const std::string& rType, T value) { _inputData.SetValue(rType, value); }
 
     // Get output data value in reference and returns, whether value was filled
 	template <typename T>
-	bool GetOutputValue(std::string type, T& rValue) const { return _outputData.GetValue(type, rValue); }
+	bool GetOutputValue(const std::string& rType, T& rValue) const { return _outputData.GetValue(rType, rValue); }
+
+	// Resolve slots by name into handles, e.g. once by connectors
+	template <typename T>
+	ActionSlot<T> FindInputSlot(const std::string& rType) const { return _inputData.FindSlot<T>(rType); }
+	template <typename T>
+	ActionSlot<T> FindOutputSlot(const std::string& rType) const { return _outputData.FindSlot<T>(rType); }
 
 protected:
 
@@ -81,17 +87,20 @@ protected:
 
     // Get input data value in reference and returns, whether value was filled
 	template <typename T>
-	bool GetInputValue(std::string type, T& rValue) const { return _inputData.GetValue(type, rValue); }
+	bool GetInputValue(const std::string& rType, T& rValue) const { return _inputData.GetValue(rType, rValue); }
 
     // Set output data value
 	template <typename T>
-	void SetOutputValue(std::string type, T value) { _outputData.SetValue(type, value); }
+	void SetOutputValue(const std::string& rType, T value) { _outputData.SetValue(rType, value); }
 
     // Pointer to interface which enables interaction with tab
     TabInteractionInterface* _pTab;
 
 private:
 
+	// Connector copies values directly between slots
+	friend class ActionConnector;
+
     // Input data
     ActionDataMap _inputData;
 
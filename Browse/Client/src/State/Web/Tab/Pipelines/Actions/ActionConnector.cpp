@@ -13,35 +13,14 @@ ActionConnector::ActionConnector(std::weak_ptr<const Action> wpPrevious, std::we
 
 void ActionConnector::Execute()
 {
-    // Connect per datatype
-	Execute<int>(_intConnections);
-	Execute<float>(_floatConnections);
-	Execute<glm::vec2>(_vec2Connections);
-	Execute<std::string>(_stringConnections);
-	Execute<std::u16string>(_string16Connections);
-}
-
-void ActionConnector::ConnectInt(std::string previousType, std::string nextType)
-{
-   _intConnections[previousType] = nextType;
-}
-
-void ActionConnector::ConnectFloat(std::string previousType, std::string nextType)
-{
-    _floatConnections[previousType] = nextType;
-}
+	auto spPrevious = _wpPrevious.lock();
+	auto spNext = _wpNext.lock();
+	if (!spPrevious || !spNext) { return; }
 
-void ActionConnector::ConnectVec2(std::string previousType, std::string nextType)
-{
-    _vec2Connections[previousType] = nextType;
-}
-
-void ActionConnector::ConnectString(std::string previousType, std::string nextType)
-{
-    _stringConnections[previousType] = nextType;
+    // Connect per datatype
+	Execute<int>(*spPrevious, *spNext, _intConnections);
+	Execute<float>(*spPrevious, *spNext, _floatConnections);
+	Execute<glm::vec2>(*spPrevious, *spNext, _vec2Connections);
+	Execute<std::string>(*spPrevious, *spNext, _stringConnections);
+	Execute<std::u16string>(*spPrevious, *spNext, _string16Connections);
 }
-
-void ActionConnector::ConnectString16(std::string previousType, std::string nextType)
-{
-	_string16Connections[previousType] = nextType;
-}
\ No newline at end of file
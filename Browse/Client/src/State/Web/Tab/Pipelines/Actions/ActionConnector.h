@@ -3,12 +3,14 @@
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
 // Connects output ActionDataMap of one Action with input ActionDataMap of other.
+// Names of slots are resolved when connecting, so execution copies values
+// directly from slot to slot.
 
 #ifndef ACTIONCONNECTOR_H_
 #define ACTIONCONNECTOR_H_
 
 #include "src/State/Web/Tab/Pipelines/Actions/Action.h"
-#include <map>
+#include <vector>
 #include <memory>
 
 class ActionConnector
@@ -25,23 +27,57 @@ public:
 	std::weak_ptr<const Action> GetPreviousAction() const { return _wpPrevious; }
 
     // Connect
-    void ConnectInt(std::string previousType, std::string nextType);
-    void ConnectFloat(std::string previousType, std::string nextType);
-    void ConnectVec2(std::string previousType, std::string nextType);
-    void ConnectString(std::string previousType, std::string nextType);
-    void ConnectString16(std::string previousType, std::string nextType);
+    void ConnectInt(const std::string& rPreviousType, const std::string& rNextType)		{ Connect(rPreviousType, rNextType, _intConnections); }
+    void ConnectFloat(const std::string& rPreviousType, const std::string& rNextType)		{ Connect(rPreviousType, rNextType, _floatConnections); }
+    void ConnectVec2(const std::string& rPreviousType, const std::string& rNextType)		{ Connect(rPreviousType, rNextType, _vec2Connections); }
+    void ConnectString(const std::string& rPreviousType, const std::string& rNextType)	{ Connect(rPreviousType, rNextType, _stringConnections); }
+    void ConnectString16(const std::string& rPreviousType, const std::string& rNextType)	{ Connect(rPreviousType, rNextType, _string16Connections); }
 
 private:
 
+	// Connection from output slot of previous action to input slot of next action
+	template <typename T>
+	struct Connection
+	{
+		ActionSlot<T> previous;
+		ActionSlot<T> next;
+	};
+
+	// Resolve slots of connection. Replaces connection of same output slot
+	template <typename T>
+	void Connect(const std::string& rPreviousType, const std::string& rNextType, std::vector<Connection<T> >& rConnections)
+	{
+		auto spPrevious = _wpPrevious.lock();
+		auto spNext = _wpNext.lock();
+		if (!spPrevious || !spNext) { return; }
+
+		Connection<T> connection;
+		connection.previous = spPrevious->FindOutputSlot<T>(rPreviousType);
+		connection.next = spNext->FindInputSlot<T>(rNextType);
+		if (!connection.previous.IsValid() || !connection.next.IsValid())
+		{
+			LogBug("ActionConnector: Cannot connect slot ", rPreviousType, " with slot ", rNextType);
+			return;
+		}
+
+		for (auto& rConnection : rConnections)
+		{
+			if (rConnection.previous.index == connection.previous.index)
+			{
+				rConnection = connection;
+				return;
+			}
+		}
+		rConnections.push_back(connection);
+	}
+
 	// Private execute. Executes copying of values for one datatype.
 	template <typename T>
-	void Execute(std::map<std::string, std::string>& rConnectionMap)
+	void Execute(const Action& rPrevious, Action& rNext, const std::vector<Connection<T> >& rConnections)
 	{
-		for (const auto& rConnection : rConnectionMap)
+		for (const auto& rConnection : rConnections)
 		{
-			T value;
-			if (auto spPrevious = _wpPrevious.lock()) { spPrevious->GetOutputValue(rConnection.first, value); }
-			if (auto spNext = _wpNext.lock()) { spNext->SetInputValue(rConnection.second, value); }
+			rNext._inputData.SetValue(rConnection.next, rPrevious._outputData.GetValue(rConnection.previous));
 		}
 	}
 
@@ -49,12 +85,12 @@ private:
     std::weak_ptr<const Action> _wpPrevious;
 	std::weak_ptr<Action> _wpNext;
 
-    // Map of connections
-    std::map<std::string, std::string> _intConnections;
-    std::map<std::string, std::string> _floatConnections;
-    std::map<std::string, std::string> _vec2Connections;
-    std::map<std::string, std::string> _stringConnections;
-    std::map<std::string, std::string> _string16Connections;
+    // Resolved connections
+    std::vector<Connection<int> > _intConnections;
+    std::vector<Connection<float> > _floatConnections;
+    std::vector<Connection<glm::vec2> > _vec2Connections;
+    std::vector<Connection<std::string> > _stringConnections;
+    std::vector<Connection<std::u16string> > _string16Connections;
 };
 
 #endif // ACTIONCONNECTOR_H_
@@ -15,13 +15,13 @@ class ActionData
 public:
 
     // Constructor taking initial value
-	ActionData(T value) { _value = value; }
+	ActionData(T value) : _value(value) {}
 
     // Set value data (and remembers, that value was actively set)
-    void SetValue(T value) { _value = value; _filled = true; }
+    void SetValue(const T& rValue) { _value = rValue; _filled = true; }
 
     // Get value
-    T GetValue() const { return _value; }
+    const T& GetValue() const { return _value; }
 
     // Is filled
     bool IsFilled() const { return _filled; }
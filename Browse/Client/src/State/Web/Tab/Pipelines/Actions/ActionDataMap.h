@@ -3,7 +3,9 @@
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
 // Map of string, defining type of data or semantic of data, and C++ data type.
-// Every action has one ActionDataMap as input and one as output.
+// Every action has one ActionDataMap as input and one as output. Values are
+// stored inline in one small vector of slots per C++ data type. Slots can be
+// resolved once by their name into handles, which access values directly.
 
 #ifndef ACTIONDATAMAP_H_
 #define ACTIONDATAMAP_H_
@@ -12,82 +14,151 @@
 #include "src/Typedefs.h"
 #include "src/Utils/glmWrapper.h"
 #include "src/Utils/Logger.h"
-#include <map>
-#include <memory>
+#include <vector>
+#include <string>
+
+// Handle of slot in ActionDataMap, index into vector of slots with C++ data type
+template <typename T>
+struct ActionSlot
+{
+	int index = -1;
+	bool IsValid() const { return index >= 0; }
+};
 
 class ActionDataMap
 {
 public:
 
     // Add slot to map
-    void AddIntSlot(std::string type, int value = 0);
-    void AddInt64Slot(std::string type, int64 value = 0);
-	void AddFloatSlot(std::string type, float value = 0.f);
-    void AddVec2Slot(std::string type, glm::vec2 value = glm::vec2(0.f, 0.f));
-    void AddStringSlot(std::string type, std::string value = "");
-    void AddString16Slot(std::string type, std::u16string value = u"");
+    void AddIntSlot(const std::string& rType, int value = 0)							{ AddSlot<int>(rType, value); }
+    void AddInt64Slot(const std::string& rType, int64 value = 0)						{ AddSlot<int64>(rType, value); }
+	void AddFloatSlot(const std::string& rType, float value = 0.f)						{ AddSlot<float>(rType, value); }
+    void AddVec2Slot(const std::string& rType, glm::vec2 value = glm::vec2(0.f, 0.f))	{ AddSlot<glm::vec2>(rType, value); }
+    void AddStringSlot(const std::string& rType, std::string value = "")				{ AddSlot<std::string>(rType, value); }
+    void AddString16Slot(const std::string& rType, std::u16string value = u"")			{ AddSlot<std::u16string>(rType, value); }
+
+	// Resolve slot by its name. Returns invalid handle if there is no such slot
+	template <typename T>
+	ActionSlot<T> FindSlot(const std::string& rType) const
+	{
+		ActionSlot<T> slot;
+		const auto& rSlots = Slots((T*)nullptr);
+		for (int i = 0; i < (int)rSlots.size(); i++)
+		{
+			if (rSlots[i].type == rType) { slot.index = i; break; }
+		}
+		return slot;
+	}
+
+	// Set value of data through handle
+	template <typename T>
+	void SetValue(ActionSlot<T> slot, const T& rValue) { Slots((T*)nullptr)[slot.index].data.SetValue(rValue); }
+
+	// Value of data through handle
+	template <typename T>
+	const T& GetValue(ActionSlot<T> slot) const { return Slots((T*)nullptr)[slot.index].data.GetValue(); }
 
     // Set value of data
-    void SetValue(std::string type, int value)				{ SetValue<int>(type, value, _intMap); }
-    void SetValue(std::string type, int64 value)			{ SetValue<int64>(type, value, _int64Map); }
-    void SetValue(std::string type, float value)			{ SetValue<float>(type, value, _floatMap); }
-    void SetValue(std::string type, glm::vec2 value)		{ SetValue<glm::vec2>(type, value, _vec2Map); }
-    void SetValue(std::string type, std::string value)		{ SetValue<std::string>(type, value, _stringMap); }
-    void SetValue(std::string type, std::u16string value)	{ SetValue<std::u16string>(type, value, _string16Map); }
+    void SetValue(const std::string& rType, int value)					{ SetNamedValue<int>(rType, value); }
+    void SetValue(const std::string& rType, int64 value)				{ SetNamedValue<int64>(rType, value); }
+    void SetValue(const std::string& rType, float value)				{ SetNamedValue<float>(rType, value); }
+    void SetValue(const std::string& rType, glm::vec2 value)			{ SetNamedValue<glm::vec2>(rType, value); }
+    void SetValue(const std::string& rType, const std::string& rValue)		{ SetNamedValue<std::string>(rType, rValue); }
+    void SetValue(const std::string& rType, const std::u16string& rValue)	{ SetNamedValue<std::u16string>(rType, rValue); }
 
     // Fills value into given reference variable. Returns whether value was filled actively
-    bool GetValue(std::string type, int& rValue) const				{ return GetValue<int>(type, rValue, _intMap); }
-    bool GetValue(std::string type, int64& rValue) const			{ return GetValue<int64>(type, rValue, _int64Map); }
-    bool GetValue(std::string type, float& rValue) const			{ return GetValue<float>(type, rValue, _floatMap); }
-    bool GetValue(std::string type, glm::vec2& rValue) const		{ return GetValue<glm::vec2>(type, rValue, _vec2Map); }
-    bool GetValue(std::string type, std::string& rValue) const		{ return GetValue<std::string>(type, rValue, _stringMap); }
-	bool GetValue(std::string type, std::u16string& rValue) const	{ return GetValue<std::u16string>(type, rValue, _string16Map); }
+    bool GetValue(const std::string& rType, int& rValue) const				{ return GetNamedValue<int>(rType, rValue); }
+    bool GetValue(const std::string& rType, int64& rValue) const			{ return GetNamedValue<int64>(rType, rValue); }
+    bool GetValue(const std::string& rType, float& rValue) const			{ return GetNamedValue<float>(rType, rValue); }
+    bool GetValue(const std::string& rType, glm::vec2& rValue) const		{ return GetNamedValue<glm::vec2>(rType, rValue); }
+    bool GetValue(const std::string& rType, std::string& rValue) const		{ return GetNamedValue<std::string>(rType, rValue); }
+	bool GetValue(const std::string& rType, std::u16string& rValue) const	{ return GetNamedValue<std::u16string>(rType, rValue); }
 
 private:
 
-	// Type definition of data map
+	// Slot with name and data
 	template <typename T>
-	using InternalDataMap = std::map<std::string, std::unique_ptr<ActionData< T > > >;
+	struct Slot
+	{
+		Slot(const std::string& rType, T value) : type(rType), data(value) {}
+		std::string type;
+		ActionData<T> data;
+	};
+
+	// Type definition of slot vector
+	template <typename T>
+	using SlotVector = std::vector<Slot<T> >;
+
+	// Add slot template method, replaces slot with same name
+	template <typename T>
+	void AddSlot(const std::string& rType, T value)
+	{
+		auto& rSlots = Slots((T*)nullptr);
+		const ActionSlot<T> slot = FindSlot<T>(rType);
+		if (slot.IsValid())
+		{
+			rSlots[slot.index] = Slot<T>(rType, value);
+		}
+		else
+		{
+			rSlots.emplace_back(rType, value);
+		}
+	}
 
 	// Set value template method
 	template <typename T>
-	void SetValue(std::string type, T value, InternalDataMap<T>& rMap)
+	void SetNamedValue(const std::string& rType, const T& rValue)
 	{
-		auto iter = rMap.find(type);
-		if (iter != rMap.end())
+		const ActionSlot<T> slot = FindSlot<T>(rType);
+		if (slot.IsValid())
 		{
-			iter->second->SetValue(value);
+			SetValue(slot, rValue);
 		}
 		else
 		{
-			LogBug("No slot in ActionDataMap for ", type);
+			LogBug("No slot in ActionDataMap for ", rType);
 		}
 	}
 
 	// Get value template method. Returns whether value was filled actively
 	template <typename T>
-	bool GetValue(std::string type, T& rValue, const InternalDataMap<T>& rMap) const
+	bool GetNamedValue(const std::string& rType, T& rValue) const
 	{
-		auto iter = rMap.find(type);
-		if (iter != rMap.end())
+		const ActionSlot<T> slot = FindSlot<T>(rType);
+		if (slot.IsValid())
 		{
-			rValue = iter->second->GetValue();
-			return iter->second->IsFilled();
+			const auto& rData = Slots((T*)nullptr)[slot.index].data;
+			rValue = rData.GetValue();
+			return rData.IsFilled();
 		}
 		else
 		{
-			LogBug("No slot in ActionDataMap for ", type);
+			LogBug("No slot in ActionDataMap for ", rType);
 		}
 		return false;
 	}
 
-    // Maps with data
-	InternalDataMap<int>			_intMap;
-	InternalDataMap<int64>			_int64Map;
-	InternalDataMap<float>			_floatMap;
-	InternalDataMap<glm::vec2>		_vec2Map;
-	InternalDataMap<std::string>	_stringMap;
-	InternalDataMap<std::u16string>	_string16Map;
+	// Slot vector per C++ data type, selected by type of null pointer
+	SlotVector<int>& Slots(int*)								{ return _intSlots; }
+	SlotVector<int64>& Slots(int64*)							{ return _int64Slots; }
+	SlotVector<float>& Slots(float*)							{ return _floatSlots; }
+	SlotVector<glm::vec2>& Slots(glm::vec2*)					{ return _vec2Slots; }
+	SlotVector<std::string>& Slots(std::string*)				{ return _stringSlots; }
+	SlotVector<std::u16string>& Slots(std::u16string*)			{ return _string16Slots; }
+	const SlotVector<int>& Slots(int*) const					{ return _intSlots; }
+	const SlotVector<int64>& Slots(int64*) const				{ return _int64Slots; }
+	const SlotVector<float>& Slots(float*) const				{ return _floatSlots; }
+	const SlotVector<glm::vec2>& Slots(glm::vec2*) const		{ return _vec2Slots; }
+	const SlotVector<std::string>& Slots(std::string*) const	{ return _stringSlots; }
+	const SlotVector<std::u16string>& Slots(std::u16string*) const	{ return _string16Slots; }
+
+    // Slots with data
+	SlotVector<int>				_intSlots;
+	SlotVector<int64>			_int64Slots;
+	SlotVector<float>			_floatSlots;
+	SlotVector<glm::vec2>		_vec2Slots;
+	SlotVector<std::string>		_stringSlots;
+	SlotVector<std::u16string>	_string16Slots;
 };
 
 #endif // ACTIONDATAMAP_H_
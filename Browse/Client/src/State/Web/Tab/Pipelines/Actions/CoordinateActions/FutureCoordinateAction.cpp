@@ -284,38 +284,24 @@ bool FutureCoordinateAction::Update(float tpf, const std::shared_ptr<const TabIn
 	// ### PAGE SPACE FILTERING ###
 	// ############################
 
-	// Update custom transformation
-	double webViewX = _pTab->GetWebViewX();
-	double webViewY = _pTab->GetWebViewY();
-	double webViewWidth = _pTab->GetWebViewWidth();
-	double webViewHeight = _pTab->GetWebViewHeight();
-	auto zoom = _zoom;
-	auto relativeZoomCoordinate = _relativeZoomCoordinate;
-	auto relativeCenterOffset = _relativeCenterOffset;
-	_spTrans->ChangeCustomTransformation(
-		TRANS_NAME,
-		[webViewX, webViewY, webViewWidth, webViewHeight, zoom, relativeZoomCoordinate, relativeCenterOffset, cefPixels](double& x, double& y)
-	{
-		// Bring raw gaze into relative space of WebView
-		glm::vec2 gaze(x, y); // double 2D vector
-		gaze.x -= webViewX;
-		gaze.y -= webViewY;
-		gaze.x /= webViewWidth;
-		gaze.y /= webViewHeight;
-		gaze = glm::clamp(gaze, glm::vec2(0, 0), glm::vec2(1, 1));
-
-		// Now transform to pixel space of webpage
-		gaze += relativeCenterOffset; // add center offset
-		gaze -= relativeZoomCoordinate; // move zoom coordinate to origin
-		gaze *= zoom; // apply zoom
-		gaze += relativeZoomCoordinate; // move back
-		gaze *= cefPixels; // bring into pixel space of CEF
-
-		// Set references
-		x = gaze.x;
-		y = gaze.y;
-	}
-	);
+	// Update custom transformation. Raw gaze is brought into relative space of WebView and clamped, which
+	// is expressed as clamping to WebView rectangle. Then it is transformed to pixel space of webpage by
+	// adding center offset, zooming around zoom coordinate and scaling to pixel space of CEF
+	const glm::dvec2 webViewPosition(_pTab->GetWebViewX(), _pTab->GetWebViewY());
+	const glm::dvec2 webViewSize(_pTab->GetWebViewWidth(), _pTab->GetWebViewHeight());
+	const glm::dvec2 scale = ((double)_zoom * glm::dvec2(cefPixels)) / webViewSize;
+	const glm::dvec2 translation =
+		(((glm::dvec2(_relativeCenterOffset) - glm::dvec2(_relativeZoomCoordinate)) * (double)_zoom + glm::dvec2(_relativeZoomCoordinate)) * glm::dvec2(cefPixels))
+		- (webViewPosition * scale);
+	FilterAffineTransformation transformation;
+	transformation.matrix[0][0] = scale.x;
+	transformation.matrix[1][1] = scale.y;
+	transformation.matrix[2][0] = translation.x;
+	transformation.matrix[2][1] = translation.y;
+	transformation.clamp = true;
+	transformation.clampMin = webViewPosition;
+	transformation.clampMax = webViewPosition + webViewSize;
+	_spTrans->ChangeCustomTransformation(TRANS_NAME, transformation);
 
 	// #####################
 	// ### VISUALIZATION ###
@@ -401,7 +387,7 @@ void FutureCoordinateAction::Activate()
 {
 	// TODO: could go wrong, as taken from weak pointer
 	_spTrans = _pTab->GetCustomTransformationInterface().lock();
-	_spTrans->RegisterCustomTransformation(TRANS_NAME, [](double& x, double& y) {}); // tell transformation to not transform anything, done in update
+	_spTrans->RegisterCustomTransformation(TRANS_NAME, FilterAffineTransformation()); // tell transformation to not transform anything, done in update
 }
 
 void FutureCoordinateAction::Deactivate()
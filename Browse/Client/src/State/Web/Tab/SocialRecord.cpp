@@ -74,10 +74,8 @@ void SocialRecord::Persist()
 	FirebaseJSONKey recordKey;
 	std::tie(countKey, recordKey) = SocialFirebaseKeys.at(_platform);
 
-	// Persist
-	std::promise<int> sessionPromise; auto sessionFuture = sessionPromise.get_future(); // prepare to get value
-	bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(countKey, 1, &sessionPromise); // adds one to the count
-	if (pushedBack) { FirebaseMailer::Instance().PushBack_Put(recordKey, record, "sessions/" + std::to_string(sessionFuture.get() - 1)); } // send JSON to database
+	// Persist, adds one to the count and sends JSON to database without waiting for the count
+	FirebaseMailer::Instance().PushBack_Append(countKey, recordKey, record, "sessions/");
 }
 
 void SocialRecord::AddTimeInForeground(float time)
@@ -25,6 +25,8 @@
 #include "src/State/Web/Tab/Interface/TabDOMNodeInterface.h"
 #include "src/State/Web/WebTabInterface.h"
 #include "src/CEF/Data/DOMNode.h"
+#include "src/CEF/Data/DOMNodeIndex.h"
+#include "src/CEF/Data/DOMNodeStore.h"
 #include "src/State/Web/Tab/WebView.h"
 #include "src/State/Web/Tab/Pipelines/Pipeline.h"
 #include "src/State/Web/Tab/Triggers/TextInputTrigger.h"
@@ -42,6 +44,7 @@
 #include <map>
 #include <set>
 #include <future>
+#include <chrono>
 
 // Forward declaration
 class Master;
@@ -134,6 +137,24 @@ public:
 	// Getter for title
 	std::string GetTitle() const { return _title; }
 
+	// Hibernation closes browser and releases texture and framebuffer of web view. URL, scrolling,
+	// zoom and given RGBA thumbnail are kept and the page is loaded again when waking up
+	void Hibernate(std::vector<unsigned char> thumbnail, int thumbnailWidth, int thumbnailHeight);
+	void WakeUp();
+	bool IsHibernating() const { return _hibernating; }
+
+	// Thumbnail given at hibernation in RGBA, empty if none was available
+	const std::vector<unsigned char>& GetThumbnail(int& rWidth, int& rHeight) const;
+
+	// Identifier of browser, negative while hibernating
+	int GetBrowserId();
+
+	// Time of last deactivation or creation, used to find idle tabs
+	std::chrono::steady_clock::time_point GetLastActiveTime() const { return _lastActiveTime; }
+
+	// Estimation of memory used by browser, web view and deferred paint in bytes, only thumbnail while hibernating
+	size_t GetMemoryEstimate();
+
 	// Get color accent
 	glm::vec4 GetColorAccent() const { return _targetColorAccent; }
 
@@ -603,13 +624,16 @@ private:
 	// Collection of all triggers
 	std::vector<Trigger*> _triggers;
 
-	// Map nodeID to node itself, in order to access it when it has to be updated
-	std::map<int, std::shared_ptr<DOMLink> > _TextLinkMap;
-	std::map<int, std::shared_ptr<DOMTextInput> > _TextInputMap;
-	std::map<int, std::shared_ptr<DOMSelectField> > _SelectFieldMap;
-	std::map<int, std::shared_ptr<DOMOverflowElement> > _OverflowElementMap;
-	std::map<int, std::shared_ptr<DOMVideo> > _VideoMap;
-	std::map<int, std::shared_ptr<DOMCheckbox> > _CheckboxMap;
+	// Stores of nodes per type, in order to access them by id when they have to be updated
+	DOMNodeStore<DOMLink> _TextLinkStore;
+	DOMNodeStore<DOMTextInput> _TextInputStore;
+	DOMNodeStore<DOMSelectField> _SelectFieldStore;
+	DOMNodeStore<DOMOverflowElement> _OverflowElementStore;
+	DOMNodeStore<DOMVideo> _VideoStore;
+	DOMNodeStore<DOMCheckbox> _CheckboxStore;
+
+	// Spatial index over rects of links, follows updates of the nodes
+	DOMNodeIndex _linkIndex;
 
     // Web view in which website is rendered and displayed
     std::unique_ptr<WebView> _upWebView;
@@ -667,6 +691,12 @@ private:
 	// Save some gaze input for debugging purposes
 	std::deque<glm::vec2> _gazeDebuggingQueue;
 
+	// Frame time measured between draw calls, averaged over roughly one second for debugging purposes
+	mutable std::chrono::steady_clock::time_point _lastDrawTime;
+	mutable double _frameTimeSum = 0.0; // in seconds
+	mutable int _frameTimeCount = 0;
+	mutable double _averageFrameTime = 0.0; // in seconds
+
     // Frame indices of scroll up and down overlays
     unsigned int _scrollUpProgressFrameIndex = 0;
     unsigned int _scrollDownProgressFrameIndex = 0;
@@ -752,6 +782,19 @@ private:
 
 	// Polling partition index
 	int _pollingPartitionIndex = 0;
+
+	// Request context the browser was created with, used again when waking up
+	CefRefPtr<CefRequestContext> _requestContext = nullptr;
+
+	// Hibernation
+	bool _hibernating = false;
+	std::chrono::steady_clock::time_point _lastActiveTime = std::chrono::steady_clock::now();
+	std::vector<unsigned char> _thumbnail;
+	int _thumbnailWidth = 0;
+	int _thumbnailHeight = 0;
+	bool _restoreScrolling = false; // scrolling is applied after main frame has been loaded after waking up
+	double _restoreScrollingX = 0;
+	double _restoreScrollingY = 0;
 };
 
 #endif // TAB_H_
@@ -105,19 +105,13 @@ WebView::WebView(int x, int y, int width, int height)
 	_width = width;
 	_height = height;
 
-    // Generate texture
-    _spTexture = std::shared_ptr<Texture>(new Texture(_width, _height, GL_RGBA, Texture::Filter::LINEAR, Texture::Wrap::BORDER));
-
     // Render items
 	_upWebpageRenderItem = std::unique_ptr<RenderItem>(new RenderItem(vertexShaderSource, geometryShaderSource, webpageFragmentShaderSource));
     _upHighlightRenderItem = std::unique_ptr<RenderItem>(new RenderItem(vertexShaderSource, geometryShaderSource, highlightFragmentShaderSource));
     _upCompositeRenderItem = std::unique_ptr<RenderItem>(new RenderItem(vertexShaderSource, geometryShaderSource, compositionFragmentShaderSource));
 
-    // Framebuffer
-    _upFramebuffer = std::unique_ptr<Framebuffer>(new Framebuffer(_width, _height));
-    _upFramebuffer->Bind();
-    _upFramebuffer->AddAttachment(Framebuffer::ColorFormat::RGB, true);
-    _upFramebuffer->Unbind();
+    // Texture and framebuffer
+    CreateResources(_width, _height);
 }
 
 WebView::~WebView()
@@ -132,7 +126,7 @@ void WebView::Update(
     int height)
 {
     // Update framebuffer size
-    if((width != _width) || (height != _height))
+    if(_upFramebuffer && ((width != _width) || (height != _height)))
     {
         _upFramebuffer->Bind();
         _upFramebuffer->Resize(width, height);
@@ -153,6 +147,12 @@ void WebView::Draw(
 	double scrollingOffsetX,
 	double scrollingOffsetY) const
 {
+    // Nothing to draw while resources are released
+    if(!_spTexture)
+    {
+        return;
+    }
+
     // ### FILL FRAMEBUFFER ###
 
     // Just render to framebuffer
@@ -291,10 +291,66 @@ int WebView::GetHeight() const
 
 int WebView::GetResolutionX() const
 {
-	return _spTexture->GetWidth();
+	return _spTexture ? _spTexture->GetWidth() : _releasedResolutionX;
 }
 
 int WebView::GetResolutionY() const
 {
-	return _spTexture->GetHeight();
+	return _spTexture ? _spTexture->GetHeight() : _releasedResolutionY;
+}
+
+void WebView::ReleaseResources()
+{
+	if (!_spTexture)
+	{
+		return;
+	}
+
+	// Remember resolution, renderer only keeps weak pointer to texture
+	_releasedResolutionX = _spTexture->GetWidth();
+	_releasedResolutionY = _spTexture->GetHeight();
+	_spTexture = nullptr;
+	_upFramebuffer = nullptr;
+}
+
+void WebView::RestoreResources()
+{
+	if (_spTexture)
+	{
+		return;
+	}
+
+	// Texture is resized by renderer at first paint if resolution changed meanwhile
+	CreateResources(_releasedResolutionX, _releasedResolutionY);
+}
+
+size_t WebView::GetMemoryEstimate() const
+{
+	if (!_spTexture)
+	{
+		return 0;
+	}
+
+	// RGBA texture with mip maps takes about one third more, framebuffer has RGB attachment
+	size_t textureBytes = (size_t)_spTexture->GetWidth() * (size_t)_spTexture->GetHeight() * 4;
+	size_t framebufferBytes = (size_t)_width * (size_t)_height * 3;
+	return textureBytes + (textureBytes / 3) + framebufferBytes;
+}
+
+void WebView::CreateResources(int resolutionX, int resolutionY)
+{
+    // Generate texture
+    _spTexture = std::shared_ptr<Texture>(new Texture(
+        resolutionX,
+        resolutionY,
+        GL_RGBA,
+        Texture::Filter::LINEAR,
+        Texture::Wrap::BORDER,
+        setup::WEB_VIEW_PIXEL_BUFFER_UPLOAD ? Texture::Upload::PIXEL_BUFFER : Texture::Upload::SYNCHRONOUS));
+
+    // Framebuffer
+    _upFramebuffer = std::unique_ptr<Framebuffer>(new Framebuffer(_width, _height));
+    _upFramebuffer->Bind();
+    _upFramebuffer->AddAttachment(Framebuffer::ColorFormat::RGB, true);
+    _upFramebuffer->Unbind();
 }
@@ -66,8 +66,19 @@ public:
 	int GetResolutionX() const;
 	int GetResolutionY() const;
 
+	// Release texture and framebuffer while tab is hibernated. Resolution is kept
+	void ReleaseResources();
+	void RestoreResources();
+	bool HasResources() const { return _spTexture != nullptr; }
+
+	// Estimation of memory used by texture and framebuffer in bytes
+	size_t GetMemoryEstimate() const;
+
 private:
 
+	// Create texture and framebuffer
+	void CreateResources(int resolutionX, int resolutionY);
+
     // Texture object which belongs here but filled by CEF and read maybe by other
     std::shared_ptr<Texture> _spTexture;
 
@@ -87,6 +98,10 @@ private:
 
     // Framebuffer to render highlights etc on webpage and later zoom in
     std::unique_ptr<Framebuffer> _upFramebuffer;
+
+	// Resolution of released texture
+	int _releasedResolutionX = 0;
+	int _releasedResolutionY = 0;
 };
 
 #endif // WEBVIEW_H_
@@ -7,6 +7,7 @@
 #include "src/State/Web/Tab/Tab.h"
 #include "src/Master/Master.h"
 #include "src/Global.h"
+#include "src/Setup.h"
 #include "src/Utils/Helper.h"
 #include "src/Utils/Texture.h"
 #include "src/Utils/MakeUnique.h"
@@ -34,6 +35,9 @@ Web::Web(Master* pMaster, Mediator* pCefMediator, bool dataTransfer) : State(pMa
 	// Create URL input
 	_upURLInput = std::unique_ptr<URLInput>(new URLInput(_pMaster, _upBookmarkManager.get()));
 
+	// Create preview manager
+	_upPreviewManager = std::unique_ptr<PreviewManager>(new PreviewManager(WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL, WEB_TAB_OVERVIEW_PREVIEW_MIP_MAP_LEVEL));
+
     // Create own layout
     _pWebLayout = _pMaster->AddLayout("layouts/Web.xeyegui", EYEGUI_WEB_LAYER, false);
     _pTabOverviewLayout = _pMaster->AddLayout("layouts/WebTabOverview.xeyegui", EYEGUI_WEB_LAYER, false);
@@ -220,6 +224,7 @@ void Web::RemoveTab(int id)
 
 		// Deactivate and remove from map
 		_tabs.at(id)->Deactivate(); // should be already done but second time should not hurt
+		_upPreviewManager->RemovePreview(_tabs.at(id)->GetBrowserId());
 		_tabs.erase(id);
 
 		// Update icon of tab overview button
@@ -268,6 +273,9 @@ bool Web::SwitchToTab(int id)
         // Set new tab as current
         _currentTabId = id;
 
+        // Load page again if tab was hibernated
+        _tabs.at(_currentTabId)->WakeUp();
+
         // Activate tab
         if(_active)
         {
@@ -501,6 +509,9 @@ StateType Web::Update(float tpf, const std::shared_ptr<const Input> spInput)
 		_tabs.at(_currentTabId)->Update(tpf, spInput);
     }
 
+	// Release resources of tabs in background
+	UpdateHibernation();
+
     // Decide what to do next
     if (_goToSettings)
     {
@@ -672,29 +683,73 @@ void Web::UpdateTabOverview()
         eyegui::setContentOfTextBlock(_pTabOverviewLayout, textblockId, shortURL);
 
         // Set webpage rendering as icon of button
-        auto wpTexture = _tabs.at(tabId)->GetWebViewTexture();
-        if(auto spTexture = wpTexture.lock())
+        TabOverviewPreview& rPreview = _tabOverviewPreviews.at(i);
+        if (_tabs.at(tabId)->IsHibernating())
         {
-            // Fetch pixel data of tab in higher mip map level
-            std::vector<unsigned char> tabPreviewData;
-            int tabPreviewWidth;
-            int tabPreviewHeight;
-            if (spTexture->GetPixelsFromMipMap(
-                WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL,
-                tabPreviewWidth,
-                tabPreviewHeight,
-                tabPreviewData))
+            if (rPreview.tabId == tabId && rPreview.thumbnail)
+            {
+                // Thumbnail of hibernated tab is already uploaded
+                eyegui::setIconOfIconElement(_pTabOverviewLayout, buttonId, buttonId + "_preview");
+            }
+            else
+            {
+                // Use thumbnail taken at hibernation
+                int thumbnailWidth;
+                int thumbnailHeight;
+                const std::vector<unsigned char>& rThumbnail = _tabs.at(tabId)->GetThumbnail(thumbnailWidth, thumbnailHeight);
+                rPreview = TabOverviewPreview();
+                if (!rThumbnail.empty())
+                {
+                    eyegui::setIconOfIconElement(
+                        _pTabOverviewLayout,
+                        buttonId,
+                        buttonId + "_preview",
+                        thumbnailWidth,
+                        thumbnailHeight,
+                        eyegui::ColorFormat::RGBA,
+                        rThumbnail.data(),
+                        true);
+                    rPreview.tabId = tabId;
+                    rPreview.thumbnail = true;
+                }
+            }
+        }
+        else
+        {
+            const unsigned int generation = _upPreviewManager->GetGeneration(_tabs.at(tabId)->GetBrowserId());
+            if (rPreview.tabId == tabId && !rPreview.thumbnail && generation != 0 && rPreview.generation == generation)
+            {
+                // Tab did not paint since upload, so just use the uploaded preview (looked up by name)
+                eyegui::setIconOfIconElement(_pTabOverviewLayout, buttonId, buttonId + "_preview");
+            }
+            else
             {
-                // Pipe it to eyeGUI
-                eyegui::setIconOfIconElement(
-                    _pTabOverviewLayout,
-                    buttonId,
-                    buttonId + "_preview",
+                // Fetch preview of tab computed from its paints
+                std::vector<unsigned char> tabPreviewData;
+                int tabPreviewWidth;
+                int tabPreviewHeight;
+                unsigned int tabPreviewGeneration;
+                rPreview = TabOverviewPreview();
+                if (_upPreviewManager->GetPreview(
+                    _tabs.at(tabId)->GetBrowserId(),
                     tabPreviewWidth,
                     tabPreviewHeight,
-                    eyegui::ColorFormat::RGBA,
-                    tabPreviewData.data(),
-                    true);
+                    tabPreviewData,
+                    tabPreviewGeneration))
+                {
+                    // Pipe it to eyeGUI
+                    eyegui::setIconOfIconElement(
+                        _pTabOverviewLayout,
+                        buttonId,
+                        buttonId + "_preview",
+                        tabPreviewWidth,
+                        tabPreviewHeight,
+                        eyegui::ColorFormat::RGBA,
+                        tabPreviewData.data(),
+                        true);
+                    rPreview.tabId = tabId;
+                    rPreview.generation = tabPreviewGeneration;
+                }
             }
         }
 
@@ -788,31 +843,26 @@ void Web::UpdateTabOverview()
 			RGBAToHexString(fontColor)
 		);
 
-        // Show current tab's page
-        auto wpTexture = _tabs.at(_currentTabId)->GetWebViewTexture();
-        if (auto spTexture = wpTexture.lock())
+        // Show detailed preview of current tab computed from its paints
+        std::vector<unsigned char> tabPreviewData;
+        int tabPreviewWidth;
+        int tabPreviewHeight;
+        if (_upPreviewManager->GetDetailedPreview(
+            _tabs.at(_currentTabId)->GetBrowserId(),
+            tabPreviewWidth,
+            tabPreviewHeight,
+            tabPreviewData))
         {
-            // Fetch pixel data of tab in higher mip map level
-            std::vector<unsigned char> tabPreviewData;
-            int tabPreviewWidth;
-            int tabPreviewHeight;
-            if (spTexture->GetPixelsFromMipMap(
-                WEB_TAB_OVERVIEW_PREVIEW_MIP_MAP_LEVEL,
+            // Pipe it to eyeGUI
+            eyegui::setImageOfPicture(
+                _pTabOverviewLayout,
+                "preview",
+                "current_tab_preview",
                 tabPreviewWidth,
                 tabPreviewHeight,
-                tabPreviewData))
-            {
-                // Pipe it to eyeGUI
-                eyegui::setImageOfPicture(
-                    _pTabOverviewLayout,
-                    "preview",
-                    "current_tab_preview",
-                    tabPreviewWidth,
-                    tabPreviewHeight,
-                    eyegui::ColorFormat::RGBA,
-                    tabPreviewData.data(),
-                    true);
-            }
+                eyegui::ColorFormat::RGBA,
+                tabPreviewData.data(),
+                true);
         }
 
         // Activate buttons
@@ -865,6 +915,56 @@ void Web::UpdateTabOverview()
     }
 }
 
+void Web::UpdateHibernation()
+{
+	if (!setup::TAB_HIBERNATION)
+	{
+		return;
+	}
+
+	// Estimate memory of all tabs and collect awake ones in background
+	size_t memory = 0;
+	std::vector<Tab*> candidates;
+	for (const auto& rPair : _tabs)
+	{
+		memory += rPair.second->GetMemoryEstimate();
+		if (rPair.first != _currentTabId && !rPair.second->IsHibernating())
+		{
+			candidates.push_back(rPair.second.get());
+		}
+	}
+
+	// Least recently used first
+	std::sort(candidates.begin(), candidates.end(), [](const Tab* pA, const Tab* pB)
+	{
+		return pA->GetLastActiveTime() < pB->GetLastActiveTime();
+	});
+
+	// Hibernate tabs until remaining ones are neither idle nor over budget
+	const auto now = std::chrono::steady_clock::now();
+	const size_t budget = (size_t)setup::TAB_MEMORY_BUDGET * 1024 * 1024;
+	for (Tab* pTab : candidates)
+	{
+		bool idle = std::chrono::duration<float>(now - pTab->GetLastActiveTime()).count() >= setup::TAB_HIBERNATION_IDLE_TIME;
+		if (!idle && memory <= budget)
+		{
+			break; // following tabs were active more recently
+		}
+		memory -= pTab->GetMemoryEstimate();
+
+		// Keep preview as thumbnail, browser is closed by hibernation
+		const int browserId = pTab->GetBrowserId();
+		std::vector<unsigned char> thumbnail;
+		int thumbnailWidth = 0;
+		int thumbnailHeight = 0;
+		unsigned int generation = 0;
+		_upPreviewManager->GetPreview(browserId, thumbnailWidth, thumbnailHeight, thumbnail, generation);
+		_upPreviewManager->RemovePreview(browserId);
+		pTab->Hibernate(std::move(thumbnail), thumbnailWidth, thumbnailHeight);
+		memory += pTab->GetMemoryEstimate();
+	}
+}
+
 int Web::CalculatePageCountOfTabOverview() const
 {
     return ((int)_tabs.size() / SLOTS_PER_TAB_OVERVIEW_PAGE) + 1;
@@ -956,7 +1056,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 			if (tabId >= 0)
 			{
 				_pWeb->_tabs[tabId]->GoBack();
-				_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_GO_BACK_USAGE_COUNT, FirebaseJSONKey::GENERAL_GO_BACK_USAGE);
+				_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_GO_BACK_USAGE_COUNT, FirebaseJSONKey::GENERAL_GO_BACK_USAGE);
 			}
 			LabStreamMailer::instance().Send("Go back");
 		}
@@ -966,7 +1066,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 			if (tabId >= 0)
 			{
 				_pWeb->_tabs[tabId]->GoForward();
-				_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_GO_FORWARD_USAGE_COUNT, FirebaseJSONKey::GENERAL_GO_FORWARD_USAGE);
+				_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_GO_FORWARD_USAGE_COUNT, FirebaseJSONKey::GENERAL_GO_FORWARD_USAGE);
 			}
 			LabStreamMailer::instance().Send("Go forward");
 		}
@@ -1024,7 +1124,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 				if (success)
 				{
 					nlohmann::json record = { { "url", URL } };
-					_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_BOOKMARK_ADDING_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_ADDING, record);
+					_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_BOOKMARK_ADDING_COUNT, FirebaseJSONKey::GENERAL_BOOKMARK_ADDING, record);
 				}
 			}
 
@@ -1039,7 +1139,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 				_pWeb->ShowTabOverview(false);
 			}
 			LabStreamMailer::instance().Send("Reload tab");
-			_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_RELOADING_COUNT, FirebaseJSONKey::GENERAL_TAB_RELOADING);
+			_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_RELOADING_COUNT, FirebaseJSONKey::GENERAL_TAB_RELOADING);
 		}
 		else if (id == "close_tab")
 		{
@@ -1049,7 +1149,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 				_pWeb->UpdateTabOverview();
 			}
 			LabStreamMailer::instance().Send("Close tab");
-			_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_CLOSING_COUNT, FirebaseJSONKey::GENERAL_TAB_CLOSING);
+			_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_CLOSING_COUNT, FirebaseJSONKey::GENERAL_TAB_CLOSING);
 		}
 		else if (id == "back")
 		{
@@ -1078,12 +1178,12 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 
 			JSMailer::instance().Send("new_tab");
 			LabStreamMailer::instance().Send("Open new tab");
-			_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_CREATION_COUNT, FirebaseJSONKey::GENERAL_TAB_CREATION);
+			_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_CREATION_COUNT, FirebaseJSONKey::GENERAL_TAB_CREATION);
 		}
 		else if (id == "tab_button_0")
 		{
 			int index = 0 + (_pWeb->_tabOverviewPage * SLOTS_PER_TAB_OVERVIEW_PAGE);
-			if(_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) {_pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
+			if(_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) {_pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
 			if (_pWeb->SwitchToTabByIndex(index))
 			{
 				_pWeb->ShowTabOverview(false);
@@ -1093,7 +1193,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		else if (id == "tab_button_1")
 		{
 			int index = 1 + (_pWeb->_tabOverviewPage * SLOTS_PER_TAB_OVERVIEW_PAGE);
-			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
+			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
 			if (_pWeb->SwitchToTabByIndex(index))
 			{
 				_pWeb->ShowTabOverview(false);
@@ -1102,7 +1202,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		else if (id == "tab_button_2")
 		{
 			int index = 2 + (_pWeb->_tabOverviewPage * SLOTS_PER_TAB_OVERVIEW_PAGE);
-			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
+			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
 			if (_pWeb->SwitchToTabByIndex(index))
 			{
 				_pWeb->ShowTabOverview(false);
@@ -1111,7 +1211,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		else if (id == "tab_button_3")
 		{
 			int index = 3 + (_pWeb->_tabOverviewPage * SLOTS_PER_TAB_OVERVIEW_PAGE);
-			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
+			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
 			if (_pWeb->SwitchToTabByIndex(index))
 			{
 				_pWeb->ShowTabOverview(false);
@@ -1120,7 +1220,7 @@ void Web::WebButtonListener::down(eyegui::Layout* pLayout, std::string id)
 		else if (id == "tab_button_4")
 		{
 			int index = 4 + (_pWeb->_tabOverviewPage * SLOTS_PER_TAB_OVERVIEW_PAGE);
-			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->SimplePushBackAsyncJob(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
+			if (_pWeb->_tabIdOrder[index] != _pWeb->_currentTabId) { _pWeb->_pMaster->AppendFirebaseRecord(FirebaseIntegerKey::GENERAL_TAB_SWITCHING_COUNT, FirebaseJSONKey::GENERAL_TAB_SWITCHING); }
 			if (_pWeb->SwitchToTabByIndex(index))
 			{
 				_pWeb->ShowTabOverview(false);
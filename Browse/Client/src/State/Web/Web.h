@@ -11,6 +11,7 @@
 #include "src/State/Web/Tab/Tab.h"
 #include "src/State/Web/Managers/BookmarkManager.h"
 #include "src/State/Web/Managers/HistoryManager.h"
+#include "src/State/Web/Managers/PreviewManager.h"
 #include "src/State/Web/Screens/URLInput.h"
 #include "src/State/Web/Screens/History.h"
 #include <map>
@@ -211,6 +212,9 @@ private:
 	// Update icon of tab overview
 	void UpdateTabOverviewIcon();
 
+	// Hibernate tabs in background which are idle or least recently used while over memory budget
+	void UpdateHibernation();
+
 	// Validate URL. Returns true if recognized as URL
 	bool ValidateURL(const std::string& rURL) const;
 
@@ -230,6 +234,15 @@ private:
     // Tab overview page [0..PageCount-1]
     int _tabOverviewPage = 0;
 
+    // Preview uploaded to eyeGUI per slot of tab overview. Only uploaded again if tab or its content changed
+    struct TabOverviewPreview
+    {
+        int tabId = -1;
+        bool thumbnail = false; // thumbnail of hibernated tab
+        unsigned int generation = 0; // generation of web view texture, which is unique among textures
+    };
+    std::vector<TabOverviewPreview> _tabOverviewPreviews = std::vector<TabOverviewPreview>(SLOTS_PER_TAB_OVERVIEW_PAGE);
+
     // Pointer to mediator
     Mediator* _pCefMediator;
 
@@ -248,6 +261,9 @@ private:
 	// History object
 	std::unique_ptr<History> _upHistory;
 
+	// Preview manager
+	std::unique_ptr<PreviewManager> _upPreviewManager;
+
 	// URL input object
 	std::unique_ptr<URLInput> _upURLInput;
 
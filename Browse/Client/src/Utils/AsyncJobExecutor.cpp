@@ -0,0 +1,124 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "AsyncJobExecutor.h"
+#include <algorithm>
+
+AsyncJobExecutor::AsyncJobExecutor(int threadCount)
+{
+	// Start workers
+	threadCount = std::max(1, threadCount);
+	for (int i = 0; i < threadCount; i++)
+	{
+		_threads.push_back(std::unique_ptr<std::thread>(new std::thread([this]() { this->Work(); })));
+	}
+}
+
+AsyncJobExecutor::~AsyncJobExecutor()
+{
+	// Tell workers to stop after remaining tasks
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shouldStop = true;
+	}
+	_conditionVariable.notify_all();
+	for (auto& rupThread : _threads)
+	{
+		rupThread->join();
+	}
+}
+
+void AsyncJobExecutor::PushBack(std::function<bool()> job, std::function<void(bool)> callback)
+{
+	_pendingCount++;
+	_queuedCount++;
+	_tasks.Push({ std::move(job), std::move(callback), std::chrono::steady_clock::now() });
+
+	// Wake up a worker. Lock is only taken when a worker might be about to wait, so task is not missed
+	if (_sleepingCount > 0)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+	}
+	_conditionVariable.notify_one();
+}
+
+void AsyncJobExecutor::Update()
+{
+	Completion completion;
+	while (_completions.Pop(completion))
+	{
+		completion.callback(completion.result);
+	}
+}
+
+void AsyncJobExecutor::WaitAll()
+{
+	while (_pendingCount > 0)
+	{
+		Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	Update();
+}
+
+AsyncJobExecutor::Metrics AsyncJobExecutor::GetMetrics() const
+{
+	Metrics metrics;
+	metrics.threadCount = (int)_threads.size();
+	metrics.queueDepth = _queuedCount;
+	metrics.runningCount = _runningCount;
+	metrics.completedCount = _completedCount;
+	if (metrics.completedCount > 0)
+	{
+		metrics.averageLatency = ((double)_latencySum / (double)metrics.completedCount) / 1000000.0;
+		metrics.averageDuration = ((double)_durationSum / (double)metrics.completedCount) / 1000000.0;
+	}
+	metrics.maxLatency = (double)_maxLatency / 1000000.0;
+	return metrics;
+}
+
+void AsyncJobExecutor::Work()
+{
+	while (true)
+	{
+		// Wait for task
+		Task task;
+		bool popped = false;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_sleepingCount++; // announced before checking queue, so producer either sees it or task is found
+			_conditionVariable.wait(lock, [&]
+			{
+				popped = _tasks.Pop(task);
+				return popped || _shouldStop;
+			});
+			_sleepingCount--;
+		}
+		if (!popped) { break; } // should stop and no tasks left
+
+		// Execute task
+		auto start = std::chrono::steady_clock::now();
+		_queuedCount--;
+		_runningCount++;
+		bool result = task.job();
+		auto end = std::chrono::steady_clock::now();
+		_runningCount--;
+
+		// Update metrics
+		long long latency = std::chrono::duration_cast<std::chrono::microseconds>(start - task.submission).count();
+		_latencySum += latency;
+		_durationSum += std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+		long long maxLatency = _maxLatency;
+		while (latency > maxLatency && !_maxLatency.compare_exchange_weak(maxLatency, latency)) {}
+		_completedCount++;
+
+		// Hand callback over to update
+		if (task.callback)
+		{
+			_completions.Push({ std::move(task.callback), result });
+		}
+		_pendingCount--;
+	}
+}
@@ -0,0 +1,101 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Executes jobs on a fixed count of worker threads. Jobs are submitted into a
+// lock-free queue and completion callbacks are delivered back to the thread
+// which calls Update, usually the main loop.
+
+#ifndef ASYNCJOBEXECUTOR_H_
+#define ASYNCJOBEXECUTOR_H_
+
+#include "src/Utils/MPSCQueue.h"
+#include <functional>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+class AsyncJobExecutor
+{
+public:
+
+	// Metrics of executor
+	struct Metrics
+	{
+		int threadCount = 0;
+		int queueDepth = 0; // jobs waiting for a worker
+		int runningCount = 0; // jobs executed right now
+		long long completedCount = 0;
+		double averageLatency = 0; // seconds from submission to start of job
+		double maxLatency = 0;
+		double averageDuration = 0; // seconds from start to end of job
+	};
+
+	// Constructor, starts worker threads
+	AsyncJobExecutor(int threadCount);
+
+	// Destructor, executes remaining jobs and stops worker threads. Callbacks are not delivered anymore
+	virtual ~AsyncJobExecutor();
+
+	// Executor owns threads, so it must not be copied
+	AsyncJobExecutor(const AsyncJobExecutor&) = delete;
+	AsyncJobExecutor& operator=(const AsyncJobExecutor&) = delete;
+
+	// Push back job. Callback receives result of job at next update and might be nullptr
+	void PushBack(std::function<bool()> job, std::function<void(bool)> callback = nullptr);
+
+	// Deliver callbacks of completed jobs
+	void Update();
+
+	// Block until all jobs are completed and deliver their callbacks
+	void WaitAll();
+
+	// Get metrics
+	Metrics GetMetrics() const;
+
+private:
+
+	// Submitted job
+	struct Task
+	{
+		std::function<bool()> job;
+		std::function<void(bool)> callback;
+		std::chrono::steady_clock::time_point submission;
+	};
+
+	// Completed job with callback
+	struct Completion
+	{
+		std::function<void(bool)> callback;
+		bool result = false;
+	};
+
+	// Loop of worker thread
+	void Work();
+
+	// Queues
+	MPSCQueue<Task> _tasks; // popped by workers while holding mutex
+	MPSCQueue<Completion> _completions; // popped by update
+
+	// Threading
+	std::vector<std::unique_ptr<std::thread> > _threads;
+	std::mutex _mutex; // serializes workers popping tasks and guards sleeping
+	std::condition_variable _conditionVariable; // used to wake up workers at available tasks
+	std::atomic<int> _sleepingCount = 0; // workers which might wait on condition variable
+	std::atomic<bool> _shouldStop = false;
+	std::atomic<int> _pendingCount = 0; // submitted but not yet completed jobs
+
+	// Metrics
+	std::atomic<int> _queuedCount = 0;
+	std::atomic<int> _runningCount = 0;
+	std::atomic<long long> _completedCount = 0;
+	std::atomic<long long> _latencySum = 0; // microseconds
+	std::atomic<long long> _maxLatency = 0; // microseconds
+	std::atomic<long long> _durationSum = 0; // microseconds
+};
+
+#endif // ASYNCJOBEXECUTOR_H_
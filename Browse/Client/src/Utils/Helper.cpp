@@ -11,6 +11,11 @@
 #include <vector>
 #include <ctime>
 #include <chrono>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif // _WIN32
 
 std::string RGBAToHexString(glm::vec4 color)
 {
@@ -220,4 +225,14 @@ std::string GetTimestamp()
 {
 	std::chrono::milliseconds ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
 	return std::to_string(ms.count());
+}
+
+bool ReplaceFileAtomically(const std::string& rSourcePath, const std::string& rTargetPath)
+{
+#ifdef _WIN32
+	// Renaming does not overwrite existing files on Windows
+	return MoveFileExA(rSourcePath.c_str(), rTargetPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return std::rename(rSourcePath.c_str(), rTargetPath.c_str()) == 0;
+#endif // _WIN32
 }
\ No newline at end of file
@@ -32,4 +32,7 @@ std::string GetDate();
 // Simple getter of timestamp (in miliseconds)
 std::string GetTimestamp();
 
+// Replace target file by source file, without a moment in which neither exists. Returns whether successful
+bool ReplaceFileAtomically(const std::string& rSourcePath, const std::string& rTargetPath);
+
 #endif // HELPER_H_
@@ -0,0 +1,179 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "HttpTransport.h"
+#include "src/Setup.h"
+#include "externals/curl/include/curl/curl.h"
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+// Write callback for CURL
+static size_t AppendCallback(void *contents, size_t size, size_t nmemb, void *userp)
+{
+	((std::string*)userp)->append((char*)contents, size * nmemb);
+	return size * nmemb;
+}
+
+HttpTransport::HttpTransport()
+{
+	CURLM* pMulti = curl_multi_init();
+	if (pMulti)
+	{
+		curl_multi_setopt(pMulti, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX); // multiplex requests over one HTTP/2 connection
+		curl_multi_setopt(pMulti, CURLMOPT_MAX_HOST_CONNECTIONS, setup::HTTP_TRANSPORT_MAX_HOST_CONNECTIONS); // for servers without HTTP/2
+	}
+	_pMulti = pMulti;
+}
+
+HttpTransport::~HttpTransport()
+{
+	for (void* pHandle : _idleHandles)
+	{
+		curl_easy_cleanup((CURL*)pHandle);
+	}
+	if (_pMulti) { curl_multi_cleanup((CURLM*)_pMulti); }
+}
+
+HttpTransport::Response HttpTransport::Perform(const Request& rRequest)
+{
+	return Perform(std::vector<Request>{ rRequest }).front();
+}
+
+std::vector<HttpTransport::Response> HttpTransport::Perform(const std::vector<Request>& rRequests)
+{
+	std::vector<Response> responses(rRequests.size());
+	if (!_pMulti)
+	{
+		for (auto& rResponse : responses) { rResponse.error = "CURL multi handle not available"; }
+		return responses;
+	}
+	CURLM* pMulti = (CURLM*)_pMulti;
+
+	// Prepare transfers
+	std::vector<CURL*> handles(rRequests.size(), nullptr);
+	std::vector<curl_slist*> headerLists(rRequests.size(), nullptr);
+	for (size_t i = 0; i < rRequests.size(); i++)
+	{
+		const Request& rRequest = rRequests[i];
+		Response& rResponse = responses[i];
+
+		// Reuse handle if available
+		CURL* pHandle = nullptr;
+		if (!_idleHandles.empty())
+		{
+			pHandle = (CURL*)_idleHandles.back();
+			_idleHandles.pop_back();
+			curl_easy_reset(pHandle);
+		}
+		else
+		{
+			pHandle = curl_easy_init();
+		}
+		if (!pHandle)
+		{
+			rResponse.error = "CURL handle not available";
+			continue;
+		}
+		handles[i] = pHandle;
+
+		// Header fields
+		for (const auto& rHeader : rRequest.headers)
+		{
+			headerLists[i] = curl_slist_append(headerLists[i], rHeader.c_str());
+		}
+
+		// Setup transfer
+		curl_easy_setopt(pHandle, CURLOPT_URL, rRequest.URL.c_str());
+		curl_easy_setopt(pHandle, CURLOPT_HTTPHEADER, headerLists[i]);
+		curl_easy_setopt(pHandle, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
+		curl_easy_setopt(pHandle, CURLOPT_TCP_KEEPALIVE, 1L);
+		curl_easy_setopt(pHandle, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS); // HTTP/2 over TLS, otherwise HTTP/1.1
+		curl_easy_setopt(pHandle, CURLOPT_PIPEWAIT, 1L); // rather wait for multiplexing than opening another connection
+		curl_easy_setopt(pHandle, CURLOPT_HEADERFUNCTION, AppendCallback);
+		curl_easy_setopt(pHandle, CURLOPT_WRITEFUNCTION, AppendCallback);
+		curl_easy_setopt(pHandle, CURLOPT_HEADERDATA, &rResponse.header);
+		curl_easy_setopt(pHandle, CURLOPT_WRITEDATA, &rResponse.body);
+		curl_easy_setopt(pHandle, CURLOPT_PRIVATE, (void*)&rResponse);
+		if (rRequest.method != "GET")
+		{
+			curl_easy_setopt(pHandle, CURLOPT_POSTFIELDSIZE, (long)rRequest.body.size());
+			curl_easy_setopt(pHandle, CURLOPT_POSTFIELDS, rRequest.body.c_str()); // request outlives transfer
+			if (rRequest.method != "POST")
+			{
+				curl_easy_setopt(pHandle, CURLOPT_CUSTOMREQUEST, rRequest.method.c_str());
+			}
+		}
+		curl_multi_add_handle(pMulti, pHandle);
+	}
+
+	// Drive transfers until all are done
+	int running = 0;
+	do
+	{
+		if (curl_multi_perform(pMulti, &running) != CURLM_OK) { break; }
+		if (running > 0)
+		{
+			curl_multi_wait(pMulti, nullptr, 0, 1000, nullptr);
+		}
+	} while (running > 0);
+
+	// Collect results
+	int messageCount = 0;
+	while (CURLMsg* pMessage = curl_multi_info_read(pMulti, &messageCount))
+	{
+		if (pMessage->msg != CURLMSG_DONE) { continue; }
+		Response* pResponse = nullptr;
+		curl_easy_getinfo(pMessage->easy_handle, CURLINFO_PRIVATE, (char**)&pResponse);
+		if (!pResponse) { continue; }
+		if (pMessage->data.result == CURLE_OK)
+		{
+			pResponse->performed = true;
+			curl_easy_getinfo(pMessage->easy_handle, CURLINFO_RESPONSE_CODE, &pResponse->status);
+		}
+		else
+		{
+			pResponse->error = curl_easy_strerror(pMessage->data.result);
+		}
+	}
+
+	// Give handles back, connections stay in cache of multi handle
+	for (size_t i = 0; i < handles.size(); i++)
+	{
+		if (handles[i])
+		{
+			curl_multi_remove_handle(pMulti, handles[i]);
+			_idleHandles.push_back(handles[i]);
+		}
+		if (headerLists[i]) { curl_slist_free_all(headerLists[i]); }
+	}
+
+	return responses;
+}
+
+std::string HttpTransport::ExtractHeaderField(const std::string& rHeader, const std::string& rName)
+{
+	auto lower = [](std::string text)
+	{
+		std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+		return text;
+	};
+	const std::string name = lower(rName);
+
+	std::istringstream lineStream(rHeader);
+	std::string line;
+	std::string value;
+	while (std::getline(lineStream, line)) // go over lines
+	{
+		const size_t colon = line.find(':');
+		if (colon == std::string::npos || lower(line.substr(0, colon)) != name) { continue; }
+
+		// Strip surrounding whitespace. Later occurrences win, e.g. after redirection
+		const size_t begin = line.find_first_not_of(" \t", colon + 1);
+		const size_t end = line.find_last_not_of(" \t\r");
+		value = (begin == std::string::npos || end < begin) ? "" : line.substr(begin, end - begin + 1);
+	}
+	return value;
+}
@@ -0,0 +1,64 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// HTTP transport on a CURL multi handle. Connections are kept alive between
+// calls and requests which are performed together are multiplexed over HTTP/2
+// where the server supports it. Not threadsafe, use one per thread.
+
+#ifndef HTTPTRANSPORT_H_
+#define HTTPTRANSPORT_H_
+
+#include <string>
+#include <vector>
+
+class HttpTransport
+{
+public:
+
+	// Request
+	struct Request
+	{
+		std::string method = "GET"; // GET, PUT or POST
+		std::string URL;
+		std::vector<std::string> headers;
+		std::string body;
+	};
+
+	// Response
+	struct Response
+	{
+		bool performed = false; // whether transfer succeeded, regardless of status
+		long status = 0; // HTTP status code
+		std::string header; // all received header lines
+		std::string body;
+		std::string error; // description of transfer error
+	};
+
+	// Constructor
+	HttpTransport();
+
+	// Destructor
+	virtual ~HttpTransport();
+
+	// Transport owns CURL handles, so it must not be copied
+	HttpTransport(const HttpTransport&) = delete;
+	HttpTransport& operator=(const HttpTransport&) = delete;
+
+	// Perform single request
+	Response Perform(const Request& rRequest);
+
+	// Perform requests at the same time. Responses have the order of the requests
+	std::vector<Response> Perform(const std::vector<Request>& rRequests);
+
+	// Extract value of header field from received header lines, ignoring case of name. Empty if not found
+	static std::string ExtractHeaderField(const std::string& rHeader, const std::string& rName);
+
+private:
+
+	// Members
+	void* _pMulti = nullptr; // CURLM
+	std::vector<void*> _idleHandles; // CURL, reused for later requests
+};
+
+#endif // HTTPTRANSPORT_H_
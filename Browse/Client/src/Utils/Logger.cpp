@@ -8,54 +8,465 @@
 #include "src/Setup.h"
 #include "submodules/spdlog/include/spdlog/spdlog.h"
 #include <memory>
-
-// Shared pointer of global logger
-std::shared_ptr<spdlog::logger> GlobalLog;
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <limits>
 
 // Definition of logger path variable
 std::string LogPath;
 
-std::shared_ptr<spdlog::logger> Log()
+// Identification of binary log file
+static const char LOG_BINARY_MAGIC[8] = { 'G', 'T', 'W', 'L', 'O', 'G', '2', '\n' };
+
+// Convert level to name
+static const char* LevelName(LogLevel level)
+{
+	switch (level)
+	{
+	case LogLevel::Info: return "info";
+	case LogLevel::Debug: return "debug";
+	default: return "error"; // also bug
+	}
+}
+
+// Prefix of line with time and level
+static void AppendPrefix(const LogMessage& rMessage, std::string& rLine)
+{
+	const std::time_t seconds = (std::time_t)(rMessage.timestamp / 1000000);
+	std::tm time = *std::localtime(&seconds); // only called by one thread at a time
+	char buffer[64];
+	std::strftime(buffer, sizeof(buffer), "[%m/%d/%y-%H:%M:%S] ", &time);
+	rLine.append(buffer);
+	rLine.append(LevelName(rMessage.level));
+	rLine.append(": ");
+}
+
+// ###################
+// ### LOG BACKEND ###
+// ###################
+
+// Owns ring buffer and logging thread. Producers reserve messages lock-free,
+// the logging thread writes them in order of reservation
+class LogBackend
+{
+public:
+
+	// Constructor, starts logging thread
+	LogBackend();
+
+	// Writes remaining messages and stops logging thread. Later messages are never written
+	void Stop();
+
+	// Reserve message, nullptr if ring buffer is full
+	LogMessage* Begin(LogLevel level);
+
+	// Publish message to logging thread
+	void Commit(LogMessage* pMessage);
+
+private:
+
+	// Slot of ring buffer. Sequence equals position when free and position plus one when committed
+	struct Slot
+	{
+		std::atomic<unsigned long long> sequence;
+		LogMessage message;
+	};
+
+	// Loop of logging thread
+	void Work();
+
+	// Write committed messages reserved before end position. Returns count of written messages
+	int Drain(unsigned long long endPosition);
+
+	// Write message to outputs
+	void Write(const LogMessage& rMessage);
+
+	// Write message to binary log file, which is rotated like the text log files
+	void WriteBinary(const LogMessage& rMessage);
+
+	// Ring buffer
+	std::unique_ptr<Slot[]> _upSlots;
+	const unsigned long long _mask = LOG_RING_CAPACITY - 1;
+	std::atomic<unsigned long long> _enqueuePosition = 0;
+	unsigned long long _dequeuePosition = 0; // only accessed by logging thread
+	std::atomic<unsigned long long> _droppedCount = 0;
+
+	// Outputs, only accessed by logging thread
+	std::shared_ptr<spdlog::logger> _spLogger;
+	std::ofstream _binaryStream;
+	long long _binarySize = 0;
+	std::string _line;
+
+	// Threading
+	std::mutex _mutex;
+	std::condition_variable _conditionVariable; // used to wake up logging thread, which also checks regularly
+	std::atomic<bool> _shouldStop = false;
+	std::unique_ptr<std::thread> _upThread;
+};
+
+LogBackend::LogBackend()
+{
+	// Preallocate ring buffer
+	static_assert((LOG_RING_CAPACITY & (LOG_RING_CAPACITY - 1)) == 0, "Capacity of log ring buffer must be power of two");
+	_upSlots = std::unique_ptr<Slot[]>(new Slot[LOG_RING_CAPACITY]);
+	for (unsigned long long i = 0; i < LOG_RING_CAPACITY; i++)
+	{
+		_upSlots[i].sequence.store(i, std::memory_order_relaxed);
+	}
+
+	// Create outputs
+	if (setup::LOG_BINARY)
+	{
+		_binaryStream.open(LogPath + LOG_FILE_NAME + ".bin", std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+		_binarySize = (long long)_binaryStream.tellp();
+		if (_binarySize == 0) { _binaryStream.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC)); }
+	}
+	else
+	{
+		std::vector<spdlog::sink_ptr> sinks; // only written by logging thread
+		sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_st>(LogPath + LOG_FILE_NAME + ".txt", LOG_FILE_MAX_SIZE, LOG_FILE_COUNT));
+		sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_st>());
+		_spLogger = std::make_shared<spdlog::logger>("global_log", begin(sinks), end(sinks));
+		_spLogger->set_pattern("%v"); // time and level are taken from message
+		_spLogger->set_level(spdlog::level::debug); // debug messages are filtered at compile time
+	}
+
+	// Start logging thread
+	_upThread = std::unique_ptr<std::thread>(new std::thread([this]() { this->Work(); }));
+}
+
+void LogBackend::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_shouldStop = true;
+	}
+	_conditionVariable.notify_all();
+	_upThread->join();
+}
+
+LogMessage* LogBackend::Begin(LogLevel level)
+{
+	// Reserve slot
+	unsigned long long position = _enqueuePosition.load(std::memory_order_relaxed);
+	Slot* pSlot = nullptr;
+	while (true)
+	{
+		pSlot = &_upSlots[position & _mask];
+		const unsigned long long sequence = pSlot->sequence.load(std::memory_order_acquire);
+		if (sequence == position)
+		{
+			if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+		}
+		else if (sequence < position) // not yet written by logging thread
+		{
+			_droppedCount++;
+			return nullptr;
+		}
+		else // taken by other producer
+		{
+			position = _enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	// Fill header of message
+	thread_local const unsigned int threadId = (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id());
+	LogMessage& rMessage = pSlot->message;
+	rMessage.position = position;
+	rMessage.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	rMessage.threadId = threadId;
+	rMessage.level = level;
+	rMessage.truncated = false;
+	rMessage.size = 0;
+	rMessage.pOverflow = nullptr;
+	return &rMessage;
+}
+
+void LogBackend::Commit(LogMessage* pMessage)
+{
+	// Message belongs to logging thread after publishing, so read it before
+	const unsigned long long position = pMessage->position;
+	const LogLevel level = pMessage->level;
+	_upSlots[position & _mask].sequence.store(position + 1, std::memory_order_release);
+
+	// Errors are written right away, others wait for regular check of logging thread unless ring buffer fills up
+	if (level == LogLevel::Error || level == LogLevel::Bug || (position & (_mask >> 2)) == 0)
+	{
+		_conditionVariable.notify_one();
+	}
+}
+
+void LogBackend::Work()
+{
+	while (true)
+	{
+		// Messages committed before stop are still written. Later ones are not, otherwise busy producers could delay stop forever
+		const bool stop = _shouldStop;
+		Drain(stop ? _enqueuePosition.load() : std::numeric_limits<unsigned long long>::max());
+
+		// Report dropped messages
+		const unsigned long long droppedCount = _droppedCount.exchange(0);
+		if (droppedCount > 0)
+		{
+			LogMessage message;
+			message.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			message.threadId = 0;
+			message.level = LogLevel::Error;
+			message.truncated = false;
+			message.size = 0;
+			message.pOverflow = nullptr;
+			LogEncodeArgument(message, "Logger: Dropped ", LogCategory<const char*>());
+			LogEncodeArgument(message, droppedCount, LogCategory<unsigned long long>());
+			LogEncodeArgument(message, " messages as ring buffer was full", LogCategory<const char*>());
+			Write(message);
+		}
+		if (stop) { break; }
+
+		// Wait for next check
+		std::unique_lock<std::mutex> lock(_mutex);
+		_conditionVariable.wait_for(lock, std::chrono::milliseconds(LOG_WRITE_INTERVAL), [this] { return (bool)_shouldStop; });
+	}
+	if (_spLogger) { _spLogger->flush(); }
+	if (_binaryStream.is_open()) { _binaryStream.flush(); }
+}
+
+int LogBackend::Drain(unsigned long long endPosition)
+{
+	int count = 0;
+	while (_dequeuePosition < endPosition)
+	{
+		Slot& rSlot = _upSlots[_dequeuePosition & _mask];
+		if (rSlot.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1) { break; } // not yet committed
+		Write(rSlot.message);
+		delete rSlot.message.pOverflow;
+		rSlot.message.pOverflow = nullptr;
+		rSlot.sequence.store(_dequeuePosition + LOG_RING_CAPACITY, std::memory_order_release); // free for next round
+		_dequeuePosition++;
+		count++;
+	}
+	if (count > 0 && _binaryStream.is_open()) { _binaryStream.flush(); }
+	return count;
+}
+
+void LogBackend::Write(const LogMessage& rMessage)
+{
+	if (_binaryStream.is_open())
+	{
+		WriteBinary(rMessage);
+	}
+	else if (_spLogger)
+	{
+		_line.clear();
+		AppendPrefix(rMessage, _line);
+		LogDecode(rMessage, _line);
+		switch (rMessage.level)
+		{
+		case LogLevel::Info: _spLogger->info(_line); break;
+		case LogLevel::Debug: _spLogger->debug(_line); break;
+		default: _spLogger->error(_line); break;
+		}
+	}
+}
+
+void LogBackend::WriteBinary(const LogMessage& rMessage)
+{
+	// Rotate files when too large
+	if (_binarySize >= LOG_FILE_MAX_SIZE)
+	{
+		_binaryStream.close();
+		auto name = [](int index) { return LogPath + LOG_FILE_NAME + (index > 0 ? "." + std::to_string(index) : "") + ".bin"; };
+		std::remove(name(LOG_FILE_COUNT).c_str());
+		for (int i = LOG_FILE_COUNT - 1; i >= 0; i--)
+		{
+			std::rename(name(i).c_str(), name(i + 1).c_str());
+		}
+		_binaryStream.open(name(0), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+		_binaryStream.write(LOG_BINARY_MAGIC, sizeof(LOG_BINARY_MAGIC));
+		_binarySize = sizeof(LOG_BINARY_MAGIC);
+	}
+
+	// Record is header of message followed by encoded arguments and overflow
+	const unsigned char level = (unsigned char)rMessage.level;
+	const unsigned char truncated = rMessage.truncated ? 1 : 0;
+	const unsigned int overflowSize = rMessage.pOverflow != nullptr ? (unsigned int)rMessage.pOverflow->size() : 0;
+	_binaryStream.write(reinterpret_cast<const char*>(&level), sizeof(level));
+	_binaryStream.write(reinterpret_cast<const char*>(&truncated), sizeof(truncated));
+	_binaryStream.write(reinterpret_cast<const char*>(&rMessage.timestamp), sizeof(rMessage.timestamp));
+	_binaryStream.write(reinterpret_cast<const char*>(&rMessage.threadId), sizeof(rMessage.threadId));
+	_binaryStream.write(reinterpret_cast<const char*>(&rMessage.size), sizeof(rMessage.size));
+	_binaryStream.write(rMessage.data, rMessage.size);
+	_binaryStream.write(reinterpret_cast<const char*>(&overflowSize), sizeof(overflowSize));
+	if (overflowSize > 0) { _binaryStream.write(rMessage.pOverflow->data(), overflowSize); }
+	_binarySize += sizeof(level) + sizeof(truncated) + sizeof(rMessage.timestamp) + sizeof(rMessage.threadId) + sizeof(rMessage.size) + rMessage.size + sizeof(overflowSize) + overflowSize;
+}
+
+// Backend is created at first message and never destroyed, as threads might still log during static destruction
+static LogBackend& Backend()
+{
+	static LogBackend* pBackend = []()
+	{
+		LogBackend* pBackend = new LogBackend();
+		std::atexit([]() { Backend().Stop(); });
+		return pBackend;
+	}(); // threadsafe through C++11 standard
+	return *pBackend;
+}
+
+// #################
+// ### FRONT END ###
+// #################
+
+LogMessage* LogBegin(LogLevel level)
+{
+	return Backend().Begin(level);
+}
+
+void LogCommit(LogMessage* pMessage)
 {
-    if (!GlobalLog) // check for null
-    {
-        // Create logger since there is no, yet
-        std::vector<spdlog::sink_ptr> sinks;
-		sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(LogPath + LOG_FILE_NAME + ".txt", LOG_FILE_MAX_SIZE, LOG_FILE_COUNT));
-        sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>());
-        GlobalLog = std::make_shared<spdlog::logger>("global_log", begin(sinks), end(sinks));
-        GlobalLog->set_pattern("[%D-%T] %l: %v");
+	Backend().Commit(pMessage);
+}
 
-		// Set logging level
-		if (setup::DEBUG_MODE)
+// Decode encoded arguments to text. Returns whether successful
+static bool DecodeArguments(const char* pData, size_t size, std::string& rText)
+{
+	char buffer[32];
+	size_t i = 0;
+	auto read = [&](void* pValue, size_t length) -> bool
+	{
+		if (i + length > size) { return false; }
+		std::memcpy(pValue, pData + i, length);
+		i += length;
+		return true;
+	};
+	while (i < size)
+	{
+		const char tag = pData[i++];
+		bool success = false;
+		switch (tag)
+		{
+		case 'b':
+		{
+			unsigned char value = 0;
+			success = read(&value, sizeof(value));
+			if (success) { rText.push_back(value ? '1' : '0'); } // like stream operator
+			break;
+		}
+		case 'c':
+		{
+			char value = 0;
+			success = read(&value, sizeof(value));
+			if (success) { rText.push_back(value); }
+			break;
+		}
+		case 'i':
+		{
+			long long value = 0;
+			success = read(&value, sizeof(value));
+			if (success) { std::snprintf(buffer, sizeof(buffer), "%lld", value); rText.append(buffer); }
+			break;
+		}
+		case 'u':
+		{
+			unsigned long long value = 0;
+			success = read(&value, sizeof(value));
+			if (success) { std::snprintf(buffer, sizeof(buffer), "%llu", value); rText.append(buffer); }
+			break;
+		}
+		case 'd':
+		{
+			double value = 0;
+			success = read(&value, sizeof(value));
+			if (success) { std::snprintf(buffer, sizeof(buffer), "%g", value); rText.append(buffer); } // like stream operator
+			break;
+		}
+		case 's':
 		{
-			GlobalLog->set_level(spdlog::level::debug);
+			unsigned short length = 0;
+			success = read(&length, sizeof(length)) && i + length <= size;
+			if (success) { rText.append(pData + i, length); i += length; }
+			break;
 		}
-		else
+		}
+		if (!success) { rText.append("<corrupted>"); return false; }
+	}
+	return true;
+}
+
+void LogDecode(const LogMessage& rMessage, std::string& rText)
+{
+	if (!DecodeArguments(rMessage.data, rMessage.size, rText)) { return; }
+	if (rMessage.pOverflow != nullptr && !DecodeArguments(rMessage.pOverflow->data(), rMessage.pOverflow->size(), rText)) { return; }
+	if (rMessage.truncated) { rText.append(" <truncated>"); }
+}
+
+bool LogDecodeFile(const std::string& rBinaryFullpath, const std::string& rTextFullpath)
+{
+	// Open files
+	std::ifstream input(rBinaryFullpath, std::ios_base::in | std::ios_base::binary);
+	char magic[sizeof(LOG_BINARY_MAGIC)];
+	if (!input.read(magic, sizeof(magic)) || std::memcmp(magic, LOG_BINARY_MAGIC, sizeof(magic)) != 0) { return false; }
+	std::ofstream output(rTextFullpath, std::ios_base::out | std::ios_base::trunc);
+	if (!output.is_open()) { return false; }
+
+	// Decode record by record
+	LogMessage message;
+	std::string overflow;
+	std::string line;
+	while (true)
+	{
+		unsigned char level = 0;
+		unsigned char truncated = 0;
+		unsigned int overflowSize = 0;
+		if (!input.read(reinterpret_cast<char*>(&level), sizeof(level))) { break; } // end of file
+		bool success =
+			input.read(reinterpret_cast<char*>(&truncated), sizeof(truncated))
+			&& input.read(reinterpret_cast<char*>(&message.timestamp), sizeof(message.timestamp))
+			&& input.read(reinterpret_cast<char*>(&message.threadId), sizeof(message.threadId))
+			&& input.read(reinterpret_cast<char*>(&message.size), sizeof(message.size))
+			&& message.size <= LOG_MESSAGE_CAPACITY
+			&& input.read(message.data, message.size)
+			&& input.read(reinterpret_cast<char*>(&overflowSize), sizeof(overflowSize));
+		if (success)
 		{
-			GlobalLog->set_level(spdlog::level::info);
+			overflow.resize(overflowSize);
+			success = overflowSize == 0 || (bool)input.read(&overflow[0], overflowSize);
 		}
-    }
-    return GlobalLog;
+		if (!success) { return false; } // incomplete record
+		message.level = (LogLevel)level;
+		message.truncated = truncated != 0;
+		message.pOverflow = overflowSize > 0 ? &overflow : nullptr;
+		line.clear();
+		AppendPrefix(message, line);
+		LogDecode(message, line);
+		output << line << "\n";
+	}
+	return true;
 }
 
 void LogInfo(const std::string& content)
 {
-	Log()->info(content);
+	LogPush(LogLevel::Info, content);
 }
 
 void LogError(const std::string& content)
 {
-	Log()->error(content);
+	LogPush(LogLevel::Error, content);
 }
 
 void LogDebug(const std::string& content)
 {
-	Log()->debug(content);
+	if (LOG_DEBUG_ENABLED) { LogPush(LogLevel::Debug, content); }
 }
 
 void LogBug(const std::string& content)
 {
-	Log()->error(content);
+	LogPush(LogLevel::Bug, content);
 }
-
@@ -2,27 +2,193 @@
 // Distributed under the Apache License, Version 2.0.
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
-// Abstraction of logger. Can be called from threads, too.
+// Abstraction of logger. Can be called from threads, too. Arguments of a call
+// are encoded into a preallocated ring buffer and formatted by a background
+// thread, so callers neither wait for the disk nor allocate memory (except
+// for arguments of types without binary encoding and for messages longer than
+// the capacity of a slot). Messages are dropped when the ring buffer is full. Debug messages are removed at compile time if not
+// building for debugging, without formatting anything.
 
 #ifndef LOGGER_H_
 #define LOGGER_H_
 
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <cstring>
 
 // Declaration of output path for log. Should be only set by main.cpp
 extern std::string LogPath;
 
+// Compile-time gate for debug messages
+#ifdef CLIENT_DEBUG
+static const bool LOG_DEBUG_ENABLED = true;
+#else
+static const bool LOG_DEBUG_ENABLED = false;
+#endif
+
+// Level of message
+enum class LogLevel : unsigned char { Info, Error, Debug, Bug };
+
+// Capacity of encoded arguments of one message in bytes. Further arguments are encoded on the heap
+static const unsigned int LOG_MESSAGE_CAPACITY = 480;
+
+// Message in ring buffer. Each argument is encoded as tag followed by value:
+//	'b' : uint8 (bool)
+//	'c' : char
+//	'i' : int64
+//	'u' : uint64
+//	'd' : double
+//	's' : uint16 length, characters
+// Arguments exceeding the capacity are encoded into overflow, in which case all
+// following ones are encoded there, too. Only strings longer than uint16 are truncated
+struct LogMessage
+{
+    unsigned long long position; // in ring buffer, set by logger
+    long long timestamp; // microseconds since epoch
+    unsigned int threadId;
+    LogLevel level;
+    bool truncated;
+    unsigned short size; // of encoded arguments
+    char data[LOG_MESSAGE_CAPACITY];
+    std::string* pOverflow; // encoded arguments beyond capacity, nullptr if none. Deleted by logging thread
+};
+
+// Reserve message in ring buffer. Returns nullptr if full, otherwise message must be committed
+LogMessage* LogBegin(LogLevel level);
+
+// Hand message over to logging thread
+void LogCommit(LogMessage* pMessage);
+
+// Decode arguments of message to text
+void LogDecode(const LogMessage& rMessage, std::string& rText);
+
+// Decode binary log file to text file. Returns whether successful
+bool LogDecodeFile(const std::string& rBinaryFullpath, const std::string& rTextFullpath);
+
+// Reserve bytes for encoded argument in message, on the heap if capacity is exceeded
+inline char* LogReserve(LogMessage& rMessage, size_t length)
+{
+    if (rMessage.pOverflow == nullptr && rMessage.size + length <= LOG_MESSAGE_CAPACITY)
+    {
+        char* pData = rMessage.data + rMessage.size;
+        rMessage.size += (unsigned short)length;
+        return pData;
+    }
+    if (rMessage.pOverflow == nullptr) { rMessage.pOverflow = new std::string(); }
+    const size_t offset = rMessage.pOverflow->size();
+    rMessage.pOverflow->resize(offset + length);
+    return &(*rMessage.pOverflow)[offset];
+}
+
+// Encoding of arguments into message
+inline void LogEncode(LogMessage& rMessage, char tag, const void* pValue, unsigned int length)
+{
+    char* pData = LogReserve(rMessage, 1 + length);
+    pData[0] = tag;
+    std::memcpy(pData + 1, pValue, length);
+}
+
+inline void LogEncodeString(LogMessage& rMessage, const char* pString, size_t length)
+{
+    const unsigned int header = 1 + sizeof(unsigned short);
+    if (length > 0xFFFF) { length = 0xFFFF; rMessage.truncated = true; }
+    const unsigned short shortLength = (unsigned short)length;
+    char* pData = LogReserve(rMessage, header + length);
+    pData[0] = 's';
+    std::memcpy(pData + 1, &shortLength, sizeof(shortLength));
+    std::memcpy(pData + header, pString, length);
+}
+
+// Category of argument type, decides about encoding
+template<typename T>
+struct LogCategory : std::integral_constant<int,
+    std::is_same<T, bool>::value ? 0 :
+    std::is_same<T, char>::value || std::is_same<T, signed char>::value || std::is_same<T, unsigned char>::value ? 1 :
+    std::is_integral<T>::value && std::is_signed<T>::value ? 2 :
+    std::is_integral<T>::value ? 3 :
+    std::is_floating_point<T>::value ? 4 :
+    std::is_convertible<const T&, const char*>::value ? 5 :
+    std::is_same<T, std::string>::value ? 6 : 7> {};
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 0>)
+{
+    const unsigned char value = rValue ? 1 : 0;
+    LogEncode(rMessage, 'b', &value, sizeof(value));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 1>)
+{
+    LogEncode(rMessage, 'c', &rValue, sizeof(char));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 2>)
+{
+    const long long value = (long long)rValue;
+    LogEncode(rMessage, 'i', &value, sizeof(value));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 3>)
+{
+    const unsigned long long value = (unsigned long long)rValue;
+    LogEncode(rMessage, 'u', &value, sizeof(value));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 4>)
+{
+    const double value = (double)rValue;
+    LogEncode(rMessage, 'd', &value, sizeof(value));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 5>)
+{
+    const char* pString = rValue;
+    if (pString == nullptr) { pString = "(null)"; }
+    LogEncodeString(rMessage, pString, std::strlen(pString));
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 6>)
+{
+    LogEncodeString(rMessage, rValue.data(), rValue.size());
+}
+
+template<typename T>
+void LogEncodeArgument(LogMessage& rMessage, const T& rValue, std::integral_constant<int, 7>)
+{
+    // No binary encoding available, use stream operator of type
+    thread_local std::ostringstream stream;
+    stream.str("");
+    stream.clear();
+    stream << rValue;
+    const std::string text = stream.str();
+    LogEncodeString(rMessage, text.data(), text.size());
+}
+
+// Encode arguments into message and hand it over to logging thread
+template<typename... Args>
+void LogPush(LogLevel level, Args const&... args)
+{
+    LogMessage* pMessage = LogBegin(level);
+    if (pMessage == nullptr) { return; } // dropped
+    using List= int[];
+    (void)List{0, ((void)LogEncodeArgument(*pMessage, args, LogCategory<Args>()), 0) ... };
+    LogCommit(pMessage);
+}
+
 // LogInfo
 void LogInfo(const std::string& content);
 
 template<typename... Args>
 void LogInfo(Args const&... args)
 {
-    std::ostringstream stream;
-    using List= int[];
-    (void)List{0, ((void)(stream << args), 0) ... };
-    LogInfo(stream.str());
+    LogPush(LogLevel::Info, args...);
 }
 
 // LogError
@@ -31,10 +197,7 @@ void LogError(const std::string& content);
 template<typename... Args>
 void LogError(Args const&... args)
 {
-    std::ostringstream stream;
-    using List= int[];
-    (void)List{0, ((void)(stream << args), 0) ... };
-    LogError(stream.str());
+    LogPush(LogLevel::Error, args...);
 }
 
 // LogDebug
@@ -43,10 +206,7 @@ void LogDebug(const std::string& content);
 template<typename... Args>
 void LogDebug(Args const&... args)
 {
-    std::ostringstream stream;
-    using List= int[];
-    (void)List{0, ((void)(stream << args), 0) ... };
-    LogDebug(stream.str());
+    if (LOG_DEBUG_ENABLED) { LogPush(LogLevel::Debug, args...); }
 }
 
 // LogBug
@@ -55,10 +215,7 @@ void LogBug(const std::string& content);
 template<typename... Args>
 void LogBug(Args const&... args)
 {
-    std::ostringstream stream;
-    using List= int[];
-    (void)List{0, ((void)(stream << args), 0) ... };
-    LogBug(stream.str());
+    LogPush(LogLevel::Bug, args...);
 }
 
 #endif // LOGGER_H_
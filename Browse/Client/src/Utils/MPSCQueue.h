@@ -0,0 +1,77 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Unbounded lock-free queue with multiple producers and a single consumer.
+// Producers link nodes by an atomic exchange of the head, the consumer owns
+// the tail. Popping may report an empty queue while a push is in progress,
+// the value is then available at the next pop. Values must be default
+// constructible, as the queue always keeps one node with a consumed value.
+
+#ifndef MPSCQUEUE_H_
+#define MPSCQUEUE_H_
+
+#include <atomic>
+#include <utility>
+
+template<typename T>
+class MPSCQueue
+{
+public:
+
+	// Constructor
+	MPSCQueue()
+	{
+		Node* pStub = new Node();
+		_head = pStub;
+		_pTail = pStub;
+	}
+
+	// Destructor, must not be called while pushing
+	virtual ~MPSCQueue()
+	{
+		T value;
+		while (Pop(value)) {}
+		delete _pTail;
+	}
+
+	// Queue owns nodes, so it must not be copied
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+	// Push value, may be called by any thread
+	void Push(T value)
+	{
+		Node* pNode = new Node();
+		pNode->value = std::move(value);
+		Node* pPrevious = _head.exchange(pNode);
+		pPrevious->next = pNode; // makes node visible to consumer
+	}
+
+	// Pop value, must only be called by one thread at a time. Returns whether value was available
+	bool Pop(T& rValue)
+	{
+		Node* pNext = _pTail->next;
+		if (pNext == nullptr) { return false; }
+		rValue = std::move(pNext->value);
+		pNext->value = T();
+		delete _pTail;
+		_pTail = pNext; // next becomes stub
+		return true;
+	}
+
+private:
+
+	// Node of linked list
+	struct Node
+	{
+		std::atomic<Node*> next = nullptr;
+		T value;
+	};
+
+	// Members
+	std::atomic<Node*> _head; // most recently pushed node, written by producers
+	Node* _pTail; // node before next value, only accessed by consumer
+};
+
+#endif // MPSCQUEUE_H_
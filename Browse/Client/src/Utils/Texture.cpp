@@ -6,19 +6,28 @@
 #include "Texture.h"
 
 #include "src/Utils/Helper.h"
+#include <cstring>
+
+// Count of pixel buffers in ring. Three allow filling one while two earlier uploads are still in flight
+static const int PIXEL_BUFFER_COUNT = 3;
+
+// Maximal time to wait for upload from pixel buffer to finish before reusing it, in nanoseconds
+static const GLuint64 PIXEL_BUFFER_FENCE_TIMEOUT = 1000000000;
 
 Texture::Texture(
     int width,
     int height,
     GLenum internalFormat,
     Filter filter,
-    Wrap wrap)
+    Wrap wrap,
+    Upload upload)
 {
     // Initialize members
     _handle = 0;
     _width = width;
     _height = height;
     _internalFormat = internalFormat;
+    _upload = upload;
 
     // Create OpenGL texture
     glActiveTexture(GL_TEXTURE0);
@@ -50,7 +59,6 @@ Texture::Texture(
     switch (filter)
     {
     case Filter::LINEAR:
-        glGenerateMipmap(GL_TEXTURE_2D);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         break;
@@ -66,6 +74,16 @@ Texture::Texture(
 
 Texture::~Texture()
 {
+    // Delete pixel buffers
+    for(GLsync fence : _pixelBufferFences)
+    {
+        if(fence) { glDeleteSync(fence); }
+    }
+    if(!_pixelBuffers.empty())
+    {
+        glDeleteBuffers((GLsizei)_pixelBuffers.size(), _pixelBuffers.data());
+    }
+
     // Delete texture
     glDeleteTextures(1, &_handle);
 }
@@ -113,7 +131,32 @@ void Texture::Fill(
     }
     else
     {
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, inputFormat, GL_UNSIGNED_BYTE, pBuffer);
+        // Copy into pixel buffer if requested, transfer to texture is then performed asynchronously
+        const int bytesPerPixel = GetBytesPerPixel(inputFormat);
+        const GLsizeiptr size = (GLsizeiptr)_width * (GLsizeiptr)_height * bytesPerPixel;
+        unsigned char* pMapped = nullptr;
+        if(_upload == Upload::PIXEL_BUFFER && bytesPerPixel > 0)
+        {
+            pMapped = MapPixelBuffer(size);
+        }
+        if(pMapped)
+        {
+            std::memcpy(pMapped, pBuffer, size);
+            if(UnmapPixelBuffer())
+            {
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, inputFormat, GL_UNSIGNED_BYTE, nullptr); // offset in pixel buffer
+                ReleasePixelBuffer();
+            }
+            else // content of pixel buffer got lost
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, inputFormat, GL_UNSIGNED_BYTE, pBuffer);
+            }
+        }
+        else
+        {
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, _width, _height, inputFormat, GL_UNSIGNED_BYTE, pBuffer);
+        }
     }
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4); // set back to standard
 
@@ -121,67 +164,165 @@ void Texture::Fill(
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-int Texture::GetWidth() const
+void Texture::FillRegions(
+    int width,
+    int height,
+    GLenum inputFormat,
+    unsigned char const * pBuffer,
+    const std::vector<glm::ivec4>& rRegions,
+    int unpackAlignment)
 {
-    return _width;
-}
+    // Allocation necessary, so fill complete texture
+    if(!_initialized || width != _width || height != _height)
+    {
+        Fill(width, height, inputFormat, pBuffer, unpackAlignment);
+        return;
+    }
 
-int Texture::GetHeight() const
-{
-    return _height;
-}
+    // Bind texture
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, _handle);
 
-float Texture::GetAspectRatio() const
-{
-    return ((float)_width) / ((float)_height);
-}
+    // Clamp regions to texture
+    std::vector<glm::ivec4> regions;
+    regions.reserve(rRegions.size());
+    for(const auto& rRegion : rRegions)
+    {
+        const int x = glm::clamp(rRegion.x, 0, _width);
+        const int y = glm::clamp(rRegion.y, 0, _height);
+        const int regionWidth = glm::min(rRegion.x + rRegion.z, _width) - x;
+        const int regionHeight = glm::min(rRegion.y + rRegion.w, _height) - y;
+        if(regionWidth > 0 && regionHeight > 0) { regions.push_back(glm::ivec4(x, y, regionWidth, regionHeight)); }
+    }
 
-glm::vec4 Texture::GetAverageColor() const
-{
-	// TODO: depending on internal format...
+    // Copy regions into pixel buffer with layout of complete image if requested
+    const int bytesPerPixel = GetBytesPerPixel(inputFormat);
+    unsigned char const * pSource = pBuffer;
+    if(_upload == Upload::PIXEL_BUFFER && bytesPerPixel > 0)
+    {
+        if(unsigned char* pMapped = MapPixelBuffer((GLsizeiptr)_width * (GLsizeiptr)_height * bytesPerPixel))
+        {
+            for(const auto& rRegion : regions)
+            {
+                for(int row = rRegion.y; row < rRegion.y + rRegion.w; row++)
+                {
+                    const size_t offset = ((size_t)row * (size_t)_width + (size_t)rRegion.x) * bytesPerPixel;
+                    std::memcpy(pMapped + offset, pBuffer + offset, (size_t)rRegion.z * bytesPerPixel);
+                }
+            }
+            if(UnmapPixelBuffer())
+            {
+                pSource = nullptr; // read from offset in pixel buffer
+            }
+            else // content of pixel buffer got lost
+            {
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+        }
+    }
 
-    // Bind texture and create mip maps
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, _handle);
-	glGenerateMipmap(GL_TEXTURE_2D);
+    // Let OpenGL read regions directly out of complete image
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for(const auto& rRegion : regions)
+    {
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, rRegion.x);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, rRegion.y);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rRegion.x, rRegion.y, rRegion.z, rRegion.w, inputFormat, GL_UNSIGNED_BYTE, pSource);
+    }
+    if(!pSource)
+    {
+        ReleasePixelBuffer();
+    }
+
+    // Set back to standard
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Unbind texture
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    // Calculate count of levels
-	GLint maxLevel = MaximalMipMapLevel(_width, _height);
+unsigned char* Texture::MapPixelBuffer(GLsizeiptr size)
+{
+    // Create ring of pixel buffers at first usage
+    if(_pixelBuffers.empty())
+    {
+        _pixelBuffers.resize(PIXEL_BUFFER_COUNT, 0);
+        _pixelBufferSizes.resize(PIXEL_BUFFER_COUNT, 0);
+        _pixelBufferFences.resize(PIXEL_BUFFER_COUNT, nullptr);
+        glGenBuffers(PIXEL_BUFFER_COUNT, _pixelBuffers.data());
+    }
 
-    // Get resolulution of max mipmap level (Seems to be 1 all time)
-    //GLint width, height;
-    //glGetTexLevelParameteriv(GL_TEXTURE_2D, maxLevel, GL_TEXTURE_WIDTH, &width);
-    //glGetTexLevelParameteriv(GL_TEXTURE_2D, maxLevel, GL_TEXTURE_HEIGHT, &height);
+    // Use next pixel buffer in ring
+    _pixelBufferIndex = (_pixelBufferIndex + 1) % PIXEL_BUFFER_COUNT;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _pixelBuffers[_pixelBufferIndex]);
 
-    // Average color
-    glm::vec4 averageColor;
+    // Wait until uploads from that buffer have finished, usually happened already some frames ago
+    GLsync& rFence = _pixelBufferFences[_pixelBufferIndex];
+    if(rFence)
+    {
+        glClientWaitSync(rFence, GL_SYNC_FLUSH_COMMANDS_BIT, PIXEL_BUFFER_FENCE_TIMEOUT);
+        glDeleteSync(rFence);
+        rFence = nullptr;
+    }
 
-    if(_initialized)
+    // Allocate storage when size has changed
+    if(_pixelBufferSizes[_pixelBufferIndex] != size)
     {
-        // Read pixel from GPU
-        std::vector<unsigned char> img(4); // since always 1x1 pixels at that mipmap level
-        glGetTexImage(GL_TEXTURE_2D, maxLevel, GL_RGBA, GL_UNSIGNED_BYTE, img.data());
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        _pixelBufferSizes[_pixelBufferIndex] = size;
+    }
 
-        // Return average color
-        int r = (int) img[0];
-        int g = (int) img[1];
-        int b = (int) img[2];
-        int a = (int) img[3];
-        averageColor = glm::vec4(
-            ((float) r) / 255.f,
-            ((float) g) / 255.f,
-            ((float) b) / 255.f,
-            ((float) a) / 255.f);
+    // Map without implicit synchronization, as it has been done via fence
+    void* pMapped = glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if(!pMapped)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     }
-    else
+    return (unsigned char*)pMapped;
+}
+
+bool Texture::UnmapPixelBuffer()
+{
+    return glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+}
+
+void Texture::ReleasePixelBuffer()
+{
+    _pixelBufferFences[_pixelBufferIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+int Texture::GetBytesPerPixel(GLenum inputFormat)
+{
+    switch(inputFormat)
     {
-        averageColor = glm::vec4(1,1,1,1);
+    case GL_RGBA:
+    case GL_BGRA:
+        return 4;
+    default:
+        return 0;
     }
+}
 
-    // Unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+int Texture::GetWidth() const
+{
+    return _width;
+}
+
+int Texture::GetHeight() const
+{
+    return _height;
+}
 
-    return averageColor;
+float Texture::GetAspectRatio() const
+{
+    return ((float)_width) / ((float)_height);
 }
 
 bool Texture::GetPixelsFromMipMap(int layer, int& rWidth, int& rHeight, std::vector<unsigned char>& rData)
@@ -190,13 +331,17 @@ bool Texture::GetPixelsFromMipMap(int layer, int& rWidth, int& rHeight, std::vec
 
 	if (_initialized)
 	{
-		// Bind texture and create mip maps
+		// Calculate resolution
+		layer = glm::clamp(layer, 0, MaximalMipMapLevel(_width, _height) - 1);
+
+		// Bind texture and create mip maps, if not reading the base level
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, _handle);
-		glGenerateMipmap(GL_TEXTURE_2D);
+		if (layer > 0)
+		{
+			glGenerateMipmap(GL_TEXTURE_2D);
+		}
 
-		// Calculate resolution
-		layer = glm::clamp(layer, 0, MaximalMipMapLevel(_width, _height) - 1);
 		rWidth = _width;
 		rHeight = _height;
 		for (int i = 0; i < layer; i++)
@@ -30,13 +30,21 @@ public:
         CLAMP, BORDER, MIRROR, REPEAT
     };
 
+    // Synchronous upload copies directly from client memory. Pixel buffer upload copies into ring of pixel
+    // buffer objects and lets the driver transfer asynchronously, overlapping with drawing of previous frames
+    enum class Upload
+    {
+        SYNCHRONOUS, PIXEL_BUFFER
+    };
+
     // Constructor
     Texture(
         int width,
         int height,
         GLenum internalFormat,
         Filter filter,
-        Wrap wrap);
+        Wrap wrap,
+        Upload upload = Upload::SYNCHRONOUS);
 
     // Destructor
     virtual ~Texture();
@@ -53,6 +61,16 @@ public:
         int unpackAlignment = 4,
         bool forceReallocation = false);
 
+    // Fill only regions of texture from buffer with complete image. Regions are given as x, y, width and
+    // height in pixels. Falls back to filling the complete texture if allocation is necessary
+    void FillRegions(
+        int width,
+        int height,
+        GLenum inputFormat,
+        unsigned char const * pBuffer,
+        const std::vector<glm::ivec4>& rRegions,
+        int unpackAlignment = 4);
+
     // Getter for width and height
     int GetWidth() const;
     int GetHeight() const;
@@ -60,10 +78,7 @@ public:
     // Getter for aspect ratio
     float GetAspectRatio() const;
 
-    // Get average color in texture (mip map is calculated)
-    glm::vec4 GetAverageColor() const;
-
-    // Get pixel data from one mip map level. Returns whether successful
+    // Get RGBA pixel data from one mip map level. Returns whether successful
     bool GetPixelsFromMipMap(int layer, int& rWidth, int& rHeight, std::vector<unsigned char>& rData);
 
 	// TODO (Daniel): Experimenting with 'dirty rects' in CefRenderHandle's OnPaint method
@@ -72,12 +87,31 @@ public:
 
 private:
 
+    // Map next pixel buffer of ring for writing and keep it bound. Returns nullptr if not possible
+    unsigned char* MapPixelBuffer(GLsizeiptr size);
+
+    // Unmap bound pixel buffer. Returns whether content is valid
+    bool UnmapPixelBuffer();
+
+    // Remember that current pixel buffer is used by uploads and unbind it
+    void ReleasePixelBuffer();
+
+    // Bytes per pixel of supported input formats for pixel buffer upload, zero if not supported
+    static int GetBytesPerPixel(GLenum inputFormat);
+
     // Members
     bool _initialized = false;
     GLuint _handle = 0;
     int _width = 0;
     int _height = 0;
     GLenum _internalFormat;
+    Upload _upload;
+
+    // Ring of pixel buffers, created at first upload
+    std::vector<GLuint> _pixelBuffers;
+    std::vector<GLsizeiptr> _pixelBufferSizes;
+    std::vector<GLsync> _pixelBufferFences; // signaled when uploads from pixel buffer are finished
+    int _pixelBufferIndex = 0;
 };
 
 #endif // TEXTURE_H_
@@ -13,6 +13,7 @@
 
 #include "src/Master/Master.h"
 #include "src/Utils/Logger.h"
+#include <iostream>
 
 
 // Execute function to have Master object on stack which might be faster than on heap
@@ -30,6 +31,20 @@ bool Execute(CefRefPtr<MainCefApp> app, std::string userDirectory) // returns wh
     // Destructor of master is called implicity
 }
 
+// Decode binary log file, e.g. --decode-log=log.bin writes log.bin.txt
+int DecodeLogMain(CefRefPtr<CefCommandLine> commandLine)
+{
+	const std::string binaryFullpath = commandLine->GetSwitchValue("decode-log").ToString();
+	const std::string textFullpath = binaryFullpath + ".txt";
+	if (!LogDecodeFile(binaryFullpath, textFullpath))
+	{
+		std::cout << "Failed to decode log file: " << binaryFullpath << std::endl;
+		return 1;
+	}
+	std::cout << "Decoded log file to: " << textFullpath << std::endl;
+	return 0;
+}
+
 // Common main for linux and windows
 int CommonMain(const CefMainArgs& args, CefSettings settings, CefRefPtr<MainCefApp> app, void* windows_sandbox_info, std::string userDirectory)
 {
@@ -12,6 +12,9 @@
 // Forward declaration of common main
 int CommonMain(const CefMainArgs& args, CefSettings settings, CefRefPtr<MainCefApp> app, void* windows_sandbox_info, std::string userDirectory);
 
+// Forward declaration of log decoding
+int DecodeLogMain(CefRefPtr<CefCommandLine> commandLine);
+
 // Platform specific shutdown
 void shutdown()
 {
@@ -58,6 +61,12 @@ int APIENTRY wWinMain(
 	CefRefPtr<CefCommandLine> commandLine = CefCommandLine::CreateCommandLine();
 	commandLine->InitFromString(::GetCommandLineW());
 
+	// Decode binary log file instead of running the browser
+	if (commandLine->HasSwitch("decode-log"))
+	{
+		return DecodeLogMain(commandLine);
+	}
+
 	// Create an app of the correct type.
 	CefRefPtr<CefApp> app;
 	CefRefPtr<MainCefApp> mainProcessApp; // extra pointer to main process app implementation. Only filled on main process.
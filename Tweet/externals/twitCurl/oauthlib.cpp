@@ -3,6 +3,7 @@
 #include "HMAC_SHA1.h"
 #include "base64.h"
 #include "urlencode.h"
+#include <atomic>
 
 /*++
 * @method: oAuth::oAuth
@@ -255,8 +256,10 @@ void oAuth::generateNonceTimeStamp()
     char szRand[oAuthLibDefaults::OAUTHLIB_BUFFSIZE];
     memset( szTime, 0, oAuthLibDefaults::OAUTHLIB_BUFFSIZE );
     memset( szRand, 0, oAuthLibDefaults::OAUTHLIB_BUFFSIZE );
+    /* Counter keeps nonces unique when several requests are signed within the same second */
+    static std::atomic<unsigned int> nonceCounter( 0 );
     srand( (unsigned int)time( NULL ) );
-    sprintf( szRand, "%x", rand()%1000 );
+    sprintf( szRand, "%x%x", rand()%1000, nonceCounter++ );
     sprintf( szTime, "%ld", time( NULL ) );
 
     m_nonce.assign( szTime );
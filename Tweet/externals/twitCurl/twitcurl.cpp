@@ -89,6 +89,10 @@ twitCurl* twitCurl::clone()
     cloneObj->setTwitterUsername(m_twitterUsername);
     cloneObj->setTwitterPassword(m_twitterPassword);
 
+    /* Twitter API type */
+    cloneObj->m_eApiFormatType = m_eApiFormatType;
+    cloneObj->m_eProtocolType = m_eProtocolType;
+
     /* OAuth data */
     cloneObj->m_oAuth = m_oAuth.clone();
 
@@ -178,6 +182,41 @@ void twitCurl::setTwitterPassword( const std::string& passWord )
     }
 }
 
+/*++
+* @method: twitCurl::getTwitterProtocolType
+*
+* @description: method to get protocol of Twitter API URLs
+*
+* @input: none
+*
+* @output: protocol type
+*
+*--*/
+twitCurlTypes::eTwitCurlProtocolType twitCurl::getTwitterProtocolType()
+{
+    return m_eProtocolType;
+}
+
+/*++
+* @method: twitCurl::setTwitterProtocolType
+*
+* @description: method to set protocol of Twitter API URLs. Plain http lets
+*               requests be routed through a local proxy, e.g. a stand-in
+*               server for tests
+*
+* @input: protocolType
+*
+* @output: none
+*
+*--*/
+void twitCurl::setTwitterProtocolType( const twitCurlTypes::eTwitCurlProtocolType protocolType )
+{
+    if( protocolType < twitCurlTypes::eTwitCurlProtocolMax )
+    {
+        m_eProtocolType = protocolType;
+    }
+}
+
 /*++
 * @method: twitCurl::getProxyServerIp
 *
@@ -375,6 +414,7 @@ void twitCurl::setInterface( const std::string& Interface )
 *
 * @input: searchQuery - search query in string format
 *         resultCount - optional search result count
+*         maxId - optional, only results older than or equal to this id
 *
 * @output: true if GET is success, otherwise false. This does not check http
 *          response by twitter. Use getLastWebResponse() for that.
@@ -382,7 +422,7 @@ void twitCurl::setInterface( const std::string& Interface )
 * @note: Only ATOM and JSON format supported.
 *
 *--*/
-bool twitCurl::search( const std::string& searchQuery, const std::string resultCount )
+bool twitCurl::search( const std::string& searchQuery, const std::string resultCount, const std::string maxId )
 {
     /* Prepare URL */
     std::string buildUrl = twitCurlDefaults::TWITCURL_PROTOCOLS[m_eProtocolType] +
@@ -398,6 +438,13 @@ bool twitCurl::search( const std::string& searchQuery, const std::string resultC
                     twitCurlDefaults::TWITCURL_COUNT + urlencode( resultCount );
     }
 
+    /* Page back to older results if requested */
+    if( maxId.size() )
+    {
+        buildUrl += twitCurlDefaults::TWITCURL_URL_SEP_AMP +
+                    twitCurlDefaults::TWITCURL_MAXID + urlencode( maxId );
+    }
+
     /* Perform GET */
     return performGet( buildUrl );
 }
@@ -546,20 +593,27 @@ bool twitCurl::retweetById( const std::string& statusId )
 *
 * @description: method to get home timeline
 *
-* @input: none
+* @input: sinceId - optional, only tweets newer than this id
+*         maxId - optional, only tweets older than or equal to this id
 *
 * @output: true if GET is success, otherwise false. This does not check http
 *          response by twitter. Use getLastWebResponse() for that.
 *
 *--*/
-bool twitCurl::timelineHomeGet( const std::string sinceId )
+bool twitCurl::timelineHomeGet( const std::string sinceId, const std::string maxId )
 {
     std::string buildUrl = twitCurlDefaults::TWITCURL_PROTOCOLS[m_eProtocolType] +
                            twitterDefaults::TWITCURL_HOME_TIMELINE_URL +
                            twitCurlDefaults::TWITCURL_EXTENSIONFORMATS[m_eApiFormatType];
+    std::string separator = twitCurlDefaults::TWITCURL_URL_SEP_QUES;
     if( sinceId.length() )
     {
-        buildUrl += twitCurlDefaults::TWITCURL_URL_SEP_QUES + twitCurlDefaults::TWITCURL_SINCEID + sinceId;
+        buildUrl += separator + twitCurlDefaults::TWITCURL_SINCEID + sinceId;
+        separator = twitCurlDefaults::TWITCURL_URL_SEP_AMP;
+    }
+    if( maxId.length() )
+    {
+        buildUrl += separator + twitCurlDefaults::TWITCURL_MAXID + maxId;
     }
 
     /* Perform GET */
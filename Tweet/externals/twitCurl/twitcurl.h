@@ -45,8 +45,12 @@ public:
     void setTwitterUsername( const std::string& userName /* in */ );
     void setTwitterPassword( const std::string& passWord /* in */ );
 
+    /* Twitter API protocol, https unless talking to a local stand-in */
+    twitCurlTypes::eTwitCurlProtocolType getTwitterProtocolType();
+    void setTwitterProtocolType( const twitCurlTypes::eTwitCurlProtocolType protocolType /* in */ );
+
     /* Twitter search APIs */
-    bool search( const std::string& searchQuery /* in */, const std::string resultCount = "" /* in */ );
+    bool search( const std::string& searchQuery /* in */, const std::string resultCount = "" /* in */, const std::string maxId = "" /* in */ );
 
 	bool userSearch(const std::string& searchQuery, const std::string resultCount);
 
@@ -57,7 +61,7 @@ public:
     bool retweetById( const std::string& statusId /* in */ );
 
     /* Twitter timeline APIs */
-    bool timelineHomeGet( const std::string sinceId = ""  /* in */ );
+    bool timelineHomeGet( const std::string sinceId = ""  /* in */, const std::string maxId = "" /* in */ );
     bool timelinePublicGet();
     bool timelineFriendsGet();
     bool timelineUserGet( const bool trimUser /* in */,
@@ -6,6 +6,17 @@
 #include "src/TwitterApp.h"
 #include "src/Keyboard/Keyboard.h"
 
+/**
+* requestAndUpdate function
+* Sends request to Twitter in the background, current page is updated when it has been executed
+* @param[in] call is the request
+*/
+static void requestAndUpdate(AsyncTwitter::Call call) {
+    TwitterApp::getInstance()->getAsyncTwitter()->request(call, [](rapidjson::Document&) {
+        TwitterApp::getInstance()->updateCurrentPage();
+    });
+}
+
 /**
 * ActionBarButton hit function
 * When a Button is hit, different functions of some Classes will be used
@@ -21,8 +32,7 @@ void ActionBarButton::hit(eyegui::Layout* pLayout, std::string id)
         if (id.compare("likeButton") == 0) {
 
             std::string tweetid = TwitterApp::getInstance()->actionButtonArea->tweetId;
-            TwitterApp::getInstance()->getTwitter()->createFavorites(tweetid);
-            TwitterApp::getInstance()->updateCurrentPage();
+            requestAndUpdate([tweetid](Twitter& rTwitter) { return rTwitter.createFavorites(tweetid); });
         }
         if (id.compare("writePNButton") == 0) {
                         Keyboard::getInstance()->activate();
@@ -33,8 +43,7 @@ void ActionBarButton::hit(eyegui::Layout* pLayout, std::string id)
         if (id.compare("dislikeButton") == 0) {
 
             std::string tweetid = TwitterApp::getInstance()->actionButtonArea->tweetId;
-            TwitterApp::getInstance()->getTwitter()->destroyFavorites(tweetid);
-            TwitterApp::getInstance()->updateCurrentPage();
+            requestAndUpdate([tweetid](Twitter& rTwitter) { return rTwitter.destroyFavorites(tweetid); });
         }
 
         if (id.compare("goToProfileButton") == 0) {
@@ -66,8 +75,8 @@ void ActionBarButton::hit(eyegui::Layout* pLayout, std::string id)
     }
 
     if (id.compare("followButton") == 0) {
-        TwitterApp::getInstance()->getTwitter()->createFriendship(TwitterApp::getInstance()->actionButtonArea->userId, true);
-        TwitterApp::getInstance()->updateCurrentPage();
+        std::string userId = TwitterApp::getInstance()->actionButtonArea->userId;
+        requestAndUpdate([userId](Twitter& rTwitter) { return rTwitter.createFriendship(userId, true); });
 
     }
     if (id.compare("searchForButton") == 0) {
@@ -81,19 +90,17 @@ void ActionBarButton::hit(eyegui::Layout* pLayout, std::string id)
 
     }
     if (id.compare("unfollowButton") == 0) {
-        TwitterApp::getInstance()->getTwitter()->destroyFriendship(TwitterApp::getInstance()->actionButtonArea->userId, true);
-        TwitterApp::getInstance()->updateCurrentPage();
+        std::string userId = TwitterApp::getInstance()->actionButtonArea->userId;
+        requestAndUpdate([userId](Twitter& rTwitter) { return rTwitter.destroyFriendship(userId, true); });
 
     }
     if (id.compare("retweetButton") == 0) {
         std::string tweetid = TwitterApp::getInstance()->actionButtonArea->tweetId;
-        TwitterApp::getInstance()->getTwitter()->retweet(tweetid);
-        TwitterApp::getInstance()->updateCurrentPage();
+        requestAndUpdate([tweetid](Twitter& rTwitter) { return rTwitter.retweet(tweetid); });
     }
     if (id.compare("deleteButton") == 0) {
         std::string tweetid = TwitterApp::getInstance()->actionButtonArea->tweetId;
-        TwitterApp::getInstance()->getTwitter()->statusDestroy(tweetid);
-        TwitterApp::getInstance()->updateCurrentPage();
+        requestAndUpdate([tweetid](Twitter& rTwitter) { return rTwitter.statusDestroy(tweetid); });
     }
 }
 
@@ -115,7 +122,11 @@ void ActionBarButton::down(eyegui::Layout* pLayout, std::string id) {
 */
 void ActionBarButton::up(eyegui::Layout* pLayout, std::string id) {
         if (id.compare("writePNButton") == 0) {
-            TwitterApp::getInstance()->getTwitter()->sendDirectMessage(keyWord, TwitterApp::getInstance()->actionButtonArea->userId, true);
+            std::string text = keyWord;
+            std::string userId = TwitterApp::getInstance()->actionButtonArea->userId;
+            TwitterApp::getInstance()->getAsyncTwitter()->request(
+                [text, userId](Twitter& rTwitter) { return rTwitter.sendDirectMessage(text, userId, true); },
+                AsyncTwitter::Callback());
             keyWord="";
         }
 }
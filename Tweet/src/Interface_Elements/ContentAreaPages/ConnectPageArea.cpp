@@ -4,8 +4,9 @@
 
 #include "ConnectPageArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/imageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include <string>
+#include <algorithm>
 
 /**
 * Constructor for the ConnectPageArea Class
@@ -45,6 +46,11 @@ void ConnectPageArea::show() {
 * @param[in] id is ID of selected Contend
 */
 void ConnectPageArea::selectContent(std::string id) {
+		// Messages might not have arrived yet
+		if (id.compare("none") && (!content.IsArray() || index + stoi(id) >= (int)content.Size()))
+		{
+			return;
+		}
 		if (currentlySelected.compare(id))
 		{
 			if (currentlySelected.compare("none"))
@@ -119,17 +125,26 @@ void ConnectPageArea::switchStatus() {
 * showStatus function
 * Changes Status of ConnectPageArea
 * on the basis of a bool a different Function will be used
+* messages are loaded in the background and shown when they arrive
 */
 void ConnectPageArea::showStatus() {
-	if (receivedMessages)
-	{
-		content = TwitterApp::getInstance()->getTwitter()->getDirectMessages();
-		showMessagesReceived();
-	}
-	else {
-		content = TwitterApp::getInstance()->getTwitter()->getDirectMessagesSent();
-		showMessagesSend();
-	}
+	if (!TwitterApp::getInstance()->hasConnection()) return;
+	const int request = ++messagesRequest;
+	const bool received = receivedMessages;
+	TwitterApp::getInstance()->getAsyncTwitter()->request(
+		[received](Twitter& rTwitter) { return received ? rTwitter.getDirectMessages() : rTwitter.getDirectMessagesSent(); },
+		[this, request, received](rapidjson::Document& rReply) {
+			if (request != messagesRequest || !rReply.IsArray()) return;
+			content = std::move(rReply);
+			if (!active) return;
+			if (received)
+			{
+				showMessagesReceived();
+			}
+			else {
+				showMessagesSend();
+			}
+		});
 }
 
 /**
@@ -139,12 +154,13 @@ void ConnectPageArea::showStatus() {
 */
 void ConnectPageArea::scrollUp(int i) {
 	selectContent("none");
+	if (!content.IsArray()) return;
 	if (index + 4 + i <content.Size())
 	{
 		index += i;
 	}
 	else {
-		index = content.Size() - 4;
+		index = std::max(0, (int)content.Size() - 4);
 	}
 
 	if (receivedMessages)
@@ -187,7 +203,7 @@ void ConnectPageArea::scrollDown(int i) {
 * scrolling in other function possible
 */
 void ConnectPageArea::showMessagesReceived() {
-	if (TwitterApp::getInstance()->hasConnection()) {
+	if (TwitterApp::getInstance()->hasConnection() && content.IsArray()) {
 		eyegui::setElementActivity(pLayout, "receivedButton", false);
 		eyegui::setElementActivity(pLayout, "sentButton", true);
 		counter = 0;
@@ -200,25 +216,8 @@ void ConnectPageArea::showMessagesReceived() {
 			eyegui::setContentOfTextBlock(pLayout, textboxes[(i - index)], content[i]["sender"]["name"].GetString() + temp2 + content[i]["sender"]["screen_name"].GetString() + temp + date + temp + content[i]["text"].GetString());
 		
 			
-			// Download avatar image:
-			std::string str = content[i]["sender"]["profile_image_url"].GetString();
-
-			// Extract file extension
-			size_t z = str.rfind('.', str.length());
-			std::string ext = str.substr(z + 1, str.length() - z);
-
-			// Set filename using this rule: profile_ + Profile ID + extension
-			std::string filename = "img/tmp/profile_" + std::string(content[i]["sender"]["id_str"].GetString()) + "." + ext;
-
-			// Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-			int indexStr = str.find("_normal.");
-			str = str.replace(indexStr, 8, "_400x400.");
-
-			std::string path = CONTENT_PATH + std::string("/") + filename;
-			download_image((char*)str.c_str(), (char*)path.c_str());
-
-			eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-			eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(i - index + 1), filename, alignment, false);
+			// Show avatar image, placeholder until it is loaded
+			MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(i - index + 1), MediaLoader::avatarUrl(content[i]["sender"]["profile_image_url"].GetString()), "img/profile_default.png");
 
 		
 		}
@@ -227,8 +226,7 @@ void ConnectPageArea::showMessagesReceived() {
 		{
 
 			eyegui::setContentOfTextBlock(pLayout, textboxes[(r)], fillUp);
-			eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-			eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(r + 1), "img/invisProf.png", alignment, false);
+			MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(r + 1), "", "img/invisProf.png");
 		}
 	}
 }
@@ -240,7 +238,7 @@ void ConnectPageArea::showMessagesReceived() {
 * scrolling in other function possible
 */
 void ConnectPageArea::showMessagesSend() {
-	if (TwitterApp::getInstance()->hasConnection()) {
+	if (TwitterApp::getInstance()->hasConnection() && content.IsArray()) {
 		eyegui::setElementActivity(pLayout, "receivedButton", true);
 		eyegui::setElementActivity(pLayout, "sentButton", false);
 		counter = 0;
@@ -253,32 +251,14 @@ void ConnectPageArea::showMessagesSend() {
 			date = date.substr(0, date.size() - 10);
 			eyegui::setContentOfTextBlock(pLayout, textboxes[(i - index)], temp1 + content[i]["recipient"]["name"].GetString() + temp2 + content[i]["recipient"]["screen_name"].GetString() + temp + date + temp + content[i]["text"].GetString());
 
-			// Download avatar image:
-			std::string str = content[i]["recipient"]["profile_image_url"].GetString();
-
-			// Extract file extension
-			size_t z = str.rfind('.', str.length());
-			std::string ext = str.substr(z + 1, str.length() - z);
-
-			// Set filename using this rule: profile_ + Profile ID + extension
-			std::string filename = "img/tmp/profile_" + std::string(content[i]["recipient"]["id_str"].GetString()) + "." + ext;
-
-			// Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-			int indexStr = str.find("_normal.");
-			str = str.replace(indexStr, 8, "_400x400.");
-
-			std::string path = CONTENT_PATH + std::string("/") + filename;
-			download_image((char*)str.c_str(), (char*)path.c_str());
-
-			eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-			eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(i - index + 1), filename, alignment, false);
+			// Show avatar image, placeholder until it is loaded
+			MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(i - index + 1), MediaLoader::avatarUrl(content[i]["recipient"]["profile_image_url"].GetString()), "img/profile_default.png");
 		}
 		std::string fillUp = " ";
 		for (int r = counter; r < 4; r++)
 		{
 			eyegui::setContentOfTextBlock(pLayout, textboxes[(r)], fillUp);
-			eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-			eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(r + 1), "img/invisProf.png", alignment, false);
+			MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(r + 1), "", "img/invisProf.png");
 		}
 	}
 }
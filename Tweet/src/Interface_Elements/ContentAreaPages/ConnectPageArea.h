@@ -30,6 +30,7 @@ private:
     void showMessagesSend();
     void showMessagesReceived();
     rapidjson::Document content;
+    int messagesRequest = 0; // replies to older requests of messages are dropped
     std::string currentlySelected = "none";
     std::string textboxes[4] = {
         "textBlock1_1",
@@ -4,8 +4,9 @@
 
 #include "DiscoverPageArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include <string>
+#include <memory>
 #include <stdlib.h>
 #include <time.h>
 
@@ -70,28 +71,65 @@ void DiscoverPageArea::hide() {
 /**
 * updateDiscoveryChannel function
 * loads new suggestions from Twitter and updates a rapidjson::Document
+* trends and suggestions are requested at the same time and shown when both have arrived
 */
 void DiscoverPageArea::updateDiscoveryChannel() {
 
     if (TwitterApp::getInstance()->hasConnection()) {
-    content = TwitterApp::getInstance()->getTwitter()->getCurrentTrends();
-
-    rapidjson::Document jObj2 = TwitterApp::getInstance()->getTwitter()->suggestionsGetSlugs("de");
-
-    int iSecret = rand() % jObj2.Size();
-
-    suggestions = TwitterApp::getInstance()->getTwitter()->suggestionsGet(jObj2[iSecret]["slug"].GetString(), "de");
-
-    showDiscoveryChannel();
+    struct Replies {
+        rapidjson::Document trends;
+        rapidjson::Document suggestions;
+        int count = 0;
+    };
+    std::shared_ptr<Replies> spReplies = std::make_shared<Replies>();
+    const int request = ++discoveryRequest;
+
+    auto finish = [this, request, spReplies]() {
+        if (++spReplies->count < 2 || request != discoveryRequest) return;
+        content = std::move(spReplies->trends);
+        suggestions = std::move(spReplies->suggestions);
+        if (!hasContent()) {
+            std::cout << "Couldnt get discovery channel from twitter!" << std::endl;
+            return;
+        }
+        if (active)
+        {
+            showDiscoveryChannel();
+        }
+    };
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [](Twitter& rTwitter) { return rTwitter.getCurrentTrends(); },
+        [spReplies, finish](rapidjson::Document& rReply) { spReplies->trends = std::move(rReply); finish(); });
+
+    // Slug of suggestions is chosen on the worker, so both requests of the suggestions run there
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [](Twitter& rTwitter) -> rapidjson::Document {
+            rapidjson::Document jObj2 = rTwitter.suggestionsGetSlugs("de");
+            if (!jObj2.IsArray() || jObj2.Empty()) return jObj2;
+            int iSecret = rand() % jObj2.Size();
+            return rTwitter.suggestionsGet(jObj2[iSecret]["slug"].GetString(), "de");
+        },
+        [spReplies, finish](rapidjson::Document& rReply) { spReplies->suggestions = std::move(rReply); finish(); });
     }
 }
 
+/**
+* hasContent function
+* checks if trends and enough suggestions have arrived from Twitter
+* @param[out] bool if both are available
+*/
+bool DiscoverPageArea::hasContent() {
+    return content.IsArray() && !content.Empty() && content[0].IsObject() && content[0].HasMember("trends")
+        && suggestions.IsObject() && suggestions.HasMember("users") && suggestions["users"].Size() > 3;
+}
+
 /**
 * showDiscoveryChannel function
 * loads Content of the DiscoverPageArea
 * Content shown  is Hashtags and 2 User Profiles
 */
 void DiscoverPageArea::showDiscoveryChannel() {
+    if (!hasContent()) return;
     for (rapidjson::SizeType i = 0; (i < content[0]["trends"].Size()) && (i < 4); i++) {
         eyegui::setContentOfTextBlock(pLayout, textboxes[i ], content[0]["trends"][i]["name"].GetString());
     }
@@ -105,65 +143,14 @@ void DiscoverPageArea::showDiscoveryChannel() {
     bool downloadImage = true;
 
     if (downloadImage) {
-        // Download avatar image:
-        std::string str = suggestions["users"][suggestionnmbr]["profile_image_url"].GetString();
-
-        // Extract file extension
-        size_t i = str.rfind('.', str.length());
-        std::string ext = str.substr(i + 1, str.length() - i);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(suggestions["users"][suggestionnmbr]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int index = str.find("_normal.");
-        str = str.replace(index, 8, "_400x400.");
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "picture1", MediaLoader::avatarUrl(suggestions["users"][suggestionnmbr]["profile_image_url"].GetString()), "img/profile_default.png");
 
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "picture2", MediaLoader::avatarUrl(suggestions["users"][suggestionnmbr+1]["profile_image_url"].GetString()), "img/profile_default.png");
 
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "picture1", filename, alignment, false);
-
-        // Download avatar image:
-        str = suggestions["users"][suggestionnmbr+1]["profile_image_url"].GetString();
-
-        // Extract file extension
-        i = str.rfind('.', str.length());
-        ext = str.substr(i + 1, str.length() - i);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        filename = "img/tmp/profile_" + std::string(suggestions["users"][suggestionnmbr+1]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        index = str.find("_normal.");
-        str = str.replace(index, 8, "_400x400.");
-
-        path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "picture2", filename, alignment, false);
-
-        // Download avatar image:
-        str = suggestions["users"][suggestionnmbr + 2]["profile_image_url"].GetString();
-
-        // Extract file extension
-        i = str.rfind('.', str.length());
-        ext = str.substr(i + 1, str.length() - i);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        filename = "img/tmp/profile_" + std::string(suggestions["users"][suggestionnmbr + 2]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        index = str.find("_normal.");
-        str = str.replace(index, 8, "_400x400.");
-
-        path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "picture3", filename, alignment, false);
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "picture3", MediaLoader::avatarUrl(suggestions["users"][suggestionnmbr + 2]["profile_image_url"].GetString()), "img/profile_default.png");
     }
 }
 
@@ -174,6 +161,11 @@ void DiscoverPageArea::showDiscoveryChannel() {
 * @param[in] id is ID of selected Contend
 */
 void DiscoverPageArea::selectTweet(std::string id) {
+    // Channel might not have arrived yet
+    if (id.compare("none") && !hasContent())
+    {
+        return;
+    }
     if (currentlySelected.compare(id))
     {
         if (id.compare("none"))
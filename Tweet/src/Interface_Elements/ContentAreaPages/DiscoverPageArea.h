@@ -23,8 +23,10 @@ public:
 
 private:
 
+    bool hasContent();
     std::string currentlySelected = "none";
     rapidjson::Document content;
+    int discoveryRequest = 0; // replies to older requests of the channel are dropped
     std::shared_ptr<DiscoverButton> discoverButtonListener = std::shared_ptr<DiscoverButton>(new DiscoverButton);
     int buttonFrames[7];
     int suggestionnmbr = 0;
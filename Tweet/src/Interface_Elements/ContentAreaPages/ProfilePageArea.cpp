@@ -4,8 +4,10 @@
 
 #include "ProfilePageArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include <string>
+#include <algorithm>
+#include <memory>
 
 /**
 * Constructor for the ProfilePageArea Class
@@ -143,6 +145,11 @@ std::string ProfilePageArea::getUserId() {
 */
 void ProfilePageArea::selectContent(std::string id) {
 
+    // Profile might not have arrived yet
+    if (id.compare("none") && !hasContent())
+    {
+        return;
+    }
     if (currentlySelected.compare(id))
     {
         if (currentlySelected.compare("none")&& currentlySelected.compare("0"))
@@ -216,23 +223,58 @@ void ProfilePageArea::selectContent(std::string id) {
 /**
 * updateTimeline function
 * loads tweets from Twitter of the users timeline
+* timeline and user are requested at the same time and shown when both have arrived
 * @param[in] reset if true timeline will be reset to 0 tweets
 */
 void ProfilePageArea::updateTimeline(bool reset) {
     if (TwitterApp::getInstance()->hasConnection()) {
-        tweetcontents = (TwitterApp::getInstance()->getTwitter()->getTimelineUser(true, true, 21, currentProfile, true));
-        usercontents = (TwitterApp::getInstance()->getTwitter()->showUser(currentProfile, true));
-        if (tweetcontents.Size() < 3) {
-            std::cout << "Couldnt get 3 Tweets from twitter!" << std::endl;
-        }
-        if (reset)
-        {
-            tweetIndex = 0;
-        }
-        showCurrentProfile();
+        struct Replies {
+            rapidjson::Document tweets;
+            rapidjson::Document user;
+            int count = 0;
+        };
+        std::shared_ptr<Replies> spReplies = std::make_shared<Replies>();
+        const int request = ++profileRequest;
+        const std::string profile = currentProfile;
+
+        auto finish = [this, request, reset, spReplies]() {
+            if (++spReplies->count < 2 || request != profileRequest) return;
+            if (!spReplies->tweets.IsArray() || !spReplies->user.IsObject()) {
+                std::cout << "Couldnt get profile from twitter!" << std::endl;
+                return;
+            }
+            tweetcontents = std::move(spReplies->tweets);
+            usercontents = std::move(spReplies->user);
+            if (tweetcontents.Size() < 3) {
+                std::cout << "Couldnt get 3 Tweets from twitter!" << std::endl;
+            }
+            if (reset)
+            {
+                tweetIndex = 0;
+            }
+            if (active)
+            {
+                showCurrentProfile();
+            }
+        };
+        TwitterApp::getInstance()->getAsyncTwitter()->request(
+            [profile](Twitter& rTwitter) { return rTwitter.getTimelineUser(true, true, 21, profile, true); },
+            [spReplies, finish](rapidjson::Document& rReply) { spReplies->tweets = std::move(rReply); finish(); });
+        TwitterApp::getInstance()->getAsyncTwitter()->request(
+            [profile](Twitter& rTwitter) { return rTwitter.showUser(profile, true); },
+            [spReplies, finish](rapidjson::Document& rReply) { spReplies->user = std::move(rReply); finish(); });
     }
 }
 
+/**
+* hasContent function
+* checks if timeline and user have arrived from Twitter
+* @param[out] bool if both are available
+*/
+bool ProfilePageArea::hasContent() {
+    return tweetcontents.IsArray() && usercontents.IsObject();
+}
+
 /**
 * showCurrentProfile function
 * shows Content of the ProfilePageArea
@@ -240,32 +282,16 @@ void ProfilePageArea::updateTimeline(bool reset) {
 * shows the users Profile
 */
 void ProfilePageArea::showCurrentProfile() {
+    if (!hasContent()) return;
     bool downloadImage = true ;
     if (downloadImage) {
-        // Download avatar image:
-        std::string str = usercontents["profile_image_url"].GetString();
-
-        // Extract file extension
-        size_t i = str.rfind('.', str.length());
-        std::string ext = str.substr(i + 1, str.length() - i);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(usercontents["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int index = str.find("_normal.");
-        str = str.replace(index, 8, "_400x400.");
-
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic", filename, alignment, false);
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic", MediaLoader::avatarUrl(usercontents["profile_image_url"].GetString()), "img/profile_default.png");
     }
     std::string temp = " @";
     eyegui::setContentOfTextBlock(pLayout, "toTheTopButton", usercontents["name"].GetString() + temp + usercontents["screen_name"].GetString());
 
-    eyegui::setContentOfTextBlock(pLayout, textboxes[1], to_string(usercontents["statuses_count"].GetInt()));
+    eyegui::setContentOfTextBlock(pLayout, textboxes[1], std::to_string(usercontents["statuses_count"].GetInt()));
     eyegui::setContentOfTextBlock(pLayout, textboxes[2], std::to_string(usercontents["followers_count"].GetInt()));
     eyegui::setContentOfTextBlock(pLayout,"textBlock1_4", usercontents["description"].GetString());
     for (rapidjson::SizeType i = tweetIndex; (i <tweetcontents.Size()) && (i<tweetIndex + 3); i++) {
@@ -281,12 +307,13 @@ void ProfilePageArea::showCurrentProfile() {
 * @param[in] i is the int for how much will be scrolled
 */
 void ProfilePageArea::scrollUp(int i) {
+    if (!hasContent()) return;
     if (tweetIndex + 3 + i <tweetcontents.Size())
     {
         tweetIndex += i;
     }
     else {
-        tweetIndex = tweetcontents.Size() - 3;
+        tweetIndex = std::max(0, (int)tweetcontents.Size() - 3);
     }
     showCurrentProfile();
 }
@@ -32,10 +32,12 @@ private:
     bool getTweetFavorited();
     bool getTweetRetweeted();
     bool getTweetOwned();
+    bool hasContent();
     std::shared_ptr<ProfileButton> profileButtonListener = std::shared_ptr<ProfileButton>(new ProfileButton);
     rapidjson::Document tweetcontents;
     rapidjson::Document usercontents;
     std::string currentProfile;
+    int profileRequest = 0; // replies to older requests of a profile are dropped
     int buttonFrames[4];
     int textFrames[4];
     std::string textboxes[12] = { "textBlock1_1","textBlock1_2","textBlock1_3",
@@ -4,8 +4,9 @@
 
 #include "SearchPageArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include <string>
+#include <algorithm>
 
 /**
 * Constructor for the SearchPageArea Class
@@ -225,6 +226,7 @@ void SearchPageArea::manageSearchButtons() {
 */
 void SearchPageArea::scrollUp(int i) {
     selectContent("none");
+    if (!contentExists) return;
     int size;
     if (currentcontisuser)
     {
@@ -238,7 +240,7 @@ void SearchPageArea::scrollUp(int i) {
         index += i;
     }
     else {
-        index = size - 4;
+        index = std::max(0, size - 4);
     }
     if (currentcontisuser)
     {
@@ -248,6 +250,7 @@ void SearchPageArea::scrollUp(int i) {
     else {
 
         showTweets();
+        requestOlderResults();
     }
 }
 
@@ -279,28 +282,96 @@ void SearchPageArea::scrollDown(int i) {
 /**
 * search function
 * functions searches after content in twitter with a searchWord
+* results are shown when they arrive, the next page of tweets is loaded ahead
 */
 void SearchPageArea::search() {
     selectContent("none");
     index = 0;
     if (searchWord=="") return;
     if (TwitterApp::getInstance()->hasConnection()) {
+        const int request = ++searchRequest;
+        const std::string word = searchWord;
+        const std::string count = std::to_string(SEARCH_COUNT);
+        olderRequested = false;
+        searchComplete = false;
         if (userSearch)
         {
-            content = TwitterApp::getInstance()->getTwitter()->userSearch(searchWord, "80");
-            contentExists = true;
-            currentcontisuser = true;
-            showUsers();
+            TwitterApp::getInstance()->getAsyncTwitter()->request(
+                [word, count](Twitter& rTwitter) { return rTwitter.userSearch(word, count); },
+                [this, request, word](rapidjson::Document& rReply) {
+                    if (request != searchRequest || !rReply.IsArray()) return;
+                    content = std::move(rReply);
+                    searchedWord = word;
+                    index = 0;
+                    contentExists = true;
+                    currentcontisuser = true;
+                    if (active)
+                    {
+                        showUsers();
+                    }
+                });
         }
         else {
-            content = TwitterApp::getInstance()->getTwitter()->search(searchWord, "80");
-            contentExists = true;
-            currentcontisuser = false;
-            showTweets();
+            TwitterApp::getInstance()->getAsyncTwitter()->request(
+                [word, count](Twitter& rTwitter) { return rTwitter.search(word, count); },
+                [this, request, word](rapidjson::Document& rReply) {
+                    if (request != searchRequest || !rReply.IsObject() || !rReply.HasMember("statuses") || !rReply["statuses"].IsArray()) return;
+                    content = std::move(rReply);
+                    searchedWord = word;
+                    index = 0;
+                    contentExists = true;
+                    currentcontisuser = false;
+                    if (active)
+                    {
+                        showTweets();
+                    }
+                    requestOlderResults();
+                });
         }
     }
 }
 
+/**
+* requestOlderResults function
+* Loads the page of tweets following the found ones, as soon as less than a page is left to scroll
+* so scrolling never waits for Twitter
+*/
+void SearchPageArea::requestOlderResults() {
+    if (olderRequested || searchComplete || !contentExists || currentcontisuser) return;
+    const rapidjson::Value& rStatuses = content["statuses"];
+    if (rStatuses.Empty() || (int)rStatuses.Size() - (index + 4) >= SEARCH_COUNT) return;
+    const std::string maxId = AsyncTwitter::olderThan(rStatuses[rStatuses.Size() - 1]["id_str"].GetString());
+    if (maxId.empty()) return;
+
+    const int request = searchRequest;
+    const std::string word = searchedWord;
+    const std::string count = std::to_string(SEARCH_COUNT);
+    olderRequested = true;
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [word, count, maxId](Twitter& rTwitter) { return rTwitter.search(word, count, maxId); },
+        [this, request](rapidjson::Document& rReply) {
+            if (request != searchRequest) return;
+            olderRequested = false;
+            if (!rReply.IsObject() || !rReply.HasMember("statuses") || !rReply["statuses"].IsArray()) return; // tried again at next scrolling
+            rapidjson::Value& rOlder = rReply["statuses"];
+            if (rOlder.Empty()) {
+                searchComplete = true;
+                return;
+            }
+
+            // Copy tweets, since reply owns its memory
+            rapidjson::Value& rStatuses = content["statuses"];
+            const bool atEnd = index + 4 > (int)rStatuses.Size();
+            for (rapidjson::SizeType i = 0; i < rOlder.Size(); i++) {
+                rStatuses.PushBack(rapidjson::Value(rOlder[i], content.GetAllocator()), content.GetAllocator());
+            }
+            if (active && atEnd)
+            {
+                showTweets();
+            }
+        });
+}
+
 /**
 * showTweets function
 * shows Content of the SearchPageArea
@@ -315,25 +386,8 @@ void SearchPageArea::showTweets() {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - index) + 2], "Likes: " + std::to_string(content["statuses"][i]["favorite_count"].GetInt()));
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - index) + 3], "Retweets: " + std::to_string(content["statuses"][i]["retweet_count"].GetInt()));
 
-        // Download avatar image:
-        std::string str = content["statuses"][i]["user"]["profile_image_url"].GetString();
-
-            // Extract file extension
-            size_t z = str.rfind('.', str.length());
-        std::string ext = str.substr(z + 1, str.length() - z);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(content["statuses"][i]["user"]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int indexStr = str.find("_normal.");
-        str = str.replace(indexStr, 8, "_400x400.");
-
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(i - index + 1), filename, alignment, false);
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(i - index + 1), MediaLoader::avatarUrl(content["statuses"][i]["user"]["profile_image_url"].GetString()), "img/profile_default.png");
 
 
     }
@@ -344,8 +398,7 @@ void SearchPageArea::showTweets() {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r) + 1], fillUp);
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r)+2], fillUp);
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r) + 3], fillUp);
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(r + 1), "img/invisProf.png", alignment, false);
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(r + 1), "", "img/invisProf.png");
     }
 }
 
@@ -364,25 +417,8 @@ void SearchPageArea::showUsers() {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - index) + 3], std::to_string(content[i]["followers_count"].GetInt()));
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - index) + 1], content[i]["screen_name"].GetString() +temp2+ content[i]["name"].GetString()+temp+content[i]["description"].GetString());
 
-        // Download avatar image:
-        std::string str = content[i]["profile_image_url"].GetString();
-
-        // Extract file extension
-        size_t z = str.rfind('.', str.length());
-        std::string ext = str.substr(z + 1, str.length() - z);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(content[i]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int indexStr = str.find("_normal.");
-        str = str.replace(indexStr, 8, "_400x400.");
-
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(i - index + 1), filename, alignment, false);
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(i - index + 1), MediaLoader::avatarUrl(content[i]["profile_image_url"].GetString()), "img/profile_default.png");
 
     }
     std::string fillUp = " ";
@@ -392,8 +428,7 @@ void SearchPageArea::showUsers() {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r)+1], fillUp);
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r)+2], fillUp);
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (r)+3], fillUp);
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic" + std::to_string(r + 1), "img/invisProf.png", alignment, false);
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic" + std::to_string(r + 1), "", "img/invisProf.png");
     }
 }
 
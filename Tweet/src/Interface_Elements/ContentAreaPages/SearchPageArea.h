@@ -37,7 +37,13 @@ private:
     std::string searchWord = "look here to type!";
     bool contentExists = false;
     void manageSearchButtons();
+    void requestOlderResults();
     rapidjson::Document content;
+    std::string searchedWord; // of content
+    int searchRequest = 0; // replies to older searches are dropped
+    bool olderRequested = false;
+    bool searchComplete = false; // no older tweets left
+    static const int SEARCH_COUNT = 80; // results per page
     bool currentcontisuser = false;
     std::string currentlySelected = "none";
     std::string textboxes[13] = { "searchText",
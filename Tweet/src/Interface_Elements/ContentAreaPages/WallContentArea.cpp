@@ -4,8 +4,9 @@
 
 #include "WallContentArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include <string>
+#include <algorithm>
 
 /**
 * Constructor for the WallContentArea Class
@@ -51,40 +52,136 @@ void WallContentArea::hide() {
 
 /**
 * updateNewsFeed function
-* updates timeline of user over Twitter
+* updates timeline of user over Twitter in the background
+* known tweets are shown until the reply arrives, older pages are kept if the first page overlaps them
 * @param[in] bool if the Tweetindex should be reseted to 0
 */
 void WallContentArea::updateNewsFeed(bool reset) {
 
     if (TwitterApp::getInstance()->hasConnection()) {
-        content = (TwitterApp::getInstance()->getTwitter()->getTimelineHome(""));
-
-
-        if (content.Size() < 4) {
-            std::cout << "Couldnt get 4 Tweets from twitter!" << std::endl;
-        }
         if (reset)
         {
             tweetIndex = 0;
+            if (active)
+            {
+                showTweets();
+            }
         }
-        showTweets();
+
+        const int request = ++feedRequest;
+        olderRequested = false;
+        TwitterApp::getInstance()->getAsyncTwitter()->request(
+            [](Twitter& rTwitter) { return rTwitter.getTimelineHome(""); },
+            [this, request, reset](rapidjson::Document& rReply) {
+                if (request != feedRequest) return;
+                if (!rReply.IsArray()) {
+                    std::cout << "Couldnt get Tweets from twitter!" << std::endl;
+                    return;
+                }
+                if (rReply.Size() < 4) {
+                    std::cout << "Couldnt get 4 Tweets from twitter!" << std::endl;
+                }
+
+                // Remember shown tweet, so it stays in view when newer tweets are inserted above
+                std::string shownId;
+                if (!reset && content.IsArray() && tweetIndex < (int)content.Size())
+                    shownId = content[tweetIndex]["id_str"].GetString();
+
+                // Known tweets older than the first page are kept, if the page overlaps them.
+                // Otherwise there is a gap and older pages are loaded again by prefetching
+                int overlap = -1;
+                if (content.IsArray() && !rReply.Empty()) {
+                    const std::string lastId = rReply[rReply.Size() - 1]["id_str"].GetString();
+                    for (rapidjson::SizeType i = 0; i < content.Size() && overlap < 0; i++) {
+                        if (lastId == content[i]["id_str"].GetString())
+                            overlap = (int)i;
+                    }
+                }
+                if (overlap >= 0) {
+                    for (rapidjson::SizeType i = (rapidjson::SizeType)overlap + 1; i < content.Size(); i++) {
+                        rReply.PushBack(rapidjson::Value(content[i], rReply.GetAllocator()), rReply.GetAllocator());
+                    }
+                }
+                else {
+                    feedComplete = false;
+                }
+                content = std::move(rReply);
+
+                // Keep position of shown tweet or clamp index to known tweets
+                if (reset) {
+                    tweetIndex = 0;
+                }
+                else if (!shownId.empty()) {
+                    for (rapidjson::SizeType i = 0; i < content.Size(); i++) {
+                        if (shownId == content[i]["id_str"].GetString()) {
+                            tweetIndex = (int)i;
+                            break;
+                        }
+                    }
+                }
+                tweetIndex = std::max(0, std::min(tweetIndex, (int)content.Size() - 4));
+                if (active)
+                {
+                    showTweets();
+                }
+                requestOlderTweets();
+            });
     }
 }
 
+/**
+* requestOlderTweets function
+* Loads the page of tweets following the known ones, as soon as less than a page is left to scroll
+* so scrolling never waits for Twitter
+*/
+void WallContentArea::requestOlderTweets() {
+    if (olderRequested || feedComplete || !content.IsArray() || content.Empty()) return;
+    if ((int)content.Size() - (tweetIndex + 4) >= PREFETCH_TWEETS) return;
+    const std::string maxId = AsyncTwitter::olderThan(content[content.Size() - 1]["id_str"].GetString());
+    if (maxId.empty()) return;
+
+    const int request = feedRequest;
+    olderRequested = true;
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [maxId](Twitter& rTwitter) { return rTwitter.getTimelineHome("", maxId); },
+        [this, request](rapidjson::Document& rReply) {
+            if (request != feedRequest) return;
+            olderRequested = false;
+            if (!rReply.IsArray()) return; // tried again at next scrolling
+            if (rReply.Empty()) {
+                feedComplete = true;
+                return;
+            }
+
+            // Copy tweets, since reply owns its memory
+            const bool atEnd = tweetIndex + 4 > (int)content.Size();
+            for (rapidjson::SizeType i = 0; i < rReply.Size(); i++) {
+                content.PushBack(rapidjson::Value(rReply[i], content.GetAllocator()), content.GetAllocator());
+            }
+            if (active && atEnd)
+            {
+                showTweets();
+            }
+            requestOlderTweets();
+        });
+}
+
 /**
 * scrollUp function
 * Scroll the shown conten up on the basis of an int
 * @param[in] i is the int for how much will be scrolled
 */
 void WallContentArea::scrollUp(int i) {
+    if (!content.IsArray()) return;
     if (tweetIndex + 4+i <content.Size())
     {
         tweetIndex += i;
     }
     else {
-        tweetIndex = content.Size() - 4;
+        tweetIndex = std::max(0, (int)content.Size() - 4);
     }
     showTweets();
+    requestOlderTweets();
 }
 
 /**
@@ -162,6 +259,7 @@ bool WallContentArea::getRetweetedAt(int i) {
 * shows the the tweets wich where found
 */
 void WallContentArea::showTweets() {
+    if (!content.IsArray()) return;
     std::string temp = "\n";
     for (rapidjson::SizeType i = tweetIndex; (i < content.Size()) && (i < tweetIndex + 4); i++) {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i-tweetIndex)], content[i]["user"]["name"].GetString()+temp+content[i]["text"].GetString());
@@ -173,25 +271,8 @@ void WallContentArea::showTweets() {
 		}
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - tweetIndex) + 2], "Retweets: " + std::to_string(content[i]["retweet_count"].GetInt()));
 
-        // Download avatar image:
-        std::string str = content[i]["user"]["profile_image_url"].GetString();
-
-        // Extract file extension
-        size_t z = str.rfind('.', str.length());
-        std::string ext = str.substr(z + 1, str.length() - z);
-
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(content[i]["user"]["id_str"].GetString()) + "." + ext;
-
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int index = str.find("_normal.");
-        str = str.replace(index, 8, "_400x400.");
-
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic"+std::to_string(i - tweetIndex+1), filename, alignment, false);
+        // Show avatar image, placeholder until it is loaded
+        MediaLoader::getInstance()->showPicture(pLayout, "profilePic"+std::to_string(i - tweetIndex+1), MediaLoader::avatarUrl(content[i]["user"]["profile_image_url"].GetString()), "img/profile_default.png");
     }
 }
 
@@ -203,6 +284,11 @@ void WallContentArea::showTweets() {
 * @param[in] id of the Selected tweet
 */
 void WallContentArea::selectTweet(std::string id) {
+        // Tweets might not have arrived yet
+        if (id.compare("none") && (!content.IsArray() || stoi(id) + tweetIndex >= (int)content.Size()))
+        {
+            return;
+        }
         if (currentlySelected.compare(id))
         {
             if (currentlySelected.compare("none"))
@@ -31,9 +31,14 @@ private:
     bool getLikedAt(int i);
     bool getRetweetedAt(int i);
     bool getOwnAt(int i);
+    void requestOlderTweets();
     std::string currentlySelected = "none";
     std::shared_ptr<WallButton> wallButtonListener = std::shared_ptr<WallButton>(new WallButton);
     rapidjson::Document content;
+    int feedRequest = 0; // replies to older requests of the news feed are dropped
+    bool olderRequested = false;
+    bool feedComplete = false; // no older tweets left
+    static const int PREFETCH_TWEETS = 20; // about one page of the home timeline
     int buttonFrames[4];
     int textFrames[4];
     std::string textboxes[12] = {	"textBlock1_1","textBlock1_2","textBlock1_3",
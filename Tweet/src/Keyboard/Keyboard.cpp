@@ -121,10 +121,13 @@ void Keyboard::init() {
 /**
 * tweet function of Twitterap
 * Tweeting string variable "ausgabe" through TwitterApp
+* The wall is updated when Twitter has accepted the tweet
 */
 void Keyboard::tweet() {
-    TwitterApp::getInstance()->getTwitter()->statusUpdate(ausgabe);
-    TwitterApp::getInstance()->wallContentArea->updateNewsFeed(true);
+    std::string text = ausgabe;
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [text](Twitter& rTwitter) { return rTwitter.statusUpdate(text); },
+        [](rapidjson::Document&) { TwitterApp::getInstance()->wallContentArea->updateNewsFeed(true); });
     abort();
 }
 
@@ -134,8 +137,11 @@ void Keyboard::tweet() {
 */
 void Keyboard::respond() {
     //std::cout << tweetid << std::endl;
-    TwitterApp::getInstance()->getTwitter()->reply(ausgabe, tweetid);
-    TwitterApp::getInstance()->wallContentArea->updateNewsFeed(false);
+    std::string text = ausgabe;
+    std::string id = tweetid;
+    TwitterApp::getInstance()->getAsyncTwitter()->request(
+        [text, id](Twitter& rTwitter) { return rTwitter.reply(text, id); },
+        [](rapidjson::Document&) { TwitterApp::getInstance()->wallContentArea->updateNewsFeed(false); });
     abort();
 }
 
@@ -296,8 +302,8 @@ void Keyboard::write3(std::string key){
         else {
           if(key.size() ==2 && (key.at(0) &  0b11100000) ==  0b11000000 	// Next byte will be multibyte char; move two spaces
              && (key.at(1) & 0b11000000) == 0b10000000){
-            cout << "multibyte with size" << ausgabe.size()<< endl;
-            cout << "currentCursorPos" << currentCursorPos << endl;
+            std::cout << "multibyte with size" << ausgabe.size()<< std::endl;
+            std::cout << "currentCursorPos" << currentCursorPos << std::endl;
             insertCursorAndDisplayText(2);
 
           }
@@ -580,7 +586,7 @@ Todo
 */
 void Keyboard::showWordComp() {
 
-    v = trie.autocomplete(tempWord);
+    v = trie.complete(tempWord, WcountMax);
 
     if (v.size() >= 3) {
         Wcount = 3;
@@ -660,7 +666,7 @@ std::string Keyboard::replaceChar2(std::string Word) {
     for (int i = 0; i < Word.length(); ++i)
     {
         // Current char
-        string key2(1, Word[i]);
+        std::string key2(1, Word[i]);
 
         // Chars not included in Eye-Gui, result in error. if clausel should chatch execptions
         if (key2 == "") {
@@ -784,7 +790,7 @@ std::string Keyboard::replaceChar3(std::string Word) {
     for (int i = 0; i < Word.length(); ++i)
     {
         // Current char
-        string key2(1, Word[i]);
+        std::string key2(1, Word[i]);
         std::cout << "'Schleife der ReplaceChar3  " << tempWord2 << std::endl;
         // Chars not included in Eye-Gui, result in error. if clausel should chatch execptions
         if (key2 == u8"") {
@@ -866,7 +872,7 @@ void Keyboard::writeWordComp(int Wordcase){
 
         for (char& c : word1) {
             //write2(c);
-            string s(1, c);
+            std::string s(1, c);
             write3(s);
         }
         write3(" ");
@@ -882,7 +888,7 @@ void Keyboard::writeWordComp(int Wordcase){
         }
         for (char& c : word2) {
 
-            string s(1, c);
+            std::string s(1, c);
             write3(s);
         }
         write3(" ");
@@ -898,7 +904,7 @@ void Keyboard::writeWordComp(int Wordcase){
         }
         for (char& c : word3) {
 
-            string s(1, c);
+            std::string s(1, c);
             write3(s);
         }
         write3(" ");
@@ -925,7 +931,7 @@ void Keyboard::addTexttoClipboard() {
 */
 void Keyboard::addClipboardtoOut() {
     if (clipboard.length() > 0) {
-        string s{};
+        std::string s{};
         for (char& c : clipboard) {
             s.push_back(c);
             write3(s);
@@ -938,16 +944,16 @@ void Keyboard::addClipboardtoOut() {
 * Function adds ausgabe as a new line to the Dictionary
 */
 void Keyboard::addLinetoDict() {
-    trie.addLinetoDict(dict,ausgabe);
+    RankedTrie::addLinetoDict(dict, ausgabe);
+    trie.insert(ausgabe);
 }
 
 /**
 * Function deletes ausgabe line from the Dictionary, if posssible
 */
 void Keyboard::deleteLineinDict() {
-    trie.deleteLineinDict(dict, ausgabe);
-    trie = Trie("");
-    trie.loadDict(dict);
+    RankedTrie::deleteLineinDict(dict, ausgabe);
+    trie.remove(ausgabe);
 
     ausgabe = "";
     currentCursorPos = 0;
@@ -988,19 +994,18 @@ void Keyboard::clearInput() {
 */
 void Keyboard::changeDict(int lang) {
     if (lang == 0) {
-        dict = "../src/Keyboard/eng.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "eng.txt";
     }
     if (lang == 1) {
-        dict = "../src/Keyboard/ger.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "ger.txt";
     }
     if (lang == 2) {
-        dict = "../src/Keyboard/french.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "french.txt";
     }
     if (lang == 3) {
-        dict = "../src/Keyboard/dutch.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "dutch.txt";
     }
 
-    trie = Trie("");
     trie.loadDict(dict);
 
     tempWord = " ";
@@ -1012,7 +1017,7 @@ void Keyboard::changeDict(int lang) {
     eyegui::setContentOfTextBlock(pLayout2, "Word2", "");
     eyegui::setContentOfTextBlock(pLayout2, "Word3", "");
 
-    v = trie.autocomplete(tempWord);
+    v = trie.complete(tempWord, WcountMax);
 
     // Bug: has some problems with the first char after loading new Dictionary
     // so we write one char and delete it
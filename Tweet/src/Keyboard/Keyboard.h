@@ -6,7 +6,7 @@
 
 #include "externals/eyeGUI-development/include/eyeGUI.h"
 #include "src/Buttons/KeyboardButton.h"
-#include "externals/Trie/trie.h"
+#include "src/Keyboard/RankedTrie.h"
 #include <vector>
 #include <iostream>
 
@@ -79,7 +79,8 @@ public:
     int Wcount;
     std::string  tempWord, word1, word2, word3,dict;
     std::vector<std::string> v;
-    Trie trie = Trie("");
+    size_t WcountMax = 30; // maximal count of completions offered for one prefix
+    RankedTrie trie;
 
     // Test login
     void setPLayout(eyegui::Layout* newLayout) { this->pLayout = newLayout; }
@@ -0,0 +1,329 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#include "RankedTrie.h"
+#include <queue>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstdio>
+
+// Header of binary file. Nodes follow directly, in the layout they have in memory
+namespace {
+    const uint32_t BINARY_MAGIC = 0x45495254; // "TRIE"
+    const uint32_t BINARY_VERSION = 2;
+
+    struct BinaryHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t sourceSize; // size of text dictionary the binary was built from
+        uint64_t sourceHash; // FNV-1a hash of content of that text dictionary
+        int32_t nextRank;
+        uint32_t wordCount;
+        uint32_t nodeCount;
+        uint32_t reserved;
+    };
+
+    // Size of file in bytes and FNV-1a hash of its content. Size is zero if it cannot be opened
+    uint64_t fileDigest(const std::string& path, uint64_t& hash) {
+        hash = 14695981039346656037ULL;
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+            return 0;
+        uint64_t size = 0;
+        std::vector<char> buffer(1 << 16);
+        while (file.read(buffer.data(), (std::streamsize)buffer.size()) || file.gcount() > 0) {
+            const std::streamsize count = file.gcount();
+            for (std::streamsize i = 0; i < count; i++) {
+                hash ^= (unsigned char)buffer[(size_t)i];
+                hash *= 1099511628211ULL;
+            }
+            size += (uint64_t)count;
+        }
+        return size;
+    }
+}
+
+/**
+* Constructor of the RankedTrie
+* Creates an empty index
+*/
+RankedTrie::RankedTrie() {
+    clear();
+}
+
+/**
+* Removes all words
+*/
+void RankedTrie::clear() {
+    Node root = { NO_NODE, NO_NODE, NO_NODE, 0, NO_RANK, NO_RANK };
+    nodes.assign(1, root);
+    nextRank = 0;
+    wordCount = 0;
+}
+
+/**
+* Adds word with a rank behind all other words, like a new line in the dictionary
+* @param[in] word variable used for the insert
+*/
+bool RankedTrie::insert(const std::string& word) {
+    return insert(word, nextRank);
+}
+
+/**
+* Adds word or improves its rank. Lower rank is offered first
+* @param[in] word variable used for the insert
+* @param[in] rank variable decides about order of completions
+*/
+bool RankedTrie::insert(const std::string& word, int32_t rank) {
+    if (word.empty() || rank < 0 || rank == NO_RANK)
+        return false;
+
+    int32_t node = 0;
+    for (size_t i = 0; i < word.length(); i++) {
+        const unsigned char label = (unsigned char)word[i];
+
+        // Find position in sorted list of siblings
+        int32_t previous = NO_NODE;
+        int32_t child = nodes[node].firstChild;
+        while (child != NO_NODE && nodes[child].label < label) {
+            previous = child;
+            child = nodes[child].nextSibling;
+        }
+
+        // Add child if not existing
+        if (child == NO_NODE || nodes[child].label != label) {
+            Node added = { NO_NODE, child, node, label, NO_RANK, NO_RANK };
+            nodes.push_back(added);
+            const int32_t index = (int32_t)nodes.size() - 1;
+            if (previous == NO_NODE)
+                nodes[node].firstChild = index;
+            else
+                nodes[previous].nextSibling = index;
+            child = index;
+        }
+        node = child;
+    }
+
+    // Store rank, keep the better one if word is known already
+    if (nodes[node].rank == NO_RANK)
+        wordCount++;
+    else if (nodes[node].rank <= rank)
+        return true;
+    nodes[node].rank = rank;
+    nextRank = std::max(nextRank, rank + 1);
+
+    // Propagate rank towards root as long as it improves subtrees
+    for (int32_t n = node; n != NO_NODE && rank < nodes[n].best; n = nodes[n].parent)
+        nodes[n].best = rank;
+    return true;
+}
+
+/**
+* Removes word. Nodes are kept, but skipped by completions
+* @param[in] word variable used for the removal
+*/
+bool RankedTrie::remove(const std::string& word) {
+    const int32_t node = findNode(word);
+    if (node == NO_NODE || node == 0 || nodes[node].rank == NO_RANK)
+        return false;
+    nodes[node].rank = NO_RANK;
+    wordCount--;
+
+    // Recompute best rank of subtrees towards root until it does not change
+    for (int32_t n = node; n != NO_NODE; n = nodes[n].parent) {
+        int32_t best = nodes[n].rank;
+        for (int32_t child = nodes[n].firstChild; child != NO_NODE; child = nodes[child].nextSibling)
+            best = std::min(best, nodes[child].best);
+        if (best == nodes[n].best)
+            break;
+        nodes[n].best = best;
+    }
+    return true;
+}
+
+/**
+* Checks whether word is in index
+* @param[in] word variable used for the search
+*/
+bool RankedTrie::contains(const std::string& word) const {
+    const int32_t node = findNode(word);
+    return node != NO_NODE && nodes[node].rank != NO_RANK;
+}
+
+/**
+* Searches best ranked words starting with prefix
+* Subtrees are visited in order of their best rank, so only paths to returned words are expanded
+* @param[in] prefix variable used for the search
+* @param[in] count variable is the maximal count of returned words
+*/
+std::vector<std::string> RankedTrie::complete(const std::string& prefix, size_t count) const {
+    std::vector<std::string> results;
+    const int32_t start = findNode(prefix);
+    if (start == NO_NODE || nodes[start].best == NO_RANK || count == 0)
+        return results;
+
+    // Entries are subtrees or words, ordered by rank. For words, node is stored as negative value minus one
+    typedef std::pair<int32_t, int32_t> Entry;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+    queue.push(Entry(nodes[start].best, start));
+    while (!queue.empty() && results.size() < count) {
+        const Entry entry = queue.top();
+        queue.pop();
+        if (entry.second < 0) {
+            results.push_back(wordOf(-entry.second - 1));
+            continue;
+        }
+        const Node& rNode = nodes[entry.second];
+        if (rNode.rank != NO_RANK)
+            queue.push(Entry(rNode.rank, -entry.second - 1));
+        for (int32_t child = rNode.firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+            if (nodes[child].best != NO_RANK)
+                queue.push(Entry(nodes[child].best, child));
+        }
+    }
+    return results;
+}
+
+/**
+* Loads dictionary via binary file next to it, which is rebuilt when the dictionary has changed
+* @param[in] dict variable is the Dictionary-Path
+*/
+bool RankedTrie::loadDict(const std::string& dict) {
+    uint64_t sourceHash;
+    const uint64_t sourceSize = fileDigest(dict, sourceHash);
+    const std::string binary = dict + ".trie";
+    if (sourceSize > 0 && loadBinary(binary, sourceSize, sourceHash))
+        return true;
+    if (!loadText(dict))
+        return false;
+    if (!saveBinary(binary, sourceSize, sourceHash))
+        std::cout << "Keyboard: Could not write binary Dictionary: " << binary << std::endl;
+    return true;
+}
+
+/**
+* Loads dictionary from text file with one word per line, most frequent first
+* @param[in] dict variable is the Dictionary-Path
+*/
+bool RankedTrie::loadText(const std::string& dict) {
+    clear();
+    std::cout << "Keyboard: Opening Dictionary: " << dict << std::endl;
+    std::ifstream inf(dict);
+    if (!inf.is_open() || inf.fail()) {
+        std::cout << "Error opening Dictionary file: " << dict << std::endl;
+        return false;
+    }
+    std::string word;
+    int32_t rank = 0;
+    while (getline(inf, word)) {
+        if (!word.empty() && word[word.length() - 1] == '\r')
+            word.erase(word.length() - 1);
+        if (!word.empty())
+            insert(word, rank++);
+    }
+    return true;
+}
+
+/**
+* Loads index from binary file. Fails if file was built from dictionary of other size or content
+* @param[in] path variable is the path of the binary file
+* @param[in] sourceSize variable is the size of the text dictionary
+* @param[in] sourceHash variable is the hash of the content of the text dictionary
+*/
+bool RankedTrie::loadBinary(const std::string& path, uint64_t sourceSize, uint64_t sourceHash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+        return false;
+    BinaryHeader header;
+    if (!in.read((char*)&header, sizeof(header))
+        || header.magic != BINARY_MAGIC
+        || header.version != BINARY_VERSION
+        || header.sourceSize != sourceSize
+        || header.sourceHash != sourceHash
+        || header.nodeCount == 0)
+        return false;
+
+    // Nodes are read as one block
+    std::vector<Node> loaded(header.nodeCount);
+    if (!in.read((char*)loaded.data(), (std::streamsize)(loaded.size() * sizeof(Node))))
+        return false;
+    nodes.swap(loaded);
+    nextRank = header.nextRank;
+    wordCount = header.wordCount;
+    return true;
+}
+
+/**
+* Saves index to binary file
+* @param[in] path variable is the path of the binary file
+* @param[in] sourceSize variable is the size of the text dictionary
+* @param[in] sourceHash variable is the hash of the content of the text dictionary
+*/
+bool RankedTrie::saveBinary(const std::string& path, uint64_t sourceSize, uint64_t sourceHash) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        return false;
+    BinaryHeader header = { BINARY_MAGIC, BINARY_VERSION, sourceSize, sourceHash, nextRank, (uint32_t)wordCount, (uint32_t)nodes.size(), 0 };
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)nodes.data(), (std::streamsize)(nodes.size() * sizeof(Node)));
+    return out.good();
+}
+
+/**
+* Adds line to the Dictionary file
+* @param[in] dict variable is the Dictionary-Path
+* @param[in] line variable is the String added to the Dictionary
+*/
+void RankedTrie::addLinetoDict(const std::string& dict, const std::string& line) {
+    std::ofstream out(dict, std::ios::app);
+    out << line + "\n";
+}
+
+/**
+* Deletes line from the Dictionary file
+* @param[in] dict variable is the Dictionary-Path
+* @param[in] line variable is the String which should be deleted in the Dictionary
+*/
+void RankedTrie::deleteLineinDict(const std::string& dict, const std::string& line) {
+    const std::string tempPath = dict + ".tmp";
+    {
+        std::ifstream dictionary(dict);
+        std::ofstream temp(tempPath);
+        std::string word;
+        while (getline(dictionary, word)) {
+            if (word != line)
+                temp << word + "\n";
+            else
+                std::cout << "Word == " + word + " == was deleted" << std::endl;
+        }
+    }
+    std::remove(dict.c_str());
+    std::rename(tempPath.c_str(), dict.c_str());
+}
+
+int32_t RankedTrie::findChild(int32_t node, unsigned char label) const {
+    for (int32_t child = nodes[node].firstChild; child != NO_NODE; child = nodes[child].nextSibling) {
+        if (nodes[child].label == label)
+            return child;
+        if (nodes[child].label > label)
+            break;
+    }
+    return NO_NODE;
+}
+
+int32_t RankedTrie::findNode(const std::string& prefix) const {
+    int32_t node = 0;
+    for (size_t i = 0; i < prefix.length() && node != NO_NODE; i++)
+        node = findChild(node, (unsigned char)prefix[i]);
+    return node;
+}
+
+std::string RankedTrie::wordOf(int32_t node) const {
+    std::string word;
+    for (int32_t n = node; n > 0; n = nodes[n].parent)
+        word.push_back((char)nodes[n].label);
+    std::reverse(word.begin(), word.end());
+    return word;
+}
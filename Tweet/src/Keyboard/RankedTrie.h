@@ -0,0 +1,61 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+// Prefix index for the word completion of the keyboard. Words are ranked by
+// their line in the dictionary, which lists most frequent words first. Nodes
+// are kept in one flat array without pointers, so that the index can be
+// written to and read from a binary file as a single block. Every node knows
+// the best rank within its subtree, so the best words for a prefix are found
+// without visiting the whole subtree.
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class RankedTrie {
+
+public:
+
+    RankedTrie();
+
+    void clear();
+    bool insert(const std::string& word);
+    bool insert(const std::string& word, int32_t rank);
+    bool remove(const std::string& word);
+    bool contains(const std::string& word) const;
+    std::vector<std::string> complete(const std::string& prefix, size_t count) const;
+    size_t size() const { return wordCount; }
+
+    bool loadDict(const std::string& dict);
+    bool loadText(const std::string& dict);
+    bool loadBinary(const std::string& path, uint64_t sourceSize, uint64_t sourceHash);
+    bool saveBinary(const std::string& path, uint64_t sourceSize, uint64_t sourceHash) const;
+
+    static void addLinetoDict(const std::string& dict, const std::string& line);
+    static void deleteLineinDict(const std::string& dict, const std::string& line);
+
+private:
+
+    // Node of trie. Children of a node are a list of siblings sorted by label
+    struct Node {
+        int32_t firstChild;
+        int32_t nextSibling;
+        int32_t parent;
+        int32_t label; // unsigned char
+        int32_t rank; // NO_RANK if node does not end a word
+        int32_t best; // best rank in subtree including node itself
+    };
+
+    static const int32_t NO_NODE = -1;
+    static const int32_t NO_RANK = INT32_MAX;
+
+    int32_t findChild(int32_t node, unsigned char label) const;
+    int32_t findNode(const std::string& prefix) const;
+    std::string wordOf(int32_t node) const;
+
+    std::vector<Node> nodes; // first node is root
+    int32_t nextRank;
+    size_t wordCount;
+};
@@ -117,6 +117,31 @@ bool TwitterApp::hasConnection() {
     return (twitter != null);
 }
 
+/**
+* getAsyncTwitter function
+* Non-blocking access to twitter, created for the account which is logged in
+* @param[out] AsyncTwitter executing requests in the background
+*/
+AsyncTwitter* TwitterApp::getAsyncTwitter() {
+    if (!asyncTwitter || asyncTwitter->getAccount() != twitter->mpAccount)
+    {
+        delete asyncTwitter;
+        asyncTwitter = new AsyncTwitter(twitter->mpAccount);
+    }
+    return asyncTwitter;
+}
+
+/**
+* updateRequests function
+* Delivers replies of requests to twitter, called by the main loop
+*/
+void TwitterApp::updateRequests() {
+    if (asyncTwitter)
+    {
+        asyncTwitter->update();
+    }
+}
+
 /**
 * Enable function
 * Enables the actity of an element in the interface
@@ -377,5 +402,6 @@ void TwitterApp::render() {
 * terminates current Gui
 */
 TwitterApp::~TwitterApp() {
+    delete asyncTwitter;
     eyegui::terminateGUI(pGUI);
 }
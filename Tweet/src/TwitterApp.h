@@ -13,6 +13,7 @@
 #include "src/Interface_Elements/ContentAreaPages/ConnectPageArea.h"
 #include "src/Interface_Elements/ContentAreaPages/DiscoverPageArea.h"
 #include "src/Keyboard/Keyboard.h"
+#include "src/TwitterClient/AsyncTwitter.h"
 #include "externals/eyeGUI-development/include/eyeGUI.h"
 
 // Just some constants to avoid typing errors, also you dont have to lookup the names always
@@ -38,6 +39,8 @@ public:
     void updateCurrentPage();
     ~TwitterApp();
     Twitter* getTwitter() { return twitter; }
+    AsyncTwitter* getAsyncTwitter();
+    void updateRequests();
     void render();
     eyegui::GUI* getGUI();
     void changeState(int state);
@@ -79,6 +82,7 @@ private:
     TwitterApp(int width, int height);
     TwitterApp();
     void resetInterface();
+    AsyncTwitter* asyncTwitter = 0; // bound to account of twitter
 
     // GUI-Settings
     int width;
@@ -0,0 +1,113 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#include "AsyncTwitter.h"
+#include <iostream>
+
+/**
+* Constructor of the AsyncTwitter
+* clones the account for every worker and starts them
+* @param[in] pAccount is an authorized account, which is only read here
+* @param[in] workerCount is the count of requests executed at the same time
+*/
+AsyncTwitter::AsyncTwitter(twitCurl* pAccount, int workerCount) {
+    mpAccount = pAccount;
+
+    // Clones are created on the main thread, since initialization of curl is not thread safe
+    for (int i = 0; i < workerCount; i++)
+        clones.push_back(std::unique_ptr<twitCurl>(pAccount->clone()));
+    for (int i = 0; i < workerCount; i++) {
+        Twitter twitter(clones[i].get());
+        workers.push_back(std::thread([this, twitter]() { work(twitter); }));
+    }
+}
+
+/**
+* Destructor of the AsyncTwitter
+* waits for running requests, queued requests and pending callbacks are dropped
+*/
+AsyncTwitter::~AsyncTwitter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    condition.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+/**
+* request function
+* queues call, callback receives the reply on the main thread
+* @param[in] call is executed on a worker with its own Twitter instance
+* @param[in] callback is called by update, may be empty
+*/
+void AsyncTwitter::request(Call call, Callback callback) {
+    Job job;
+    job.call = call;
+    job.callback = callback;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+    }
+    condition.notify_one();
+}
+
+/**
+* update function
+* delivers finished requests to their callbacks, must be called by the main loop
+*/
+void AsyncTwitter::update() {
+    std::vector<Result> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.swap(results);
+    }
+
+    // Callbacks may queue further requests
+    for (size_t i = 0; i < finished.size(); i++)
+        finished[i].callback(*finished[i].spReply);
+}
+
+/**
+* olderThan function
+* id to page back with max_id, which includes the given id itself
+* @param[in] id of the oldest tweet known
+* @param[out] string of the next smaller id, empty if there is none
+*/
+std::string AsyncTwitter::olderThan(const std::string& id) {
+    unsigned long long value = 0;
+    try {
+        value = std::stoull(id);
+    }
+    catch (...) {
+        return "";
+    }
+    if (value == 0)
+        return "";
+    return std::to_string(value - 1);
+}
+
+void AsyncTwitter::work(Twitter twitter) {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stop || !jobs.empty(); });
+            if (stop)
+                break;
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        rapidjson::Document reply = job.call(twitter);
+        if (job.callback) {
+            Result result;
+            result.callback = job.callback;
+            result.spReply = std::make_shared<rapidjson::Document>(std::move(reply));
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(result);
+        }
+    }
+}
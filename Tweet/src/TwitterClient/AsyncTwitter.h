@@ -0,0 +1,66 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+// Executes calls to Twitter on a few worker threads, so the interface never
+// waits for the network. Every worker owns a clone of the authorized account
+// with its own curl handle, which keeps the connection to the API alive
+// between requests. Replies are parsed on the worker. Callbacks are called on
+// the main thread when update is called.
+
+#pragma once
+
+#include "src/TwitterClient/TwitterClient.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+class AsyncTwitter {
+
+public:
+
+    typedef std::function<rapidjson::Document(Twitter&)> Call;
+    typedef std::function<void(rapidjson::Document&)> Callback;
+
+    AsyncTwitter(twitCurl* pAccount, int workerCount = WORKER_COUNT);
+    ~AsyncTwitter();
+
+    void request(Call call, Callback callback);
+    void update();
+    twitCurl* getAccount() const { return mpAccount; }
+
+    static std::string olderThan(const std::string& id);
+
+private:
+
+    // Call executed by worker
+    struct Job {
+        Call call;
+        Callback callback;
+    };
+
+    // Reply waiting for delivery on main thread
+    struct Result {
+        Callback callback;
+        std::shared_ptr<rapidjson::Document> spReply;
+    };
+
+    AsyncTwitter(const AsyncTwitter&);
+    void work(Twitter twitter);
+
+    static const int WORKER_COUNT = 3;
+
+    twitCurl* mpAccount;
+    std::vector<std::unique_ptr<twitCurl> > clones; // one per worker
+
+    std::deque<Job> jobs;
+    std::vector<Result> results;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stop = false;
+    std::vector<std::thread> workers;
+};
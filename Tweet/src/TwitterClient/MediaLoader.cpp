@@ -0,0 +1,398 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#include "MediaLoader.h"
+#include "externals/twitCurl/include/curl/curl.h"
+#include <experimental/filesystem>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <cstdio>
+#include <cctype>
+#include <cstdlib>
+#include <iterator>
+
+namespace fs = std::experimental::filesystem;
+
+namespace {
+    const std::string CACHE_FOLDER = "img/cache";
+
+    // FNV-1a hash of url as hexadecimal string
+    std::string hashOf(const std::string& url) {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < url.length(); i++) {
+            hash ^= (unsigned char)url[i];
+            hash *= 1099511628211ULL;
+        }
+        char buffer[17];
+        std::snprintf(buffer, sizeof(buffer), "%016llx", hash);
+        return buffer;
+    }
+
+    // Extension of file in url, without query
+    std::string extensionOf(const std::string& url) {
+        std::string path = url.substr(0, url.find_first_of("?#"));
+        size_t dot = path.rfind('.');
+        size_t slash = path.rfind('/');
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+            return "jpg";
+        std::string ext = path.substr(dot + 1);
+        if (ext.empty() || ext.length() > 4)
+            return "jpg";
+        for (size_t i = 0; i < ext.length(); i++) {
+            if (!std::isalnum((unsigned char)ext[i]))
+                return "jpg";
+            ext[i] = (char)std::tolower((unsigned char)ext[i]);
+        }
+        return ext;
+    }
+
+    std::string fullPath(const std::string& file) {
+        return CONTENT_PATH + std::string("/") + file;
+    }
+
+    size_t onData(char* buffer, size_t size, size_t count, void* pUser) {
+        ((std::string*)pUser)->append(buffer, size * count);
+        return size * count;
+    }
+
+    // Remembers ETag and Last-Modified of response. Headers of redirects are overwritten by later ones
+    struct Validators {
+        std::string etag;
+        std::string lastModified;
+    };
+
+    size_t onHeader(char* buffer, size_t size, size_t count, void* pUser) {
+        std::string line(buffer, size * count);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+            std::string name = line.substr(0, colon);
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            std::string value = line.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t\r\n") + 1);
+            Validators* pValidators = (Validators*)pUser;
+            if (name == "etag")
+                pValidators->etag = value;
+            else if (name == "last-modified")
+                pValidators->lastModified = value;
+        }
+        return size * count;
+    }
+
+    // Aborts transfer when loader is destroyed
+    int onProgress(void* pUser, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+        return ((std::atomic<bool>*)pUser)->load() ? 1 : 0;
+    }
+}
+
+//Singletons have to be set to 0, when they are not instanciated yet
+MediaLoader* MediaLoader::instance = 0;
+
+/**
+* getInstance function
+* creates the loader at first call
+* @param[out] MediaLoader is the instance of the loader
+*/
+MediaLoader* MediaLoader::getInstance() {
+    if (!instance)
+        instance = new MediaLoader();
+    return instance;
+}
+
+/**
+* destroyInstance function
+* stops downloads, pending callbacks are not called anymore
+*/
+void MediaLoader::destroyInstance() {
+    delete instance;
+    instance = 0;
+}
+
+/**
+* Constructor of the MediaLoader
+* prepares cache folder and starts workers
+*/
+MediaLoader::MediaLoader() : stop(false) {
+    curl_global_init(CURL_GLOBAL_ALL);
+    std::error_code error;
+    fs::create_directories(fullPath(CACHE_FOLDER), error);
+    pruneCache();
+    for (int i = 0; i < WORKER_COUNT; i++)
+        workers.push_back(std::thread([this]() { work(); }));
+}
+
+/**
+* Destructor of the MediaLoader
+* aborts running downloads and waits for workers
+*/
+MediaLoader::~MediaLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    condition.notify_all();
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+    curl_global_cleanup();
+}
+
+/**
+* request function
+* Returns file which can be shown right now, empty if not yet in cache.
+* Callback receives file when it has been downloaded or has changed since it was cached.
+* @param[in] url of the media
+* @param[in] callback is called on the main thread with the file relative to the content path
+*/
+std::string MediaLoader::request(std::string url, std::function<void(std::string)> callback) {
+    if (url.empty())
+        return "";
+
+    Entry& rEntry = entries[url];
+    if (!rEntry.validated && !rEntry.pending) {
+        const std::string key = hashOf(url);
+        if (rEntry.file.empty())
+            readMeta(key, rEntry);
+
+        // Download or revalidate cached file
+        Job job;
+        job.url = url;
+        job.key = key;
+        job.extension = extensionOf(url);
+        job.etag = rEntry.file.empty() ? "" : rEntry.etag;
+        job.lastModified = rEntry.file.empty() ? "" : rEntry.lastModified;
+        job.version = rEntry.version;
+        rEntry.pending = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(job);
+        }
+        condition.notify_one();
+    }
+    if (rEntry.pending && callback)
+        rEntry.callbacks.push_back(callback);
+    return rEntry.file;
+}
+
+/**
+* showPicture function
+* Replaces element with picture of url, showing placeholder until it is available.
+* Later calls for the same element replace earlier ones, also with empty url to just show the placeholder.
+* @param[in] pLayout is the layout of the element
+* @param[in] id is the id of the element
+* @param[in] url of the picture
+* @param[in] placeholder is shown while loading, relative to content path
+*/
+void MediaLoader::showPicture(eyegui::Layout* pLayout, std::string id, std::string url, std::string placeholder) {
+    const std::pair<eyegui::Layout*, std::string> element(pLayout, id);
+    shownUrls[element] = url;
+    std::string file = request(url, [this, element, url](std::string loaded) {
+        auto iter = shownUrls.find(element);
+        if (iter != shownUrls.end() && iter->second == url)
+            eyegui::replaceElementWithPicture(element.first, element.second, loaded, eyegui::ImageAlignment::ORIGINAL, false);
+    });
+    eyegui::replaceElementWithPicture(pLayout, id, file.empty() ? placeholder : file, eyegui::ImageAlignment::ORIGINAL, false);
+}
+
+/**
+* update function
+* delivers finished downloads to their callbacks, must be called by the main loop
+*/
+void MediaLoader::update() {
+    std::vector<Result> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.swap(results);
+    }
+    for (size_t i = 0; i < finished.size(); i++) {
+        const Result& result = finished[i];
+        Entry& rEntry = entries[result.url];
+        rEntry.pending = false;
+        std::vector<std::function<void(std::string)> > callbacks;
+        callbacks.swap(rEntry.callbacks);
+
+        // Failed requests are tried again at next request
+        if (!result.success)
+            continue;
+        rEntry.validated = true;
+        if (!result.changed)
+            continue;
+        rEntry.file = result.file;
+        rEntry.etag = result.etag;
+        rEntry.lastModified = result.lastModified;
+        rEntry.version = result.version;
+        for (size_t j = 0; j < callbacks.size(); j++)
+            callbacks[j](rEntry.file);
+    }
+}
+
+/**
+* avatarUrl function
+* Replaces substring '_normal.' with '_400x400.' to get profile image in the size of 400x400 pixels
+* @param[in] profileImageUrl is the url of the profile image as delivered by Twitter
+*/
+std::string MediaLoader::avatarUrl(std::string profileImageUrl) {
+    size_t index = profileImageUrl.find("_normal.");
+    if (index != std::string::npos)
+        profileImageUrl.replace(index, 8, "_400x400.");
+    return profileImageUrl;
+}
+
+void MediaLoader::work() {
+    CURL* pCurl = curl_easy_init();
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stop || !jobs.empty(); });
+            if (stop)
+                break;
+            job = jobs.front();
+            jobs.pop_front();
+        }
+        Result result = download(job, pCurl);
+        std::lock_guard<std::mutex> lock(mutex);
+        results.push_back(result);
+    }
+    curl_easy_cleanup(pCurl);
+}
+
+MediaLoader::Result MediaLoader::download(const Job& job, void* pHandle) {
+    Result result;
+    result.url = job.url;
+    result.success = false;
+    result.changed = false;
+    result.etag = job.etag;
+    result.lastModified = job.lastModified;
+    result.version = job.version;
+    CURL* pCurl = (CURL*)pHandle;
+    if (!pCurl)
+        return result;
+
+    // Handle is reused, so connections are kept alive between downloads
+    std::string body;
+    Validators validators;
+    struct curl_slist* pHeaders = NULL;
+    if (!job.etag.empty())
+        pHeaders = curl_slist_append(pHeaders, ("If-None-Match: " + job.etag).c_str());
+    if (!job.lastModified.empty())
+        pHeaders = curl_slist_append(pHeaders, ("If-Modified-Since: " + job.lastModified).c_str());
+    curl_easy_reset(pCurl);
+    curl_easy_setopt(pCurl, CURLOPT_URL, job.url.c_str());
+    curl_easy_setopt(pCurl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(pCurl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(pCurl, CURLOPT_CONNECTTIMEOUT, 10L);
+    curl_easy_setopt(pCurl, CURLOPT_TIMEOUT, 60L);
+    curl_easy_setopt(pCurl, CURLOPT_HTTPHEADER, pHeaders);
+    curl_easy_setopt(pCurl, CURLOPT_WRITEFUNCTION, onData);
+    curl_easy_setopt(pCurl, CURLOPT_WRITEDATA, &body);
+    curl_easy_setopt(pCurl, CURLOPT_HEADERFUNCTION, onHeader);
+    curl_easy_setopt(pCurl, CURLOPT_HEADERDATA, &validators);
+    curl_easy_setopt(pCurl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(pCurl, CURLOPT_XFERINFOFUNCTION, onProgress);
+    curl_easy_setopt(pCurl, CURLOPT_XFERINFODATA, &stop);
+    CURLcode code = curl_easy_perform(pCurl);
+    long status = 0;
+    curl_easy_getinfo(pCurl, CURLINFO_RESPONSE_CODE, &status);
+    curl_slist_free_all(pHeaders);
+    if (code != CURLE_OK) {
+        std::cout << "MediaLoader: Download of " << job.url << " failed: " << curl_easy_strerror(code) << std::endl;
+        return result;
+    }
+
+    // Cached file is still valid
+    if (status == 304) {
+        result.success = true;
+        return result;
+    }
+    if (status != 200 || body.empty()) {
+        std::cout << "MediaLoader: Download of " << job.url << " failed with status " << status << std::endl;
+        return result;
+    }
+
+    // Server might not support validators, so compare with cached file before writing a new version
+    if (job.version > 0) {
+        std::ifstream in(fullPath(CACHE_FOLDER + "/" + job.key + "_" + std::to_string(job.version) + "." + job.extension), std::ios::binary);
+        std::string cached((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        if (cached == body) {
+            result.etag = validators.etag;
+            result.lastModified = validators.lastModified;
+            result.file = CACHE_FOLDER + "/" + job.key + "_" + std::to_string(job.version) + "." + job.extension;
+            result.success = true;
+            writeMeta(job.key, result);
+            return result;
+        }
+    }
+
+    // Write new version of file, as eyeGUI keeps images by their path
+    result.version = job.version + 1;
+    result.file = CACHE_FOLDER + "/" + job.key + "_" + std::to_string(result.version) + "." + job.extension;
+    const std::string temporary = fullPath(result.file) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(body.data(), (std::streamsize)body.size());
+        if (!out.good())
+            return result;
+    }
+    std::remove(fullPath(result.file).c_str());
+    if (std::rename(temporary.c_str(), fullPath(result.file).c_str()) != 0)
+        return result;
+    if (job.version > 0)
+        std::remove(fullPath(CACHE_FOLDER + "/" + job.key + "_" + std::to_string(job.version) + "." + job.extension).c_str());
+    result.etag = validators.etag;
+    result.lastModified = validators.lastModified;
+    result.success = true;
+    result.changed = true;
+    writeMeta(job.key, result);
+    return result;
+}
+
+/**
+* readMeta function
+* reads file and validators of cached url. Returns false if nothing usable is cached
+*/
+bool MediaLoader::readMeta(const std::string& key, Entry& rEntry) const {
+    std::ifstream in(fullPath(CACHE_FOLDER + "/" + key + ".meta"));
+    std::string version, file, etag, lastModified;
+    if (!std::getline(in, version) || !std::getline(in, file))
+        return false;
+    std::getline(in, etag);
+    std::getline(in, lastModified);
+    std::error_code error;
+    if (!fs::exists(fullPath(file), error))
+        return false;
+    rEntry.version = std::atoi(version.c_str());
+    rEntry.file = file;
+    rEntry.etag = etag;
+    rEntry.lastModified = lastModified;
+    return true;
+}
+
+void MediaLoader::writeMeta(const std::string& key, const Result& result) const {
+    std::ofstream out(fullPath(CACHE_FOLDER + "/" + key + ".meta"), std::ios::trunc);
+    out << result.version << "\n" << result.file << "\n" << result.etag << "\n" << result.lastModified << "\n";
+}
+
+/**
+* pruneCache function
+* removes least recently written files if cache holds too many
+*/
+void MediaLoader::pruneCache() {
+    std::error_code error;
+    std::vector<std::pair<fs::file_time_type, fs::path> > metas;
+    for (fs::directory_iterator iter(fullPath(CACHE_FOLDER), error), end; !error && iter != end; iter.increment(error)) {
+        if (iter->path().extension() == ".meta")
+            metas.push_back(std::make_pair(fs::last_write_time(iter->path(), error), iter->path()));
+    }
+    if ((int)metas.size() <= MAX_CACHE_FILES)
+        return;
+    std::sort(metas.begin(), metas.end());
+    for (size_t i = 0; i < metas.size() - MAX_CACHE_FILES; i++) {
+        Entry entry;
+        if (readMeta(metas[i].second.stem().string(), entry))
+            fs::remove(fullPath(entry.file), error);
+        fs::remove(metas[i].second, error);
+    }
+}
@@ -0,0 +1,91 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+// Loads avatars and other media in the background. Files are kept in a cache
+// on disk, named after the hash of their URL, and revalidated once per
+// session via ETag and Last-Modified. Downloads run on a few worker threads,
+// results are delivered on the main thread when update is called.
+
+#pragma once
+
+#include "externals/eyeGUI-development/include/eyeGUI.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+class MediaLoader {
+
+public:
+
+    static MediaLoader* getInstance();
+    static void destroyInstance();
+
+    std::string request(std::string url, std::function<void(std::string)> callback);
+    void showPicture(eyegui::Layout* pLayout, std::string id, std::string url, std::string placeholder);
+    void update();
+
+    static std::string avatarUrl(std::string profileImageUrl);
+
+private:
+
+    // Download executed by worker
+    struct Job {
+        std::string url;
+        std::string key; // hash of url
+        std::string extension;
+        std::string etag;
+        std::string lastModified;
+        int version;
+    };
+
+    // Outcome of job
+    struct Result {
+        std::string url;
+        bool success;
+        bool changed;
+        std::string file; // relative to content path
+        std::string etag;
+        std::string lastModified;
+        int version;
+    };
+
+    // Cached file of url, only accessed on main thread
+    struct Entry {
+        std::string file;
+        std::string etag;
+        std::string lastModified;
+        int version = 0;
+        bool validated = false; // in this session
+        bool pending = false;
+        std::vector<std::function<void(std::string)> > callbacks;
+    };
+
+    MediaLoader();
+    ~MediaLoader();
+
+    void work();
+    Result download(const Job& job, void* pCurl);
+    bool readMeta(const std::string& key, Entry& rEntry) const;
+    void writeMeta(const std::string& key, const Result& result) const;
+    void pruneCache();
+
+    static const int WORKER_COUNT = 4;
+    static const int MAX_CACHE_FILES = 1000;
+    static MediaLoader* instance;
+
+    std::map<std::string, Entry> entries;
+    std::map<std::pair<eyegui::Layout*, std::string>, std::string> shownUrls; // url wanted by picture element
+
+    std::deque<Job> jobs;
+    std::vector<Result> results;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<bool> stop;
+    std::vector<std::thread> workers;
+};
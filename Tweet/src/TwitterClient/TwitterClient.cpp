@@ -35,6 +35,15 @@ Twitter::Twitter(twitCurl* pAccount, std::string name, std::string passwort, boo
     mpAccount->oAuthAccessToken();
 }
 
+/**
+* Constructor for the Twitter Class wrapping an account which is authorized already
+* Used by the worker threads of AsyncTwitter, which each own a clone of the account
+* @param[in] pAccount
+*/
+Twitter::Twitter(twitCurl* pAccount) {
+    mpAccount = pAccount;
+}
+
 //JSON ----------------------------------------------------------------------------------------------------------
 
 /**
@@ -163,10 +172,11 @@ rapidjson::Document Twitter::statusDestroy(std::string id) {
 *
 * @param[in] text - A search query of 500 characters maximum, including operators. Queries may additionally be limited by complexity.
 * @param[in] limits - The number of tweets to return per page
+* @param[in] maxId - Only tweets with an id less than or equal to it, used to load the next page
 * @param[out] rapidjson::Document
 **/
-rapidjson::Document Twitter::search(std::string text, std::string limits) {
-    mpAccount->search(text, limits);
+rapidjson::Document Twitter::search(std::string text, std::string limits, std::string maxId) {
+    mpAccount->search(text, limits, maxId);
     std::string replyMsg = "";
     mpAccount->getLastWebResponse(replyMsg);
     return toJSON(replyMsg);
@@ -197,11 +207,12 @@ rapidjson::Document Twitter::userSearch(std::string text, std::string limits) {
 * The home timeline is central to how most users interact with the Twitter service.
 *
 * @param[in] sinceId - String specifying since id parameter
+* @param[in] maxId - String specifying max id parameter, used to load the next page
 * @param[out] rapidjson::Document
 **/
-rapidjson::Document Twitter::getTimelineHome(std::string sinceId) {
+rapidjson::Document Twitter::getTimelineHome(std::string sinceId, std::string maxId) {
     std::string replyMsg = "";
-    if (mpAccount->timelineHomeGet(sinceId)) {
+    if (mpAccount->timelineHomeGet(sinceId, maxId)) {
         mpAccount->getLastWebResponse(replyMsg);
     }
     else {
@@ -2,6 +2,8 @@
 // Distributed under the Apache License, Version 2.0.
 //============================================================================
 
+#pragma once
+
 #include "externals/twitCurl/twitcurl.h"
 #include "externals/twitCurl/include/rapidjson/document.h"
 #include <cstdio>
@@ -14,6 +16,7 @@ public:
 
     twitCurl* mpAccount;
     Twitter(twitCurl* pAccount, std::string name, std::string passwort, bool swap);
+    Twitter(twitCurl* pAccount);
     rapidjson::Document toJSON(std::string); // This way?
 
     // STATUS
@@ -24,11 +27,11 @@ public:
     rapidjson::Document statusDestroy(std::string id);
 
     // SEARCH
-    rapidjson::Document search(std::string text, std::string limits);
+    rapidjson::Document search(std::string text, std::string limits, std::string maxId = "");
     rapidjson::Document userSearch(std::string text, std::string limits);
 
     // TIMELINE
-    rapidjson::Document getTimelineHome(std::string sinceId);
+    rapidjson::Document getTimelineHome(std::string sinceId, std::string maxId = "");
     rapidjson::Document getTimelineUser(bool trimUser, bool includeRetweets, unsigned int tweetCount, std::string userInfo, bool isUserId);
     rapidjson::Document getMentions(std::string sinceId);
 
@@ -7,7 +7,7 @@
 #include "externals/GLFW/include/GLFW/glfw3.h"
 #include "src/TwitterApp.h"
 #include "src/LoginArea/Login.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterClient/MediaLoader.h"
 #include "src/Input.h"
 #include "src/Framebuffer.h"
 #include <iostream>
@@ -224,6 +224,12 @@ int main(int argc, char* argv[]) {
 		input.gazeX = (int)((float)input.gazeX * (1280.f / (float)resX));
 		input.gazeY = (int)((float)input.gazeY * (800.f / (float)resY));
 
+        // Show images which have been loaded in the background
+        MediaLoader::getInstance()->update();
+
+        // Show replies of Twitter which have arrived in the background
+        TwitterApp::getInstance()->updateRequests();
+
         // Render GUI into framebuffer
 		framebuffer.Bind();
         eyegui::Input usedInput = eyegui::updateGUI(login->application->getGUI(), deltaTime, input);
@@ -244,8 +250,8 @@ int main(int argc, char* argv[]) {
 
     input_disconnect();
 
-    // Delete tmp image folder
-    remove_folder(CONTENT_PATH + std::string("/img/tmp"));
+    // Stop loading of images
+    MediaLoader::destroyInstance();
 
     //Destructor
     delete login;